@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Quaternions.hpp"
+#include "Animation.hpp"
+
+namespace
+{
+    // A crowd : 50k bone tracks, 2 seconds long with a key every 1/30 s or so
+    constexpr std::size_t trackCount = 50000;
+    constexpr std::size_t keyCount = 60;
+
+    // Each track has its own, slightly irregular, key times
+    template<std::floating_point F>
+    animation_clip<F> makeClip(std::vector<F>& times, std::vector<vec3<F>>& translations, std::vector<quat<F>>& rotations)
+    {
+        animation_clip<F> clip;
+
+        std::vector<F> trackTimes(keyCount);
+        std::vector<vec3<F>> trackTranslations(keyCount);
+        std::vector<quat<F>> trackRotations(keyCount, quat<F>::identity());
+        // The scale never changes : a single key
+        F scaleTimes[1] = { static_cast<F>(0.0) };
+        vec3<F> scales[1] = { vec3<F>::one() };
+
+        for (std::size_t track = 0; track < trackCount; track++)
+        {
+            for (std::size_t k = 0; k < keyCount; k++)
+            {
+                F f = static_cast<F>(k);
+
+                trackTimes[k] = f / static_cast<F>(30.0) + static_cast<F>((track + k) % 5) * static_cast<F>(0.001);
+                trackTranslations[k] = vec3<F>(f, static_cast<F>(track % 7), static_cast<F>(1.0));
+                trackRotations[k] = quat<F>(static_cast<F>(0.9), static_cast<F>(0.05) * f, static_cast<F>(track % 3), static_cast<F>(0.2)).normalized();
+            }
+
+            clip.addTrack(trackTimes, trackTranslations, trackTimes, trackRotations, scaleTimes, scales);
+
+            times.insert(times.end(), trackTimes.begin(), trackTimes.end());
+            translations.insert(translations.end(), trackTranslations.begin(), trackTranslations.end());
+            rotations.insert(rotations.end(), trackRotations.begin(), trackRotations.end());
+        }
+
+        return clip;
+    }
+
+    template<std::floating_point F>
+    void benchSampler(const char* T)
+    {
+        // The same keys, as an array of structures, for the loop written without the sampler
+        std::vector<F> times;
+        std::vector<vec3<F>> keyTranslations;
+        std::vector<quat<F>> keyRotations;
+
+        animation_clip<F> clip = makeClip<F>(times, keyTranslations, keyRotations);
+        animation_sampler<F> sampler;
+
+        std::vector<vec3<F>> translations(trackCount);
+        std::vector<quat<F>> outRotations(trackCount, quat<F>::identity());
+        std::vector<vec3<F>> scales(trackCount);
+
+        // Every call plays one frame at 60 fps, looping over the clip
+        F step = static_cast<F>(1.0) / static_cast<F>(60.0);
+        F time = static_cast<F>(0.0);
+
+        auto nextTime = [&]()
+        {
+            time += step;
+            if (time > clip.duration()) time = static_cast<F>(0.0);
+            return time;
+        };
+
+        // What had to be written without the sampler : a binary search, a lerp and a slerp per track
+        bench::run(T, " binary search + lerp + slerp loop (50k tracks)", trackCount, [&]()
+        {
+            F t = nextTime();
+
+            for (std::size_t track = 0; track < trackCount; track++)
+            {
+                const F* first = times.data() + track * keyCount;
+                std::size_t k = static_cast<std::size_t>(std::upper_bound(first, first + keyCount - 1, t) - first);
+                k = k == 0 ? 0 : k - 1;
+
+                std::size_t key = track * keyCount + k;
+                F f = (t - first[k]) / (first[k + 1] - first[k]);
+
+                translations[track] = vec3<F>::lerp(keyTranslations[key], keyTranslations[key + 1], f);
+                outRotations[track] = quat<F>::slerp(keyRotations[key], keyRotations[key + 1], f);
+                scales[track] = vec3<F>::one();
+            }
+            bench::doNotOptimize(outRotations[0]);
+        });
+
+        bench::run(T, "::sample (50k tracks)", trackCount, [&]()
+        {
+            sampler.sample(clip, nextTime(), translations, outRotations, scales);
+            bench::doNotOptimize(outRotations[0]);
+        });
+
+        bench::run(T, "::sample<fast> (50k tracks)", trackCount, [&]()
+        {
+            sampler.template sample<fast>(clip, nextTime(), translations, outRotations, scales);
+            bench::doNotOptimize(outRotations[0]);
+        });
+
+        bench::run(T, "::sampleSlerp (50k tracks)", trackCount, [&]()
+        {
+            sampler.sampleSlerp(clip, nextTime(), translations, outRotations, scales);
+            bench::doNotOptimize(outRotations[0]);
+        });
+
+        bench::run(T, "::sampleSlerp<fast> (50k tracks)", trackCount, [&]()
+        {
+            sampler.template sampleSlerp<fast>(clip, nextTime(), translations, outRotations, scales);
+            bench::doNotOptimize(outRotations[0]);
+        });
+
+        // The same clip with its keys reduced and quantized, decoded while sampling
+        compressed_clip compressed = compressed_clip::compress(clip);
+        animation_sampler<F> compressedSampler;
+
+        bench::run(T, "::sample compressed_clip (50k tracks)", trackCount, [&]()
+        {
+            compressedSampler.sample(compressed, nextTime(), translations, outRotations, scales);
+            bench::doNotOptimize(outRotations[0]);
+        });
+
+        bench::run(T, "::sampleSlerp compressed_clip (50k tracks)", trackCount, [&]()
+        {
+            compressedSampler.sampleSlerp(compressed, nextTime(), translations, outRotations, scales);
+            bench::doNotOptimize(outRotations[0]);
+        });
+    }
+}
+
+void runAnimationBenchmarks()
+{
+    benchSampler<float>("animation_samplerf");
+    benchSampler<double>("animation_samplerd");
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    // One measured operation, kept so that every result can be written as JSON at the end
+    struct result
+    {
+        std::string name;
+        double nsPerOp;
+        double opsPerSecond;
+    };
+
+    // The settings read from the command line by bench/main.cpp
+    struct settings
+    {
+        // The minimum time spent measuring each operation, in seconds
+        double minSeconds = 0.2;
+        // Only the operations whose name contains filter are run
+        std::string filter;
+        // Prints the table as it goes when true, the JSON being printed either way if asked
+        bool verbose = true;
+    };
+
+    inline settings& config()
+    {
+        static settings s;
+        return s;
+    }
+
+    inline std::vector<result>& results()
+    {
+        static std::vector<result> r;
+        return r;
+    }
+
+    // Keeps the compiler from optimizing away a value that is never read
+    template<typename T>
+    inline void doNotOptimize(const T& value)
+    {
+    #if defined(_MSC_VER)
+        const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+        (void)*sink;
+    #else
+        asm volatile("" : : "r,m"(value) : "memory");
+    #endif
+    }
+
+    // Returns true if the operation called name is selected by the filter
+    inline bool selected(const char* name)
+    {
+        return config().filter.empty() || std::string(name).find(config().filter) != std::string::npos;
+    }
+
+    // Runs fn() (which performs opsPerCall operations) until at least minSeconds have passed,
+    // and returns the average time of one operation in nanoseconds
+    template<typename Fn>
+    inline double measure(Fn&& fn, std::size_t opsPerCall, double minSeconds = config().minSeconds)
+    {
+        using clock = std::chrono::steady_clock;
+
+        // Warm-up, so that the caches and the branch predictors are in their steady state
+        fn();
+
+        std::size_t calls = 0;
+        auto start = clock::now();
+        std::chrono::duration<double> elapsed;
+
+        do
+        {
+            fn();
+            calls++;
+            elapsed = clock::now() - start;
+        }
+        while (elapsed.count() < minSeconds);
+
+        return (elapsed.count() * 1e9) / static_cast<double>(calls * opsPerCall);
+    }
+
+    inline void report(const char* name, double nsPerOp)
+    {
+        double opsPerSecond = nsPerOp > 0.0 ? 1e9 / nsPerOp : 0.0;
+
+        results().push_back({ name, nsPerOp, opsPerSecond });
+
+        if (config().verbose)
+        {
+            std::printf("%-48s %10.3f ns/op %12.2f Mops/s\n", name, nsPerOp, opsPerSecond * 1e-6);
+        }
+    }
+
+    // Measures and reports fn() under the name prefix + op, if that name is selected by the filter
+    template<typename Fn>
+    inline void run(const char* prefix, const char* op, std::size_t opsPerCall, Fn&& fn)
+    {
+        char name[96];
+        std::snprintf(name, sizeof(name), "%s%s", prefix, op);
+
+        if (!selected(name)) return;
+
+        report(name, measure(fn, opsPerCall));
+    }
+
+    // Writes every result as a JSON document, along with the SIMD level the library was built with
+    inline void writeJson(std::FILE* file, const char* simd)
+    {
+        std::fprintf(file, "{\n  \"simd\": \"%s\",\n  \"min_seconds\": %g,\n  \"results\": [\n", simd, config().minSeconds);
+
+        const std::vector<result>& r = results();
+
+        for (std::size_t i = 0; i < r.size(); i++)
+        {
+            std::fprintf(file, "    { \"name\": \"");
+
+            // The names are plain ASCII, only quotes and backslashes need escaping
+            for (char c : r[i].name)
+            {
+                if (c == '"' || c == '\\') std::fputc('\\', file);
+                std::fputc(c, file);
+            }
+
+            std::fprintf(file, "\", \"ns_per_op\": %.4f, \"ops_per_second\": %.1f }%s\n",
+                         r[i].nsPerOp, r[i].opsPerSecond, i + 1 < r.size() ? "," : "");
+        }
+
+        std::fprintf(file, "  ]\n}\n");
+    }
+}
@@ -0,0 +1,444 @@
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Matrices.hpp"
+#include "Geometry.hpp"
+
+namespace
+{
+    // One view of a large scene
+    constexpr std::size_t objectCount = 500000;
+
+    // An OpenGL perspective projection looking down -z, with a field of view of 90 degrees
+    template<std::floating_point F>
+    mat4<F> makeViewProjection()
+    {
+        F n = static_cast<F>(0.1);
+        F f = static_cast<F>(1000.0);
+
+        return mat4<F>(static_cast<F>(1.0), static_cast<F>(0.0), static_cast<F>(0.0), static_cast<F>(0.0),
+                       static_cast<F>(0.0), static_cast<F>(1.0), static_cast<F>(0.0), static_cast<F>(0.0),
+                       static_cast<F>(0.0), static_cast<F>(0.0), (f + n) / (n - f), static_cast<F>(2.0) * f * n / (n - f),
+                       static_cast<F>(0.0), static_cast<F>(0.0), static_cast<F>(-1.0), static_cast<F>(0.0));
+    }
+
+    template<std::floating_point F>
+    void benchCulling(const char* T)
+    {
+        frustum<F> view(makeViewProjection<F>());
+
+        // Objects spread in a cube around the camera, about a sixth of them being visible
+        std::vector<vec3<F>> centers(objectCount);
+        std::vector<vec3<F>> extents(objectCount);
+        std::vector<F> radii(objectCount);
+
+        std::uint32_t seed = 12345;
+        auto random = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<F>(seed >> 8) / static_cast<F>(1 << 24);
+        };
+
+        for (std::size_t i = 0; i < objectCount; i++)
+        {
+            centers[i] = vec3<F>(random() * 1000 - 500, random() * 1000 - 500, random() * 1000 - 500);
+            extents[i] = vec3<F>(random() * 4, random() * 4, random() * 4);
+            radii[i] = vec3<F>::template length<F>(extents[i]);
+        }
+
+        vec3_soa<F> soaCenters = vec3_soa<F>(std::span<const vec3<F>>(centers));
+        vec3_soa<F> soaExtents = vec3_soa<F>(std::span<const vec3<F>>(extents));
+        std::vector<std::uint32_t> visible(objectCount);
+
+        // What had to be written without the bulk tests : a dot product per plane and per object
+        bench::run(T, " sphere culling (vec3::dotProduct loop)", objectCount, [&]()
+        {
+            std::size_t count = 0;
+
+            for (std::size_t i = 0; i < objectCount; i++)
+            {
+                bool inside = true;
+
+                for (const vec4<F>& plane : view.planes)
+                {
+                    F distance = vec3<F>::template dotProduct<F>(vec3<F>(plane.x, plane.y, plane.z), centers[i]) + plane.w;
+                    inside = inside && distance >= -radii[i];
+                }
+
+                if (inside) visible[count++] = static_cast<std::uint32_t>(i);
+            }
+            bench::doNotOptimize(count);
+        });
+
+        bench::run(T, "::cullSpheres", objectCount, [&]()
+        {
+            std::size_t count = frustum<F>::cullSpheres(view, soaCenters, radii, visible);
+            bench::doNotOptimize(count);
+        });
+
+        bench::run(T, "::cullAabbs", objectCount, [&]()
+        {
+            std::size_t count = frustum<F>::cullAabbs(view, soaCenters, soaExtents, visible);
+            bench::doNotOptimize(count);
+        });
+    }
+
+    // The objects of a server : 200k small boxes spread over a 1km square, 100m high
+    constexpr std::size_t primitiveCount = 200000;
+    constexpr std::size_t queryCount = 1000;
+
+    template<std::floating_point F>
+    void benchBvh(const char* T)
+    {
+        std::uint32_t seed = 6789;
+        auto random = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<F>(seed >> 8) / static_cast<F>(1 << 24);
+        };
+
+        std::vector<aabb<F>> boxes(primitiveCount);
+
+        for (std::size_t i = 0; i < primitiveCount; i++)
+        {
+            vec3<F> center(random() * 1000, random() * 100, random() * 1000);
+            boxes[i] = aabb<F>::fromCenterExtents(center, vec3<F>(random() + static_cast<F>(0.1), random() + static_cast<F>(0.1), random() + static_cast<F>(0.1)));
+        }
+
+        std::vector<aabb<F>> queries(queryCount);
+        std::vector<vec3<F>> origins(queryCount);
+        std::vector<vec3<F>> directions(queryCount);
+
+        for (std::size_t q = 0; q < queryCount; q++)
+        {
+            queries[q] = aabb<F>::fromCenterExtents(vec3<F>(random() * 1000, random() * 100, random() * 1000), vec3<F>(5, 5, 5));
+            origins[q] = vec3<F>(random() * 1000, random() * 100, random() * 1000);
+            directions[q] = vec3<F>(random() - static_cast<F>(0.5), random() - static_cast<F>(0.5), random() - static_cast<F>(0.5));
+        }
+
+        bvh<F> tree;
+
+        bench::run(T, "::build (200k boxes)", 1, [&]()
+        {
+            tree.build(boxes);
+            bench::doNotOptimize(tree.nodes()[0]);
+        });
+
+        bench::run(T, "::refit (200k boxes)", 1, [&]()
+        {
+            tree.refit(boxes);
+            bench::doNotOptimize(tree.nodes()[0]);
+        });
+
+        // The brute force loops the queries replace, per query
+        bench::run(T, " overlap query (brute force)", queryCount, [&]()
+        {
+            std::size_t found = 0;
+
+            for (const aabb<F>& query : queries)
+            {
+                for (const aabb<F>& box : boxes) found += query.intersects(box) ? 1 : 0;
+            }
+            bench::doNotOptimize(found);
+        });
+
+        bench::run(T, "::queryOverlaps", queryCount, [&]()
+        {
+            std::size_t found = 0;
+
+            for (const aabb<F>& query : queries)
+            {
+                tree.queryOverlaps(query, [&](std::uint32_t) { found++; });
+            }
+            bench::doNotOptimize(found);
+        });
+
+        // The rays hit the boxes themselves
+        auto boxHit = [&](const vec3<F>& origin, const vec3<F>& inverseDirection, std::uint32_t primitive, F maxDistance)
+        {
+            F distance;
+            return math::detail::rayEntersBox(origin, inverseDirection, boxes[primitive].min, boxes[primitive].max, maxDistance, distance) ? distance : maxDistance;
+        };
+
+        bench::run(T, " raycast (brute force)", queryCount, [&]()
+        {
+            F total = static_cast<F>(0.0);
+
+            for (std::size_t q = 0; q < queryCount; q++)
+            {
+                vec3<F> inverse(1 / directions[q].x, 1 / directions[q].y, 1 / directions[q].z);
+                F closest = static_cast<F>(100.0);
+
+                for (std::size_t i = 0; i < primitiveCount; i++) closest = boxHit(origins[q], inverse, static_cast<std::uint32_t>(i), closest);
+                total += closest;
+            }
+            bench::doNotOptimize(total);
+        });
+
+        bench::run(T, "::raycast", queryCount, [&]()
+        {
+            F total = static_cast<F>(0.0);
+
+            for (std::size_t q = 0; q < queryCount; q++)
+            {
+                vec3<F> inverse(1 / directions[q].x, 1 / directions[q].y, 1 / directions[q].z);
+
+                total += tree.raycast(origins[q], directions[q], static_cast<F>(100.0), [&](std::uint32_t primitive, F maxDistance)
+                {
+                    return boxHit(origins[q], inverse, primitive, maxDistance);
+                });
+            }
+            bench::doNotOptimize(total);
+        });
+    }
+
+    // Hitscan rays against a small mesh and a few hitboxes
+    constexpr std::size_t rayCount = 16384;
+    constexpr std::size_t targetCount = 64;
+
+    template<std::floating_point F>
+    void benchRays(const char* T)
+    {
+        std::uint32_t seed = 4242;
+        auto random = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<F>(seed >> 8) / static_cast<F>(1 << 24);
+        };
+        auto randomVec = [&](F scale) { return vec3<F>((random() - static_cast<F>(0.5)) * scale, (random() - static_cast<F>(0.5)) * scale, (random() - static_cast<F>(0.5)) * scale); };
+
+        std::vector<vec3<F>> vertices(3 * targetCount);
+        std::vector<aabb<F>> boxes(targetCount);
+
+        for (std::size_t i = 0; i < targetCount; i++)
+        {
+            vec3<F> center = randomVec(20);
+
+            vertices[3 * i] = center + randomVec(4);
+            vertices[3 * i + 1] = center + randomVec(4);
+            vertices[3 * i + 2] = center + randomVec(4);
+            boxes[i] = aabb<F>::fromCenterExtents(center, vec3<F>(1, 2, 1));
+        }
+
+        ray_soa<F> rays;
+        std::vector<vec3<F>> origins(rayCount);
+        std::vector<vec3<F>> directions(rayCount);
+
+        for (std::size_t i = 0; i < rayCount; i++)
+        {
+            origins[i] = randomVec(40);
+            directions[i] = randomVec(2);
+            rays.pushBack(origins[i], directions[i], static_cast<F>(100.0));
+        }
+
+        std::vector<F> distances(rayCount);
+        std::vector<std::uint32_t> hits(rayCount);
+
+        // What had to be written without the packet kernels : Möller-Trumbore one ray and one triangle at a time
+        bench::run(T, " ray-triangle (vec3 loop)", rayCount * targetCount, [&]()
+        {
+            for (std::size_t i = 0; i < rayCount; i++)
+            {
+                F closest = static_cast<F>(100.0);
+                std::uint32_t hit = ray_soa<F>::noHit;
+
+                for (std::size_t t = 0; t < targetCount; t++)
+                {
+                    vec3<F> e1 = vertices[3 * t + 1] - vertices[3 * t];
+                    vec3<F> e2 = vertices[3 * t + 2] - vertices[3 * t];
+                    vec3<F> p = vec3<F>::crossProduct(directions[i], e2);
+                    F inverseDeterminant = 1 / vec3<F>::template dotProduct<F>(e1, p);
+                    vec3<F> s = origins[i] - vertices[3 * t];
+                    vec3<F> q = vec3<F>::crossProduct(s, e1);
+
+                    F u = vec3<F>::template dotProduct<F>(s, p) * inverseDeterminant;
+                    F v = vec3<F>::template dotProduct<F>(directions[i], q) * inverseDeterminant;
+                    F distance = vec3<F>::template dotProduct<F>(e2, q) * inverseDeterminant;
+
+                    if (u >= 0 && v >= 0 && u + v <= 1 && distance >= 0 && distance < closest)
+                    {
+                        closest = distance;
+                        hit = static_cast<std::uint32_t>(t);
+                    }
+                }
+
+                distances[i] = closest;
+                hits[i] = hit;
+            }
+            bench::doNotOptimize(hits[0]);
+        });
+
+        bench::run(T, "::intersectTriangles", rayCount * targetCount, [&]()
+        {
+            ray_soa<F>::intersectTriangles(rays, vertices, distances, hits);
+            bench::doNotOptimize(hits[0]);
+        });
+
+        bench::run(T, "::unoccluded", rayCount * targetCount, [&]()
+        {
+            std::size_t count = ray_soa<F>::unoccluded(rays, vertices, hits);
+            bench::doNotOptimize(count);
+        });
+
+        bench::run(T, "::intersectAabbs", rayCount * targetCount, [&]()
+        {
+            ray_soa<F>::intersectAabbs(rays, boxes, distances, hits);
+            bench::doNotOptimize(hits[0]);
+        });
+    }
+
+    // The entities of a crowded server : 20k of them on a 400m square, looking for the others within 5m
+    constexpr std::size_t entityCount = 20000;
+    constexpr std::size_t neighbourQueryCount = 1000;
+
+    template<std::floating_point F>
+    void benchSpatialHash(const char* T)
+    {
+        std::uint32_t seed = 777;
+        auto random = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<F>(seed >> 8) / static_cast<F>(1 << 24);
+        };
+
+        std::vector<vec3<F>> positions(entityCount);
+
+        for (vec3<F>& position : positions) position = vec3<F>(random() * 400, random() * 10, random() * 400);
+
+        F radius = static_cast<F>(5.0);
+        spatial_hash<F> grid;
+
+        bench::run(T, "::build (20k points)", 1, [&]()
+        {
+            grid.build(positions, radius);
+            bench::doNotOptimize(grid.size());
+        });
+
+        // The loop it replaces, per entity
+        bench::run(T, " neighbours (vec3::distance loop)", neighbourQueryCount, [&]()
+        {
+            std::size_t found = 0;
+
+            for (std::size_t q = 0; q < neighbourQueryCount; q++)
+            {
+                for (const vec3<F>& position : positions) found += vec3<F>::template distance<F>(positions[q], position) <= radius ? 1 : 0;
+            }
+            bench::doNotOptimize(found);
+        });
+
+        bench::run(T, "::queryRadius", neighbourQueryCount, [&]()
+        {
+            std::size_t found = 0;
+
+            for (std::size_t q = 0; q < neighbourQueryCount; q++)
+            {
+                grid.queryRadius(positions[q], radius, [&](std::uint32_t) { found++; });
+            }
+            bench::doNotOptimize(found);
+        });
+    }
+
+    // A large particle system, reordered along a Z-order curve
+    constexpr std::size_t particleCount = 1000000;
+
+    template<std::floating_point F>
+    void benchMorton(const char* T)
+    {
+        std::uint32_t seed = 1357;
+        auto random = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<F>(seed >> 8) / static_cast<F>(1 << 24);
+        };
+
+        vec3_soa<F> particles(particleCount);
+
+        for (std::size_t i = 0; i < particleCount; i++) particles.set(i, vec3<F>(random() * 100, random() * 100, random() * 100));
+
+        aabb<F> bounds(vec3<F>(0, 0, 0), vec3<F>(100, 100, 100));
+        std::vector<std::uint32_t> codes(particleCount);
+        std::vector<std::uint64_t> wideCodes(particleCount);
+
+        // What had to be written without the bulk functions : a quantization and a bit loop per point
+        bench::run(T, " Morton codes (bit loop)", particleCount, [&]()
+        {
+            for (std::size_t i = 0; i < particleCount; i++)
+            {
+                std::uint32_t x = static_cast<std::uint32_t>(particles.x[i] * static_cast<F>(10.24));
+                std::uint32_t y = static_cast<std::uint32_t>(particles.y[i] * static_cast<F>(10.24));
+                std::uint32_t z = static_cast<std::uint32_t>(particles.z[i] * static_cast<F>(10.24));
+                std::uint32_t code = 0;
+
+                for (std::uint32_t bit = 0; bit < 10; bit++)
+                {
+                    code |= (((x >> bit) & 1u) << (3 * bit)) | (((y >> bit) & 1u) << (3 * bit + 1)) | (((z >> bit) & 1u) << (3 * bit + 2));
+                }
+
+                codes[i] = code;
+            }
+            bench::doNotOptimize(codes[0]);
+        });
+
+        bench::run(T, " mortonCodes (30 bits)", particleCount, [&]()
+        {
+            mortonCodes(particles, bounds, std::span<std::uint32_t>(codes));
+            bench::doNotOptimize(codes[0]);
+        });
+
+        bench::run(T, " mortonCodes (63 bits)", particleCount, [&]()
+        {
+            mortonCodes(particles, bounds, std::span<std::uint64_t>(wideCodes));
+            bench::doNotOptimize(wideCodes[0]);
+        });
+
+        mortonCodes(particles, bounds, std::span<std::uint32_t>(codes));
+
+        // Sorting the codes with the index of their particle, then gathering the particles
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs(particleCount);
+        vec3_soa<F> sorted(particleCount);
+
+        bench::run(T, " sort by code (std::sort)", particleCount, [&]()
+        {
+            for (std::size_t i = 0; i < particleCount; i++) pairs[i] = { codes[i], static_cast<std::uint32_t>(i) };
+
+            std::sort(pairs.begin(), pairs.end());
+
+            for (std::size_t i = 0; i < particleCount; i++) sorted.set(i, particles.get(pairs[i].second));
+            bench::doNotOptimize(sorted.x[0]);
+        });
+
+        std::vector<std::uint32_t> keys(particleCount);
+
+        bench::run(T, " radixSort (codes + vec3_soa)", particleCount, [&]()
+        {
+            std::copy(codes.begin(), codes.end(), keys.begin());
+            sorted = particles;
+
+            radixSort(std::span<std::uint32_t>(keys), sorted);
+            bench::doNotOptimize(sorted.x[0]);
+        });
+    }
+}
+
+void runGeometryBenchmarks()
+{
+    benchCulling<float>("frustumf");
+    benchCulling<double>("frustumd");
+
+    benchBvh<float>("bvhf");
+    benchBvh<double>("bvhd");
+
+    benchRays<float>("ray_soaf");
+    benchRays<double>("ray_soad");
+
+    benchSpatialHash<float>("spatial_hashf");
+    benchSpatialHash<double>("spatial_hashd");
+
+    benchMorton<float>("mortonf");
+    benchMorton<double>("mortond");
+}
@@ -0,0 +1,100 @@
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Matrices.hpp"
+
+namespace
+{
+    constexpr std::size_t count = 256;
+
+    template<std::floating_point F>
+    std::vector<mat2<F>> makeMatrices(F seed)
+    {
+        std::vector<mat2<F>> mats(count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                mats[i].columns[j / 2][j % 2] = seed + static_cast<F>((i * 4 + j) % 7) * static_cast<F>(0.25);
+            }
+
+            // A strong diagonal keeps every matrix invertible
+            for (int j = 0; j < 2; j++) mats[i].columns[j][j] += static_cast<F>(4.0);
+        }
+
+        return mats;
+    }
+
+    template<std::floating_point F>
+    void benchMat2(const char* T)
+    {
+        std::vector<mat2<F>> a = makeMatrices<F>(static_cast<F>(0.5));
+        std::vector<mat2<F>> b = makeMatrices<F>(static_cast<F>(1.5));
+        std::vector<mat2<F>> out(count);
+        std::vector<vec2<F>> vecs(count, vec2<F>(static_cast<F>(1.0), static_cast<F>(2.0)));
+        std::vector<vec2<F>> vecsOut(count);
+        std::vector<F> scalars(count);
+
+        F s = static_cast<F>(1.25);
+
+        bench::run(T, " * mat2", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] * b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " * vec2", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) vecsOut[i] = a[i] * vecs[i];
+            bench::doNotOptimize(vecsOut[0]);
+        });
+        bench::run(T, " + ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] + b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " - ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] - b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " * scalar", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] * s;
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " / scalar", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] / s;
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::determinant", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template determinant<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::getInvertedMat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].getInvertedMat();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::getTransposedMat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].getTransposedMat();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::rotateZ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = mat2<F>::rotateZ(scalars[i]);
+            bench::doNotOptimize(out[0]);
+        });
+    }
+}
+
+void runMat2Benchmarks()
+{
+    benchMat2<float>("mat2f");
+    benchMat2<double>("mat2d");
+}
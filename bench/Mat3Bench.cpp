@@ -0,0 +1,258 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Matrices.hpp"
+
+namespace
+{
+    constexpr std::size_t count = 256;
+
+    template<std::floating_point F>
+    std::vector<mat3<F>> makeMatrices(F seed)
+    {
+        std::vector<mat3<F>> mats(count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            for (int j = 0; j < 9; j++)
+            {
+                mats[i].columns[j / 3][j % 3] = seed + static_cast<F>((i * 9 + j) % 7) * static_cast<F>(0.25);
+            }
+
+            // A strong diagonal keeps every matrix invertible
+            for (int j = 0; j < 3; j++) mats[i].columns[j][j] += static_cast<F>(4.0);
+        }
+
+        return mats;
+    }
+
+    template<std::floating_point F>
+    void benchMat3(const char* T)
+    {
+        std::vector<mat3<F>> a = makeMatrices<F>(static_cast<F>(0.5));
+        std::vector<mat3<F>> b = makeMatrices<F>(static_cast<F>(1.5));
+        std::vector<mat3<F>> out(count);
+        std::vector<vec3<F>> vecs(count, vec3<F>(static_cast<F>(1.0), static_cast<F>(2.0), static_cast<F>(3.0)));
+        std::vector<vec3<F>> vecsOut(count);
+        std::vector<F> scalars(count);
+
+        F s = static_cast<F>(1.25);
+
+        bench::run(T, " * mat3", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] * b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " * vec3", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) vecsOut[i] = a[i] * vecs[i];
+            bench::doNotOptimize(vecsOut[0]);
+        });
+        bench::run(T, " + ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] + b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " - ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] - b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " * scalar", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] * s;
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " / scalar", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] / s;
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::determinant", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template determinant<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::getInvertedMat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].getInvertedMat();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::getTransposedMat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].getTransposedMat();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::getComatrix", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].getComatrix();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::rotateX", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = mat3<F>::rotateX(scalars[i]);
+            bench::doNotOptimize(out[0]);
+        });
+    }
+
+    // The inertia tensors and constraint blocks of a physics step
+    constexpr std::size_t batchCount = 16384;
+
+    template<std::floating_point F>
+    void benchMat3Batch(const char* T)
+    {
+        std::vector<mat3<F>> mats(batchCount);
+        std::vector<mat3<F>> out(batchCount);
+        std::vector<vec3<F>> rhs(batchCount);
+        std::vector<vec3<F>> solutions(batchCount);
+
+        for (std::size_t i = 0; i < batchCount; i++)
+        {
+            for (int j = 0; j < 9; j++) mats[i].columns[j / 3][j % 3] = static_cast<F>((i * 9 + j) % 7) * static_cast<F>(0.25);
+            for (int j = 0; j < 3; j++) mats[i].columns[j][j] += static_cast<F>(4.0);
+
+            rhs[i] = vec3<F>(static_cast<F>(1.0), static_cast<F>(i % 5), static_cast<F>(-2.0));
+        }
+
+        mat3_aosoa<F> batch = mat3_aosoa<F>(std::span<const mat3<F>>(mats));
+        mat3_aosoa<F> inverses;
+        vec3_soa<F> soaRhs = vec3_soa<F>(std::span<const vec3<F>>(rhs));
+        vec3_soa<F> soaSolutions;
+        std::vector<F> determinants(batchCount);
+        std::vector<std::uint32_t> singular(batch.blockCount());
+
+        bench::run(T, " determinant (mat3 loop)", batchCount, [&]()
+        {
+            for (std::size_t i = 0; i < batchCount; i++) determinants[i] = mats[i].template determinant<F>();
+            bench::doNotOptimize(determinants.data());
+        });
+        bench::run(T, "::determinant", batchCount, [&]()
+        {
+            mat3_aosoa<F>::determinant(batch, determinants);
+            bench::doNotOptimize(determinants.data());
+        });
+        bench::run(T, " inverse (mat3::getInvertedMat loop)", batchCount, [&]()
+        {
+            for (std::size_t i = 0; i < batchCount; i++) out[i] = mats[i].getInvertedMat();
+            bench::doNotOptimize(out.data());
+        });
+        bench::run(T, "::inverse", batchCount, [&]()
+        {
+            mat3_aosoa<F>::inverse(batch, inverses, singular);
+            bench::doNotOptimize(singular.data());
+        });
+        bench::run(T, " solve (getInvertedMat * vec3 loop)", batchCount, [&]()
+        {
+            for (std::size_t i = 0; i < batchCount; i++) solutions[i] = mats[i].getInvertedMat() * rhs[i];
+            bench::doNotOptimize(solutions.data());
+        });
+        bench::run(T, "::solve", batchCount, [&]()
+        {
+            mat3_aosoa<F>::solve(batch, soaRhs, soaSolutions, singular);
+            bench::doNotOptimize(singular.data());
+        });
+    }
+
+    // The deformation gradients of a shape matching or corotational FEM step
+    constexpr std::size_t elementCount = 16384;
+
+    // The closest rotation by Newton's iteration R = (R + R^-T) / 2, with the operators of mat3
+    template<std::floating_point F>
+    mat3<F> newtonPolarRotation(const mat3<F>& mat)
+    {
+        mat3<F> rotation = mat;
+
+        for (int iteration = 0; iteration < 20; iteration++)
+        {
+            mat3<F> next = (rotation + rotation.getInvertedMat().getTransposedMat()) * static_cast<F>(0.5);
+            mat3<F> step = next - rotation;
+
+            rotation = next;
+
+            F change = static_cast<F>(0.0);
+            for (int j = 0; j < 9; j++) change += step.columns[j / 3][j % 3] * step.columns[j / 3][j % 3];
+            if (change < static_cast<F>(1e-10)) break;
+        }
+
+        return rotation;
+    }
+
+    template<std::floating_point F>
+    void benchDecomposition(const char* T)
+    {
+        std::vector<mat3<F>> mats(elementCount);
+        std::vector<mat3<F>> rotations(elementCount);
+        std::vector<mat3<F>> stretches(elementCount);
+
+        std::uint32_t seed = 12345;
+        auto random = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<F>(seed >> 8) / static_cast<F>(1 << 24) - static_cast<F>(0.5);
+        };
+
+        // Rotations with a small deformation, as the elements of a soft body
+        for (std::size_t i = 0; i < elementCount; i++)
+        {
+            mat3<F> rotation = mat3<F>::rotateX(random() * 360) * mat3<F>::rotateY(random() * 360);
+
+            for (int j = 0; j < 9; j++) mats[i].columns[j / 3][j % 3] = rotation.columns[j / 3][j % 3] + random() * static_cast<F>(0.2);
+        }
+
+        mat3_aosoa<F> batch = mat3_aosoa<F>(std::span<const mat3<F>>(mats));
+        mat3_aosoa<F> batchU, batchV, batchRotations, batchStretches;
+        vec3_soa<F> batchSigma;
+
+        bench::run(T, " polar rotation (Newton iteration)", elementCount, [&]()
+        {
+            for (std::size_t i = 0; i < elementCount; i++) rotations[i] = newtonPolarRotation(mats[i]);
+            bench::doNotOptimize(rotations.data());
+        });
+        bench::run(T, " svd", elementCount, [&]()
+        {
+            mat3<F> u, v;
+            vec3<F> sigma;
+
+            for (std::size_t i = 0; i < elementCount; i++)
+            {
+                svd(mats[i], u, sigma, v);
+                bench::doNotOptimize(sigma);
+            }
+        });
+        bench::run(T, " polarDecomposition", elementCount, [&]()
+        {
+            for (std::size_t i = 0; i < elementCount; i++) polarDecomposition(mats[i], rotations[i], stretches[i]);
+            bench::doNotOptimize(rotations.data());
+        });
+        bench::run(T, "_aosoa svd", elementCount, [&]()
+        {
+            svd(batch, batchU, batchSigma, batchV);
+            bench::doNotOptimize(batchSigma.x.data());
+        });
+        bench::run(T, "_aosoa polarDecomposition", elementCount, [&]()
+        {
+            polarDecomposition(batch, batchRotations, batchStretches);
+            bench::doNotOptimize(batchRotations.blockValues(0));
+        });
+        bench::run(T, "_aosoa polarDecomposition<fast>", elementCount, [&]()
+        {
+            polarDecomposition<fast>(batch, batchRotations, batchStretches);
+            bench::doNotOptimize(batchRotations.blockValues(0));
+        });
+    }
+}
+
+void runMat3Benchmarks()
+{
+    benchMat3<float>("mat3f");
+    benchMat3<double>("mat3d");
+
+    benchMat3Batch<float>("mat3f_aosoa");
+    benchMat3Batch<double>("mat3d_aosoa");
+
+    benchDecomposition<float>("mat3f");
+    benchDecomposition<double>("mat3d");
+}
@@ -0,0 +1,305 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Matrices.hpp"
+
+namespace
+{
+    constexpr std::size_t count = 256;
+
+    // The size of a vertex buffer, for the bulk transforms
+    constexpr std::size_t vertexCount = 1 << 20;
+
+    // The size of a skinned mesh, its bone palette holding count matrices
+    constexpr std::size_t skinnedVertexCount = 100000;
+
+    template<std::floating_point F>
+    std::vector<mat4<F>> makeMatrices(F seed)
+    {
+        std::vector<mat4<F>> mats(count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            for (int j = 0; j < 16; j++)
+            {
+                mats[i].columns[j / 4][j % 4] = seed + static_cast<F>((i * 16 + j) % 7) * static_cast<F>(0.25);
+            }
+        }
+
+        return mats;
+    }
+
+    template<std::floating_point F>
+    void benchMultiply(const char* T)
+    {
+        std::vector<mat4<F>> a = makeMatrices<F>(static_cast<F>(0.5));
+        std::vector<mat4<F>> b = makeMatrices<F>(static_cast<F>(1.5));
+        std::vector<mat4<F>> out(count);
+
+        bench::run(T, " * mat4 (scalar)", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = math::detail::multiplyScalar(a[i], b[i]);
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, " * mat4", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] * b[i];
+            bench::doNotOptimize(out[0]);
+        });
+    }
+
+    template<std::floating_point F>
+    void benchTransform(const char* T)
+    {
+        std::vector<mat4<F>> mats = makeMatrices<F>(static_cast<F>(0.5));
+        std::vector<vec3<F>> points(count, vec3<F>(static_cast<F>(1.0), static_cast<F>(2.0), static_cast<F>(3.0)));
+        std::vector<vec3<F>> out(count);
+        std::vector<vec4<F>> vecs(count, vec4<F>(static_cast<F>(1.0), static_cast<F>(2.0), static_cast<F>(3.0), static_cast<F>(1.0)));
+        std::vector<vec4<F>> vecsOut(count);
+
+        bench::run(T, "::transformPoint (scalar)", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = math::detail::transformScalar(mats[i], points[i], static_cast<F>(1.0));
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::transformPoint", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = mats[i].transformPoint(points[i]);
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::transformDirection", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = mats[i].transformDirection(points[i]);
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, " * vec4 (scalar)", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) vecsOut[i] = math::detail::transformScalar(mats[i], vecs[i]);
+            bench::doNotOptimize(vecsOut[0]);
+        });
+
+        bench::run(T, " * vec4", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) vecsOut[i] = mats[i] * vecs[i];
+            bench::doNotOptimize(vecsOut[0]);
+        });
+    }
+
+    template<std::floating_point F>
+    void benchBulkTransform(const char* T)
+    {
+        mat4<F> mat = makeMatrices<F>(static_cast<F>(0.5))[0];
+
+        std::vector<vec3<F>> points(vertexCount);
+        std::vector<vec4<F>> vecs(vertexCount);
+
+        for (std::size_t i = 0; i < vertexCount; i++)
+        {
+            points[i] = vec3<F>(static_cast<F>(i % 101), static_cast<F>(1.0), static_cast<F>(-2.0));
+            vecs[i] = vec4<F>(points[i], static_cast<F>(1.0));
+        }
+
+        std::vector<vec3<F>> out(vertexCount);
+        std::vector<vec4<F>> vecsOut(vertexCount);
+        vec3_soa<F> soaPoints = vec3_soa<F>(std::span<const vec3<F>>(points));
+        vec3_soa<F> soaOut;
+
+        // The loops the bulk kernels replace
+        bench::run(T, "::transformPoint (loop)", vertexCount, [&]()
+        {
+            for (std::size_t i = 0; i < vertexCount; i++) out[i] = mat.transformPoint(points[i]);
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, " * vec4 (loop)", vertexCount, [&]()
+        {
+            for (std::size_t i = 0; i < vertexCount; i++) vecsOut[i] = mat * vecs[i];
+            bench::doNotOptimize(vecsOut[0]);
+        });
+
+        bench::run(T, "::transform (vec4)", vertexCount, [&]()
+        {
+            mat4<F>::transform(mat, std::span<const vec4<F>>(vecs), std::span<vec4<F>>(vecsOut));
+            bench::doNotOptimize(vecsOut[0]);
+        });
+
+        bench::run(T, "::transformPoints (AoS)", vertexCount, [&]()
+        {
+            mat4<F>::transformPoints(mat, std::span<const vec3<F>>(points), std::span<vec3<F>>(out));
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::transformDirections (AoS)", vertexCount, [&]()
+        {
+            mat4<F>::transformDirections(mat, std::span<const vec3<F>>(points), std::span<vec3<F>>(out));
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::transformPoints (SoA)", vertexCount, [&]()
+        {
+            mat4<F>::transformPoints(mat, soaPoints, soaOut);
+            bench::doNotOptimize(soaOut.x[0]);
+        });
+
+        bench::run(T, "::transformDirections (SoA)", vertexCount, [&]()
+        {
+            mat4<F>::transformDirections(mat, soaPoints, soaOut);
+            bench::doNotOptimize(soaOut.x[0]);
+        });
+    }
+
+    template<std::floating_point F, std::size_t N>
+    void benchSkinning(const char* T, const char* loopName, const char* skinName, const char* normalsName)
+    {
+        std::vector<mat4<F>> bones = makeMatrices<F>(static_cast<F>(0.5));
+
+        std::vector<vec3<F>> positions(skinnedVertexCount);
+        std::vector<vec3<F>> normals(skinnedVertexCount, vec3<F>::up());
+        std::vector<std::uint16_t> indices(skinnedVertexCount * N);
+        std::vector<F> weights(skinnedVertexCount * N, static_cast<F>(1.0) / static_cast<F>(N));
+
+        // Neighbouring vertices share most of their bones, like in a real mesh
+        for (std::size_t v = 0; v < skinnedVertexCount; v++)
+        {
+            positions[v] = vec3<F>(static_cast<F>(v % 100), static_cast<F>(v / 100), static_cast<F>(1.0));
+
+            for (std::size_t k = 0; k < N; k++)
+            {
+                indices[v * N + k] = static_cast<std::uint16_t>((v / 64 + k * 7) % count);
+            }
+        }
+
+        std::vector<vec3<F>> outPositions(skinnedVertexCount);
+        std::vector<vec3<F>> outNormals(skinnedVertexCount);
+
+        // What had to be written without mat4::skin
+        bench::run(T, loopName, skinnedVertexCount, [&]()
+        {
+            for (std::size_t v = 0; v < skinnedVertexCount; v++)
+            {
+                vec4<F> point = vec4<F>(positions[v], static_cast<F>(1.0));
+                vec4<F> res = vec4<F>::zero();
+
+                for (std::size_t k = 0; k < N; k++)
+                {
+                    res += (bones[indices[v * N + k]] * point) * weights[v * N + k];
+                }
+
+                outPositions[v] = res.XYZ();
+            }
+            bench::doNotOptimize(outPositions[0]);
+        });
+
+        bench::run(T, skinName, skinnedVertexCount, [&]()
+        {
+            mat4<F>::template skin<N>(std::span<const mat4<F>>(bones),
+                std::span<const std::uint16_t>(indices), std::span<const F>(weights),
+                std::span<const vec3<F>>(positions), std::span<vec3<F>>(outPositions));
+            bench::doNotOptimize(outPositions[0]);
+        });
+
+        bench::run(T, normalsName, skinnedVertexCount, [&]()
+        {
+            mat4<F>::template skin<N>(std::span<const mat4<F>>(bones),
+                std::span<const std::uint16_t>(indices), std::span<const F>(weights),
+                std::span<const vec3<F>>(positions), std::span<const vec3<F>>(normals),
+                std::span<vec3<F>>(outPositions), std::span<vec3<F>>(outNormals));
+            bench::doNotOptimize(outPositions[0]);
+        });
+    }
+
+    template<std::floating_point F>
+    void benchInverse(const char* T)
+    {
+        std::vector<mat4<F>> mats = makeMatrices<F>(static_cast<F>(0.5));
+        std::vector<mat4<F>> out(count);
+
+        // A strong diagonal keeps every matrix invertible, and the last row makes them affine
+        for (mat4<F>& mat : mats)
+        {
+            for (int i = 0; i < 4; i++) mat.columns[i][i] += static_cast<F>(4.0);
+            mat.columns[0][3] = mat.columns[1][3] = mat.columns[2][3] = static_cast<F>(0.0);
+            mat.columns[3][3] = static_cast<F>(1.0);
+        }
+
+        bench::run(T, "::getInvertedMat (scalar)", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                // Goes through a local like getInvertedMat() does, so that both measure the same copies
+                mat4<F> inverse;
+                if (!math::detail::invertScalar(mats[i], inverse)) inverse = mats[i];
+                out[i] = inverse;
+            }
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::getInvertedMat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = mats[i].getInvertedMat();
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::getAffineInvertedMat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = mats[i].getAffineInvertedMat();
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::getRigidInvertedMat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = mats[i].getRigidInvertedMat();
+            bench::doNotOptimize(out[0]);
+        });
+    }
+
+    template<std::floating_point F>
+    void benchMisc(const char* T)
+    {
+        std::vector<mat4<F>> mats = makeMatrices<F>(static_cast<F>(0.5));
+        std::vector<mat4<F>> out(count);
+        std::vector<F> scalars(count);
+
+        bench::run(T, "::determinant", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = mats[i].template determinant<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+
+        bench::run(T, "::getTransposedMat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = mats[i].getTransposedMat();
+            bench::doNotOptimize(out[0]);
+        });
+    }
+}
+
+void runMat4Benchmarks()
+{
+    benchMultiply<float>("mat4f");
+    benchMultiply<double>("mat4d");
+
+    benchTransform<float>("mat4f");
+    benchTransform<double>("mat4d");
+
+    benchBulkTransform<float>("mat4f");
+    benchBulkTransform<double>("mat4d");
+
+    benchSkinning<float, 4>("mat4f", " * vec4 skinning loop (100k vertices, 4 bones)", "::skin<4> (100k vertices, 256 bones)", "::skin<4> (100k vertices, 256 bones, normals)");
+    benchSkinning<float, 8>("mat4f", " * vec4 skinning loop (100k vertices, 8 bones)", "::skin<8> (100k vertices, 256 bones)", "::skin<8> (100k vertices, 256 bones, normals)");
+    benchSkinning<double, 4>("mat4d", " * vec4 skinning loop (100k vertices, 4 bones)", "::skin<4> (100k vertices, 256 bones)", "::skin<4> (100k vertices, 256 bones, normals)");
+    benchSkinning<double, 8>("mat4d", " * vec4 skinning loop (100k vertices, 8 bones)", "::skin<8> (100k vertices, 256 bones)", "::skin<8> (100k vertices, 256 bones, normals)");
+
+    benchInverse<float>("mat4f");
+    benchInverse<double>("mat4d");
+
+    benchMisc<float>("mat4f");
+    benchMisc<double>("mat4d");
+}
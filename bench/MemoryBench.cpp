@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Matrices.hpp"
+
+#include "Math\Memory\BlockPool.hpp"
+#include "Math\Memory\FrameArena.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace
+{
+    // The temporaries of a frame : a few buffers of matrices, all thrown away at its end
+    constexpr std::size_t temporaryCount = 8;
+    constexpr std::size_t matrixCount = 256;
+
+    void benchFrameArena()
+    {
+        mat4<float> identity = mat4<float>::identity();
+
+        // Each temporary is filled, as a kernel writing its results would, and lives until the end of the frame
+        bench::run("frame_arena", " temporaries (std::vector<mat4f>)", 1, [&]()
+        {
+            std::vector<mat4<float>> temporaries[temporaryCount];
+
+            for (std::vector<mat4<float>>& matrices : temporaries)
+            {
+                matrices.resize(matrixCount);
+
+                for (mat4<float>& matrix : matrices) matrix = identity;
+                bench::doNotOptimize(matrices.data());
+            }
+        });
+
+        frame_arena arena(temporaryCount * matrixCount * sizeof(mat4<float>));
+
+        bench::run("frame_arena", "::allocate + reset", 1, [&]()
+        {
+            for (std::size_t t = 0; t < temporaryCount; t++)
+            {
+                std::span<mat4<float>> matrices = arena.allocate<mat4<float>>(matrixCount);
+
+                for (mat4<float>& matrix : matrices) matrix = identity;
+                bench::doNotOptimize(matrices.data());
+            }
+
+            arena.reset();
+        });
+
+        bench::run("frame_arena", "::allocateUninitialized + reset", 1, [&]()
+        {
+            for (std::size_t t = 0; t < temporaryCount; t++)
+            {
+                std::span<mat4<float>> matrices = arena.allocateUninitialized<mat4<float>>(matrixCount);
+
+                for (mat4<float>& matrix : matrices) matrix = identity;
+                bench::doNotOptimize(matrices.data());
+            }
+
+            arena.reset();
+        });
+
+        // Every worker asks for its own temporaries
+        per_thread_arena arenas(temporaryCount * matrixCount * sizeof(mat4<float>));
+
+        bench::run("per_thread_arena", "::local + allocate", 64, [&]()
+        {
+            math::parallelFor(64, 1, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t job = begin; job < end; job++)
+                {
+                    std::span<vec3<float>> points = arenas.local().allocate<vec3<float>>(64);
+                    bench::doNotOptimize(points.data());
+                }
+            });
+
+            arenas.reset();
+        });
+    }
+
+    // Buffers that come and go in any order, such as the bone palettes of the characters in view
+    constexpr std::size_t blockSize = 64;
+    constexpr std::size_t liveBlocks = 128;
+
+    void benchBlockPool()
+    {
+        std::vector<mat4<float>*> allocated(liveBlocks);
+
+        bench::run("block_pool", " acquire/release (new[]/delete[])", liveBlocks, [&]()
+        {
+            for (std::size_t i = 0; i < liveBlocks; i++) allocated[i] = new mat4<float>[blockSize];
+            for (std::size_t i = 0; i < liveBlocks; i += 2) delete[] allocated[i];
+            for (std::size_t i = 0; i < liveBlocks; i += 2) allocated[i] = new mat4<float>[blockSize];
+            for (std::size_t i = 0; i < liveBlocks; i++) delete[] allocated[i];
+            bench::doNotOptimize(allocated[0]);
+        });
+
+        block_pool<mat4<float>> pool(blockSize, liveBlocks);
+        std::vector<std::span<mat4<float>>> blocks(liveBlocks);
+
+        bench::run("block_pool", "::acquire/release", liveBlocks, [&]()
+        {
+            for (std::size_t i = 0; i < liveBlocks; i++) blocks[i] = pool.acquire();
+            for (std::size_t i = 0; i < liveBlocks; i += 2) pool.release(blocks[i]);
+            for (std::size_t i = 0; i < liveBlocks; i += 2) blocks[i] = pool.acquire();
+            pool.reset();
+            bench::doNotOptimize(blocks[0].data());
+        });
+    }
+}
+
+void runMemoryBenchmarks()
+{
+    benchFrameArena();
+    benchBlockPool();
+}
@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Matrices.hpp"
+#include "Quaternions.hpp"
+#include "Physics.hpp"
+
+namespace
+{
+    // The bodies of a physics tick
+    constexpr std::size_t bodyCount = 300000;
+
+    // The state of a body as it was stored before rigid_body_soa
+    template<std::floating_point F>
+    struct body
+    {
+        vec3<F> position;
+        vec3<F> velocity;
+        quat<F> orientation;
+        vec3<F> angularVelocity;
+    };
+
+    template<std::floating_point F>
+    void benchIntegration(const char* T)
+    {
+        std::uint32_t seed = 12345;
+        auto random = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<F>(seed >> 8) / static_cast<F>(1 << 24) * 2 - 1;
+        };
+
+        std::vector<body<F>> bodies(bodyCount, body<F>{ vec3<F>::zero(), vec3<F>::zero(), quat<F>::identity(), vec3<F>::zero() });
+        std::vector<vec3<F>> accelerations(bodyCount);
+        rigid_body_soa<F> soaBodies;
+        vec3_soa<F> linearAccelerations(bodyCount);
+        vec3_soa<F> angularAccelerations(bodyCount);
+
+        for (std::size_t i = 0; i < bodyCount; i++)
+        {
+            bodies[i].position = vec3<F>(random() * 100, random() * 100, random() * 100);
+            bodies[i].velocity = vec3<F>(random(), random(), random());
+            bodies[i].orientation = quat<F>(random(), random(), random(), random()).normalized();
+            bodies[i].angularVelocity = vec3<F>(random(), random(), random());
+            accelerations[i] = vec3<F>(random(), random() - static_cast<F>(9.81), random());
+
+            soaBodies.pushBack(bodies[i].position, bodies[i].orientation, bodies[i].velocity, bodies[i].angularVelocity);
+            linearAccelerations.set(i, accelerations[i]);
+            angularAccelerations.set(i, vec3<F>(random(), random(), random()));
+        }
+
+        const F dt = static_cast<F>(1.0 / 60.0);
+
+        // What the tick did before : the operators of vec3 and quat, one body at a time
+        bench::run(T, " semi-implicit Euler (vec3/quat operators)", bodyCount, [&]()
+        {
+            for (std::size_t i = 0; i < bodyCount; i++)
+            {
+                body<F>& b = bodies[i];
+
+                b.velocity += accelerations[i] * dt;
+                b.position += b.velocity * dt;
+
+                quat<F> spin = quat<F>(static_cast<F>(0.0), b.angularVelocity) * b.orientation;
+                F h = static_cast<F>(0.5) * dt;
+
+                b.orientation = quat<F>(b.orientation.w + spin.w * h, b.orientation.x + spin.x * h,
+                                        b.orientation.y + spin.y * h, b.orientation.z + spin.z * h).normalized();
+            }
+            bench::doNotOptimize(bodies.data());
+        });
+
+        bench::run(T, "::integrateEuler", bodyCount, [&]()
+        {
+            rigid_body_soa<F>::integrateEuler(soaBodies, linearAccelerations, angularAccelerations, dt);
+            bench::doNotOptimize(soaBodies.positions.x.data());
+        });
+
+        bench::run(T, "::integrateEuler<fast>", bodyCount, [&]()
+        {
+            rigid_body_soa<F>::template integrateEuler<fast>(soaBodies, linearAccelerations, angularAccelerations, dt);
+            bench::doNotOptimize(soaBodies.positions.x.data());
+        });
+
+        bench::run(T, "::integrateEuler (gravity)", bodyCount, [&]()
+        {
+            rigid_body_soa<F>::integrateEuler(soaBodies, vec3<F>(static_cast<F>(0.0), static_cast<F>(-9.81), static_cast<F>(0.0)), dt);
+            bench::doNotOptimize(soaBodies.positions.x.data());
+        });
+
+        bench::run(T, "::beginVerletStep + endVerletStep", bodyCount, [&]()
+        {
+            rigid_body_soa<F>::beginVerletStep(soaBodies, linearAccelerations, angularAccelerations, dt);
+            rigid_body_soa<F>::endVerletStep(soaBodies, linearAccelerations, angularAccelerations, dt);
+            bench::doNotOptimize(soaBodies.positions.x.data());
+        });
+    }
+}
+
+void runPhysicsBenchmarks()
+{
+    benchIntegration<float>("rigid_bodyf_soa");
+    benchIntegration<double>("rigid_bodyd_soa");
+}
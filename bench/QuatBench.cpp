@@ -0,0 +1,235 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Matrices.hpp"
+#include "Quaternions.hpp"
+
+namespace
+{
+    constexpr std::size_t count = 1024;
+    constexpr std::size_t pointCount = 1 << 20;
+
+    // What rotatePointViaQuat used to do : rot * (0, p) * conjugate(rot)
+    template<std::floating_point F>
+    vec3<F> rotateBySandwich(const vec3<F>& point, const quat<F>& rot)
+    {
+        quat<F> qPoint = quat<F>(static_cast<F>(0.0), point);
+
+        return (rot * qPoint * rot.template getConjugatedQuat<F>()).template XYZ<F>();
+    }
+
+    template<std::floating_point F>
+    void benchRotate(const char* T)
+    {
+        quat<F> rot = quat<F>(static_cast<F>(0.9), static_cast<F>(0.1), static_cast<F>(0.3), static_cast<F>(0.2)).normalized();
+
+        std::vector<vec3<F>> points(pointCount);
+        for (std::size_t i = 0; i < pointCount; i++)
+        {
+            points[i] = vec3<F>(static_cast<F>(i), static_cast<F>(1.0), static_cast<F>(-2.0));
+        }
+
+        std::vector<vec3<F>> out(pointCount);
+        std::vector<quat<F>> rots(pointCount, rot);
+        vec3_soa<F> soaPoints = vec3_soa<F>(std::span<const vec3<F>>(points));
+        vec3_soa<F> soaOut;
+
+        bench::run(T, " sandwich product", pointCount, [&]()
+        {
+            for (std::size_t i = 0; i < pointCount; i++) out[i] = rotateBySandwich(points[i], rot);
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::rotatePointViaQuat", pointCount, [&]()
+        {
+            for (std::size_t i = 0; i < pointCount; i++) out[i] = quat<F>::rotatePointViaQuat(points[i], rot);
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::rotatePoints (AoS, 1 rot)", pointCount, [&]()
+        {
+            quat<F>::rotatePoints(rot, std::span<const vec3<F>>(points), std::span<vec3<F>>(out));
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::rotatePoints (AoS, n rots)", pointCount, [&]()
+        {
+            quat<F>::rotatePoints(std::span<const quat<F>>(rots), std::span<const vec3<F>>(points), std::span<vec3<F>>(out));
+            bench::doNotOptimize(out[0]);
+        });
+
+        bench::run(T, "::rotatePoints (SoA, 1 rot)", pointCount, [&]()
+        {
+            quat<F>::rotatePoints(rot, soaPoints, soaOut);
+            bench::doNotOptimize(soaOut.x[0]);
+        });
+
+        bench::run(T, "::rotatePoints (SoA, n rots)", pointCount, [&]()
+        {
+            quat<F>::rotatePoints(std::span<const quat<F>>(rots), soaPoints, soaOut);
+            bench::doNotOptimize(soaOut.x[0]);
+        });
+    }
+
+    template<std::floating_point F>
+    void benchSkinning(const char* T)
+    {
+        constexpr std::size_t vertexCount = 100000;
+        constexpr std::size_t boneCount = 256;
+        constexpr std::size_t influenceCount = 4;
+
+        std::vector<dualquat<F>> bones;
+        for (std::size_t i = 0; i < boneCount; i++)
+        {
+            F f = static_cast<F>(i);
+            quat<F> rot = quat<F>(static_cast<F>(0.9), static_cast<F>(0.01) * f, static_cast<F>(0.3), static_cast<F>(-0.2)).normalized();
+
+            bones.push_back(dualquat<F>(rot, vec3<F>(f, static_cast<F>(1.0), -f)));
+        }
+
+        std::vector<vec3<F>> positions(vertexCount);
+        std::vector<vec3<F>> normals(vertexCount, vec3<F>::up());
+        std::vector<std::uint16_t> indices(vertexCount * influenceCount);
+        std::vector<F> weights(vertexCount * influenceCount);
+
+        for (std::size_t v = 0; v < vertexCount; v++)
+        {
+            positions[v] = vec3<F>(static_cast<F>(v % 100), static_cast<F>(v / 100), static_cast<F>(1.0));
+
+            for (std::size_t k = 0; k < influenceCount; k++)
+            {
+                indices[v * influenceCount + k] = static_cast<std::uint16_t>((v / 64 + k * 7) % boneCount);
+                weights[v * influenceCount + k] = static_cast<F>(0.25);
+            }
+        }
+
+        std::vector<vec3<F>> outPositions(vertexCount);
+        std::vector<vec3<F>> outNormals(vertexCount);
+
+        bench::run(T, "::skin<4> (100k vertices, 256 bones)", vertexCount, [&]()
+        {
+            dualquat<F>::template skin<influenceCount>(std::span<const dualquat<F>>(bones),
+                std::span<const std::uint16_t>(indices), std::span<const F>(weights),
+                std::span<const vec3<F>>(positions), std::span<vec3<F>>(outPositions));
+            bench::doNotOptimize(outPositions[0]);
+        });
+
+        bench::run(T, "::skin<4> (100k vertices, 256 bones, normals)", vertexCount, [&]()
+        {
+            dualquat<F>::template skin<influenceCount>(std::span<const dualquat<F>>(bones),
+                std::span<const std::uint16_t>(indices), std::span<const F>(weights),
+                std::span<const vec3<F>>(positions), std::span<const vec3<F>>(normals),
+                std::span<vec3<F>>(outPositions), std::span<vec3<F>>(outNormals));
+            bench::doNotOptimize(outPositions[0]);
+        });
+    }
+
+    template<std::floating_point F>
+    void benchQuat(const char* T)
+    {
+        std::vector<quat<F>> a;
+        std::vector<quat<F>> b;
+        std::vector<vec3<F>> eulers(count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            F f = static_cast<F>(i % 17);
+
+            a.push_back(quat<F>(static_cast<F>(0.9), static_cast<F>(0.1) * f, static_cast<F>(0.3), static_cast<F>(0.2)).normalized());
+            b.push_back(quat<F>(static_cast<F>(0.5), static_cast<F>(0.4), static_cast<F>(-0.2) * f, static_cast<F>(0.6)).normalized());
+            eulers[i] = vec3<F>(f * static_cast<F>(10.0), static_cast<F>(45.0), -f);
+        }
+
+        std::vector<quat<F>> out(count, quat<F>::identity());
+        std::vector<vec3<F>> vecsOut(count);
+        std::vector<mat4<F>> matsOut(count);
+        std::vector<F> scalars(count);
+
+        vec3<F> up = vec3<F>::up();
+
+        bench::run(T, " * quat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] * b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::length", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template length<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::lengthSquared", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template lengthSquared<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::normalized<fast>", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                out[i] = b[i];
+                out[i].template normalized<fast>();
+            }
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::getUnitQuat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = b[i].template getUnitQuat<F>();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::getConjugatedQuat", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].template getConjugatedQuat<F>();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::fromAxisAngle", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = quat<F>::fromAxisAngle(up, eulers[i].x);
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::fromEuler", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = quat<F>::fromEuler(eulers[i]);
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::fromEuler<fast>", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = quat<F>::template fromEuler<fast>(eulers[i]);
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::toEuler<fast>", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) vecsOut[i] = a[i].template toEuler<fast>();
+            bench::doNotOptimize(vecsOut[0]);
+        });
+        bench::run(T, "::toEuler", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) vecsOut[i] = a[i].toEuler();
+            bench::doNotOptimize(vecsOut[0]);
+        });
+        bench::run(T, "::lookAt", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = quat<F>::lookAt(vec3<F>::zero(), eulers[i], up);
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::toMat4", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) matsOut[i] = a[i].toMat4();
+            bench::doNotOptimize(matsOut[0]);
+        });
+    }
+}
+
+void runQuatBenchmarks()
+{
+    benchQuat<float>("quatf");
+    benchQuat<double>("quatd");
+
+    benchRotate<float>("quatf");
+    benchRotate<double>("quatd");
+
+    benchSkinning<float>("dualquatf");
+    benchSkinning<double>("dualquatd");
+}
@@ -0,0 +1,218 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+#include "Matrices.hpp"
+#include "Quaternions.hpp"
+#include "Transforms.hpp"
+
+namespace
+{
+    // Each root has 10 children holding 9 leaves each : 2000 roots make about 200k nodes,
+    // and 10000 roots about a million
+    constexpr std::size_t childCount = 10;
+    constexpr std::size_t leafCount = 9;
+
+    // The instances whose matrices are rebuilt every frame
+    constexpr std::size_t instanceCount = 1000000;
+
+    template<std::floating_point F>
+    transform_hierarchy<F> makeScene(std::size_t rootCount,
+                                     std::vector<typename transform_hierarchy<F>::index>& roots,
+                                     std::vector<typename transform_hierarchy<F>::index>& leaves)
+    {
+        using index = typename transform_hierarchy<F>::index;
+
+        transform_hierarchy<F> scene;
+        scene.reserve(rootCount * (1 + childCount * (1 + leafCount)));
+
+        quat<F> rot = quat<F>(static_cast<F>(0.9), static_cast<F>(0.1), static_cast<F>(0.3), static_cast<F>(0.2)).normalized();
+
+        for (std::size_t r = 0; r < rootCount; r++)
+        {
+            index root = scene.addNode(transform_hierarchy<F>::noParent, vec3<F>(static_cast<F>(r), static_cast<F>(0.0), static_cast<F>(0.0)));
+            roots.push_back(root);
+
+            for (std::size_t c = 0; c < childCount; c++)
+            {
+                index child = scene.addNode(root, vec3<F>(static_cast<F>(0.0), static_cast<F>(c), static_cast<F>(0.0)), rot);
+
+                for (std::size_t l = 0; l < leafCount; l++)
+                {
+                    leaves.push_back(scene.addNode(child, vec3<F>(static_cast<F>(0.0), static_cast<F>(0.0), static_cast<F>(l)), rot, vec3<F>::one() * static_cast<F>(0.5)));
+                }
+            }
+        }
+
+        scene.update();
+
+        return scene;
+    }
+
+    template<std::floating_point F>
+    void benchHierarchy(const char* T)
+    {
+        std::vector<typename transform_hierarchy<F>::index> roots;
+        std::vector<typename transform_hierarchy<F>::index> leaves;
+
+        transform_hierarchy<F> scene = makeScene<F>(2000, roots, leaves);
+
+        F offset = static_cast<F>(0.0);
+
+        // The times are per update() of the whole scene
+        bench::run(T, "::update (nothing moved)", 1, [&]()
+        {
+            scene.update();
+            bench::doNotOptimize(scene.world(0));
+        });
+
+        bench::run(T, "::update (1% of the leaves moved)", 1, [&]()
+        {
+            offset += static_cast<F>(0.001);
+
+            for (std::size_t i = 0; i < leaves.size(); i += 100)
+            {
+                scene.setPosition(leaves[i], vec3<F>(offset, static_cast<F>(0.0), static_cast<F>(0.0)));
+            }
+
+            scene.update();
+            bench::doNotOptimize(scene.world(0));
+        });
+
+        bench::run(T, "::update (every root moved)", 1, [&]()
+        {
+            offset += static_cast<F>(0.001);
+
+            for (std::size_t i = 0; i < roots.size(); i++)
+            {
+                scene.setPosition(roots[i], vec3<F>(offset, static_cast<F>(0.0), static_cast<F>(0.0)));
+            }
+
+            scene.update();
+            bench::doNotOptimize(scene.world(0));
+        });
+    }
+
+    // The case update() splits across the threads : every subtree changed
+    template<std::floating_point F>
+    void benchLargeHierarchy(const char* T)
+    {
+        std::vector<typename transform_hierarchy<F>::index> roots;
+        std::vector<typename transform_hierarchy<F>::index> leaves;
+
+        transform_hierarchy<F> scene = makeScene<F>(10000, roots, leaves);
+
+        F offset = static_cast<F>(0.0);
+
+        bench::run(T, "::update (1M nodes, every root moved)", scene.size(), [&]()
+        {
+            offset += static_cast<F>(0.001);
+
+            for (std::size_t i = 0; i < roots.size(); i++)
+            {
+                scene.setPosition(roots[i], vec3<F>(offset, static_cast<F>(0.0), static_cast<F>(0.0)));
+            }
+
+            scene.update();
+            bench::doNotOptimize(scene.world(0));
+        });
+    }
+
+    template<std::floating_point F>
+    void benchBatch(const char* T)
+    {
+        std::uint32_t seed = 12345;
+        auto random = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<F>(seed >> 8) / static_cast<F>(1 << 24) * 2 - 1;
+        };
+
+        std::vector<vec3<F>> positions(instanceCount);
+        std::vector<quat<F>> rotations(instanceCount, quat<F>::identity());
+        std::vector<vec3<F>> scales(instanceCount);
+        vec3_soa<F> soaPositions(instanceCount);
+        quat_soa<F> soaRotations(instanceCount);
+        vec3_soa<F> soaScales(instanceCount);
+
+        for (std::size_t i = 0; i < instanceCount; i++)
+        {
+            positions[i] = vec3<F>(random() * 100, random() * 100, random() * 100);
+            rotations[i] = quat<F>(random(), random(), random(), random()).normalized();
+            scales[i] = vec3<F>(random() + 2, random() + 2, random() + 2);
+
+            soaPositions.set(i, positions[i]);
+            soaRotations.set(i, rotations[i]);
+            soaScales.set(i, scales[i]);
+        }
+
+        std::vector<mat4<F>, aligned_allocator<mat4<F>>> matrices(instanceCount);
+
+        F f0 = static_cast<F>(0.0);
+        F f1 = static_cast<F>(1.0);
+
+        // What an instance cost before : the matrix of each transform, multiplied together
+        bench::run(T, " T * quat::toMat4() * S (mat4 operator*)", instanceCount, [&]()
+        {
+            for (std::size_t i = 0; i < instanceCount; i++)
+            {
+                const vec3<F>& p = positions[i];
+                const vec3<F>& s = scales[i];
+
+                mat4<F> translation(f1, f0, f0, p.x,
+                                    f0, f1, f0, p.y,
+                                    f0, f0, f1, p.z,
+                                    f0, f0, f0, f1);
+                mat4<F> scale(s.x, f0, f0, f0,
+                              f0, s.y, f0, f0,
+                              f0, f0, s.z, f0,
+                              f0, f0, f0, f1);
+
+                matrices[i] = translation * rotations[i].toMat4() * scale;
+            }
+            bench::doNotOptimize(matrices.data());
+        });
+
+        // The closed form of transform_hierarchy, one instance at a time
+        bench::run(T, " composeTRS per instance", instanceCount, [&]()
+        {
+            for (std::size_t i = 0; i < instanceCount; i++)
+            {
+                matrices[i] = detail::composeTRS(positions[i], rotations[i], scales[i]);
+            }
+            bench::doNotOptimize(matrices.data());
+        });
+
+        bench::run(T, " composeTransforms (streaming stores)", instanceCount, [&]()
+        {
+            composeTransforms(soaPositions, soaRotations, soaScales, std::span<mat4<F>>(matrices));
+            bench::doNotOptimize(matrices.data());
+        });
+
+        bench::run(T, " decomposeTransforms", instanceCount, [&]()
+        {
+            decomposeTransforms(std::span<const mat4<F>>(matrices), soaPositions, soaRotations, soaScales);
+            bench::doNotOptimize(soaRotations.w.data());
+        });
+
+        bench::run(T, " decomposeTransforms<fast>", instanceCount, [&]()
+        {
+            decomposeTransforms<fast>(std::span<const mat4<F>>(matrices), soaPositions, soaRotations, soaScales);
+            bench::doNotOptimize(soaRotations.w.data());
+        });
+    }
+}
+
+void runTransformBenchmarks()
+{
+    benchHierarchy<float>("transform_hierarchyf");
+    benchHierarchy<double>("transform_hierarchyd");
+
+    benchLargeHierarchy<float>("transform_hierarchyf");
+    benchLargeHierarchy<double>("transform_hierarchyd");
+
+    benchBatch<float>("mat4f");
+    benchBatch<double>("mat4d");
+}
@@ -0,0 +1,111 @@
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+
+namespace
+{
+    constexpr std::size_t count = 1024;
+
+    template<std::floating_point F>
+    std::vector<vec2<F>> makeVectors(F seed)
+    {
+        std::vector<vec2<F>> vecs(count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            vecs[i] = vec2<F>(seed + static_cast<F>(i % 13) * static_cast<F>(0.5), seed - static_cast<F>(i % 7) * static_cast<F>(0.25));
+        }
+
+        return vecs;
+    }
+
+    template<std::floating_point F>
+    void benchVec2(const char* T)
+    {
+        std::vector<vec2<F>> a = makeVectors<F>(static_cast<F>(1.5));
+        std::vector<vec2<F>> b = makeVectors<F>(static_cast<F>(-0.5));
+        std::vector<vec2<F>> out(count);
+        std::vector<F> scalars(count);
+
+        F s = static_cast<F>(1.25);
+
+        bench::run(T, "::length", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template length<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::lengthSquared", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template lengthSquared<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::dotProduct", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template dotProduct<F>(b[i]);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::distance", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template distance<F>(b[i]);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::distanceSquared", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template distanceSquared<F>(b[i]);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::angleBetween", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = vec2<F>::template angleBetween<F>(a[i], b[i]);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::fromAngle", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = vec2<F>::fromAngle(a[i].x);
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::fromAngle<fast>", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = vec2<F>::template fromAngle<fast>(a[i].x);
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::getUnitVector", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].getUnitVector();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::lerp", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = vec2<F>::lerp(a[i], b[i], static_cast<F>(0.3));
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " + ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] + b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " - ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] - b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " * scalar", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] * s;
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " / scalar", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] / s;
+            bench::doNotOptimize(out[0]);
+        });
+    }
+}
+
+void runVec2Benchmarks()
+{
+    benchVec2<float>("vec2f");
+    benchVec2<double>("vec2d");
+}
@@ -0,0 +1,204 @@
+#include <vector>
+
+#include "Bench.hpp"
+
+#include "Vectors.hpp"
+
+namespace
+{
+    constexpr std::size_t count = 1024;
+
+    // The bulk kernels are measured on more vectors than fit in L1, like the real workloads
+    constexpr std::size_t bulkCount = 1 << 16;
+
+    template<std::floating_point F>
+    std::vector<vec3<F>> makeVectors(std::size_t n, F seed)
+    {
+        std::vector<vec3<F>> vecs(n);
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            vecs[i] = vec3<F>(seed + static_cast<F>(i % 13) * static_cast<F>(0.5),
+                              seed - static_cast<F>(i % 7) * static_cast<F>(0.25),
+                              seed + static_cast<F>(i % 5));
+        }
+
+        return vecs;
+    }
+
+    template<std::floating_point F>
+    void benchVec3(const char* T)
+    {
+        std::vector<vec3<F>> a = makeVectors<F>(count, static_cast<F>(1.5));
+        std::vector<vec3<F>> b = makeVectors<F>(count, static_cast<F>(-0.5));
+        std::vector<vec3<F>> out(count);
+        std::vector<F> scalars(count);
+
+        F s = static_cast<F>(1.25);
+
+        bench::run(T, "::length", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template length<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::lengthSquared", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template lengthSquared<F>();
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::dotProduct", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template dotProduct<F>(b[i]);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::crossProduct", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].crossProduct(b[i]);
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::distance", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template distance<F>(b[i]);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::distanceSquared", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) scalars[i] = a[i].template distanceSquared<F>(b[i]);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::getUnitVector", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i].getUnitVector();
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::normalized<fast>", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                out[i] = a[i];
+                out[i].template normalized<fast>();
+            }
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, "::lerp", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = vec3<F>::lerp(a[i], b[i], static_cast<F>(0.3));
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " + ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] + b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " - ", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] - b[i];
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " * scalar", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] * s;
+            bench::doNotOptimize(out[0]);
+        });
+        bench::run(T, " / scalar", count, [&]()
+        {
+            for (std::size_t i = 0; i < count; i++) out[i] = a[i] / s;
+            bench::doNotOptimize(out[0]);
+        });
+    }
+
+    template<std::floating_point F>
+    void benchVec3Soa(const char* T)
+    {
+        std::vector<vec3<F>> aos = makeVectors<F>(bulkCount, static_cast<F>(1.5));
+        std::vector<vec3<F>> aosOut(bulkCount);
+
+        vec3_soa<F> a = vec3_soa<F>(std::span<const vec3<F>>(aos));
+        vec3_soa<F> b = vec3_soa<F>(std::span<const vec3<F>>(makeVectors<F>(bulkCount, static_cast<F>(-0.5))));
+        vec3_soa<F> c = vec3_soa<F>(std::span<const vec3<F>>(makeVectors<F>(bulkCount, static_cast<F>(0.75))));
+        vec3_soa<F> out;
+        vec3_soa<F> tmp;
+        std::vector<F> scalars(bulkCount);
+
+        F s = static_cast<F>(1.25);
+
+        bench::run(T, "::length", bulkCount, [&]()
+        {
+            vec3_soa<F>::length(a, scalars);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::lengthSquared", bulkCount, [&]()
+        {
+            vec3_soa<F>::lengthSquared(a, scalars);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::dotProduct", bulkCount, [&]()
+        {
+            vec3_soa<F>::dotProduct(a, b, scalars);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::crossProduct", bulkCount, [&]()
+        {
+            vec3_soa<F>::crossProduct(a, b, out);
+            bench::doNotOptimize(out.x[0]);
+        });
+        bench::run(T, "::distance", bulkCount, [&]()
+        {
+            vec3_soa<F>::distance(a, b, scalars);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::distanceSquared", bulkCount, [&]()
+        {
+            vec3_soa<F>::distanceSquared(a, b, scalars);
+            bench::doNotOptimize(scalars[0]);
+        });
+        bench::run(T, "::lerp", bulkCount, [&]()
+        {
+            vec3_soa<F>::lerp(a, b, static_cast<F>(0.3), out);
+            bench::doNotOptimize(out.x[0]);
+        });
+        bench::run(T, "::normalized", bulkCount, [&]()
+        {
+            out = a;
+            out.normalized();
+            bench::doNotOptimize(out.x[0]);
+        });
+
+        bench::run(T, "::normalized<fast>", bulkCount, [&]()
+        {
+            out = a;
+            out.template normalized<fast>();
+            bench::doNotOptimize(out.x[0]);
+        });
+
+        // The same a + b * s - c, one buffer written per operator, then as a single fused expression
+        bench::run(T, " a + b * s - c (eager)", bulkCount, [&]()
+        {
+            tmp = lazy(b) * s;
+            tmp = lazy(a) + lazy(tmp);
+            out = lazy(tmp) - lazy(c);
+            bench::doNotOptimize(out.x[0]);
+        });
+        bench::run(T, " a + b * s - c (lazy)", bulkCount, [&]()
+        {
+            out = lazy(a) + lazy(b) * s - lazy(c);
+            bench::doNotOptimize(out.x[0]);
+        });
+
+        // The AoS loop the SoA kernels replace
+        bench::run(T, "::normalized (AoS loop)", bulkCount, [&]()
+        {
+            for (std::size_t i = 0; i < bulkCount; i++) aosOut[i] = aos[i].getUnitVector();
+            bench::doNotOptimize(aosOut[0]);
+        });
+    }
+}
+
+void runVec3Benchmarks()
+{
+    benchVec3<float>("vec3f");
+    benchVec3<double>("vec3d");
+
+    benchVec3Soa<float>("vec3f_soa");
+    benchVec3Soa<double>("vec3d_soa");
+}
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Bench.hpp"
+
+#include "Math\Simd\Simd.hpp"
+
+void runVec2Benchmarks();
+void runVec3Benchmarks();
+void runMat2Benchmarks();
+void runMat3Benchmarks();
+void runMat4Benchmarks();
+void runQuatBenchmarks();
+void runTransformBenchmarks();
+void runAnimationBenchmarks();
+void runGeometryBenchmarks();
+void runMemoryBenchmarks();
+void runPhysicsBenchmarks();
+
+namespace
+{
+    const char* simdLevel()
+    {
+    #if defined(MATH_SIMD_AVX2)
+        return "avx2";
+    #elif defined(MATH_SIMD_AVX)
+        return "avx";
+    #elif defined(MATH_SIMD_SSE)
+        return "sse";
+    #else
+        return "scalar";
+    #endif
+    }
+
+    void printUsage()
+    {
+        std::printf("Usage : MathLib_bench [--filter <text>] [--min-time <seconds>] [--json <file | ->]\n"
+                    "  --filter    only runs the operations whose name contains text\n"
+                    "  --min-time  minimum time spent on each operation (0.2 by default)\n"
+                    "  --json      writes the results as JSON to file, or to stdout with -\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* jsonPath = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue) bench::config().filter = argv[++i];
+        else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) bench::config().minSeconds = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue) jsonPath = argv[++i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // The table would break the JSON printed on stdout
+    bool jsonToStdout = jsonPath != nullptr && std::strcmp(jsonPath, "-") == 0;
+    bench::config().verbose = !jsonToStdout;
+
+    runVec2Benchmarks();
+    runVec3Benchmarks();
+    runMat2Benchmarks();
+    runMat3Benchmarks();
+    runMat4Benchmarks();
+    runQuatBenchmarks();
+    runTransformBenchmarks();
+    runAnimationBenchmarks();
+    runGeometryBenchmarks();
+    runMemoryBenchmarks();
+    runPhysicsBenchmarks();
+
+    if (jsonToStdout)
+    {
+        bench::writeJson(stdout, simdLevel());
+    }
+    else if (jsonPath != nullptr)
+    {
+        std::FILE* file = std::fopen(jsonPath, "w");
+
+        if (file == nullptr)
+        {
+            std::fprintf(stderr, "Could not open %s\n", jsonPath);
+            return 1;
+        }
+
+        bench::writeJson(file, simdLevel());
+        std::fclose(file);
+    }
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Math\Animation\AnimationClip.hpp"
+#include "Math\Animation\AnimationSampler.hpp"
+#include "Math\Animation\CompressedClip.hpp"
+
+using namespace math;
+
+using animation_clipf = math::animation_clip<float>;
+using animation_clipd = math::animation_clip<double>;
+using animation_clipld = math::animation_clip<long double>;
+
+using animation_samplerf = math::animation_sampler<float>;
+using animation_samplerd = math::animation_sampler<double>;
+using animation_samplerld = math::animation_sampler<long double>;
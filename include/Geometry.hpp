@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Math\Algorithms\RadixSort.hpp"
+#include "Math\Geometry\Aabb.hpp"
+#include "Math\Geometry\Bvh.hpp"
+#include "Math\Geometry\Frustum.hpp"
+#include "Math\Geometry\Morton.hpp"
+#include "Math\Geometry\RaySoA.hpp"
+#include "Math\Geometry\SpatialHash.hpp"
+
+using namespace math;
+
+using frustumf = math::frustum<float>;
+using frustumd = math::frustum<double>;
+using frustumld = math::frustum<long double>;
+
+using aabbf = math::aabb<float>;
+using aabbd = math::aabb<double>;
+using aabbld = math::aabb<long double>;
+
+using bvhf = math::bvh<float>;
+using bvhd = math::bvh<double>;
+using bvhld = math::bvh<long double>;
+
+using rayf_soa = math::ray_soa<float>;
+using rayd_soa = math::ray_soa<double>;
+using rayld_soa = math::ray_soa<long double>;
+
+using spatial_hashf = math::spatial_hash<float>;
+using spatial_hashd = math::spatial_hash<double>;
+using spatial_hashld = math::spatial_hash<long double>;
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include "Math\Vectors\Vector3SoA.hpp"
+
+namespace math
+{
+    // Sorts keys in increasing order, the keys being equal keeping their order, and moves the values of every
+    // payload the same way, so that payload[i] still goes with keys[i]. A payload is a vec3_soa, or any
+    // contiguous range (such as a std::vector or a std::span) holding at least keys.size() values.
+    //
+    // This is a least significant digit radix sort, one byte at a time, in linear time : the keys are split
+    // across the threads of math::thread_pool, each one counting then moving its own keys. The bytes that are
+    // the same in every key are skipped, so 30 bit keys take at most 4 passes. Only the keys and their
+    // original indices move during the passes, every payload being gathered once at the end.
+    template<std::unsigned_integral Key, typename... Payloads>
+    void radixSort(std::span<Key> keys, Payloads&... payloads);
+
+    namespace detail
+    {
+        // The fewest keys a thread sorts
+        inline constexpr std::size_t radixSortChunkSize = 16384;
+        // The number of buckets of a pass, one per value of a byte
+        inline constexpr std::size_t radixSortBucketCount = 256;
+    }
+}
+
+#include "Math\Algorithms\RadixSort.inl"
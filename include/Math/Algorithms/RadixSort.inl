@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    namespace detail
+    {
+        // Replaces payload[i] by payload[permutation[i]] for every i of permutation
+        template<std::ranges::contiguous_range R>
+        inline void applyPermutation(R& payload, std::span<const std::uint32_t> permutation)
+        {
+            using T = std::ranges::range_value_t<R>;
+
+            T* values = std::ranges::data(payload);
+            std::vector<T> sorted(permutation.size());
+
+            math::parallelFor(permutation.size(), radixSortChunkSize, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; i++) sorted[i] = values[permutation[i]];
+            });
+
+            std::move(sorted.begin(), sorted.end(), values);
+        }
+
+        template<std::floating_point F>
+        inline void applyPermutation(vec3_soa<F>& payload, std::span<const std::uint32_t> permutation)
+        {
+            applyPermutation(payload.x, permutation);
+            applyPermutation(payload.y, permutation);
+            applyPermutation(payload.z, permutation);
+        }
+
+        template<std::unsigned_integral Key>
+        inline std::size_t radixDigit(Key key, std::size_t digit)
+        {
+            return static_cast<std::size_t>(key >> (8 * digit)) & (radixSortBucketCount - 1);
+        }
+    }
+
+    template<std::unsigned_integral Key, typename... Payloads>
+    inline void radixSort(std::span<Key> keys, Payloads&... payloads)
+    {
+        constexpr std::size_t digitCount = sizeof(Key);
+        constexpr std::size_t bucketCount = detail::radixSortBucketCount;
+
+        std::size_t count = keys.size();
+
+        if (count < 2) return;
+
+        std::size_t chunkCount = std::clamp<std::size_t>(count / detail::radixSortChunkSize, 1, thread_pool::instance().concurrency());
+        auto chunkBegin = [&](std::size_t chunk) { return chunk * count / chunkCount; };
+
+        // The number of keys of each chunk in each bucket, for every digit
+        std::vector<std::uint32_t> counts(chunkCount * digitCount * bucketCount, 0);
+        auto chunkCounts = [&](std::size_t chunk, std::size_t digit) { return counts.data() + (chunk * digitCount + digit) * bucketCount; };
+
+        math::parallelFor(chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+        {
+            for (std::size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                std::size_t end = chunkBegin(chunk + 1);
+
+                for (std::size_t i = chunkBegin(chunk); i < end; i++)
+                {
+                    for (std::size_t digit = 0; digit < digitCount; digit++) chunkCounts(chunk, digit)[detail::radixDigit(keys[i], digit)]++;
+                }
+            }
+        });
+
+        // The indices are only needed to move the payloads
+        constexpr bool hasPayloads = sizeof...(Payloads) > 0;
+
+        std::vector<Key> keyBuffer(count);
+        std::vector<std::uint32_t> indexBuffers[2];
+
+        if constexpr (hasPayloads)
+        {
+            indexBuffers[0].resize(count);
+            indexBuffers[1].resize(count);
+        }
+
+        Key* source = keys.data();
+        Key* target = keyBuffer.data();
+        // The index of each key in keys, nullptr until the first pass, the keys being in their original order
+        std::uint32_t* sourceIndices = nullptr;
+        std::size_t passCount = 0;
+
+        for (std::size_t digit = 0; digit < digitCount; digit++)
+        {
+            // A byte that is the same in every key puts them all in a single bucket, and would not move them
+            bool skip = false;
+
+            for (std::size_t bucket = 0; bucket < bucketCount && !skip; bucket++)
+            {
+                std::size_t total = 0;
+
+                for (std::size_t chunk = 0; chunk < chunkCount; chunk++) total += chunkCounts(chunk, digit)[bucket];
+
+                skip = total == count;
+            }
+
+            if (skip) continue;
+
+            // The counts were taken on the original order : once the keys moved, each chunk holds other keys
+            if (passCount > 0 && chunkCount > 1)
+            {
+                math::parallelFor(chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+                {
+                    for (std::size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+                    {
+                        std::uint32_t* bucketCounts = chunkCounts(chunk, digit);
+                        std::size_t end = chunkBegin(chunk + 1);
+
+                        std::fill_n(bucketCounts, bucketCount, 0);
+
+                        for (std::size_t i = chunkBegin(chunk); i < end; i++) bucketCounts[detail::radixDigit(source[i], digit)]++;
+                    }
+                });
+            }
+
+            // Turns the counts into the slot of the next key of each chunk in each bucket, the chunks of a bucket
+            // following each other so that equal keys keep their order
+            std::uint32_t slot = 0;
+
+            for (std::size_t bucket = 0; bucket < bucketCount; bucket++)
+            {
+                for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+                {
+                    std::uint32_t& chunkSlot = chunkCounts(chunk, digit)[bucket];
+                    std::uint32_t bucketSize = chunkSlot;
+
+                    chunkSlot = slot;
+                    slot += bucketSize;
+                }
+            }
+
+            std::uint32_t* targetIndices = indexBuffers[passCount % 2].data();
+
+            math::parallelFor(chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+            {
+                for (std::size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+                {
+                    std::uint32_t* slots = chunkCounts(chunk, digit);
+                    std::size_t end = chunkBegin(chunk + 1);
+
+                    for (std::size_t i = chunkBegin(chunk); i < end; i++)
+                    {
+                        std::uint32_t keySlot = slots[detail::radixDigit(source[i], digit)]++;
+
+                        target[keySlot] = source[i];
+
+                        if constexpr (hasPayloads) targetIndices[keySlot] = sourceIndices ? sourceIndices[i] : static_cast<std::uint32_t>(i);
+                    }
+                }
+            });
+
+            std::swap(source, target);
+            sourceIndices = targetIndices;
+            passCount++;
+        }
+
+        if (passCount == 0) return;
+
+        if (source != keys.data()) std::copy(source, source + count, keys.data());
+
+        if constexpr (hasPayloads)
+        {
+            std::span<const std::uint32_t> permutation(sourceIndices, count);
+
+            (detail::applyPermutation(payloads, permutation), ...);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Memory\AlignedAllocator.hpp"
+#include "Math\Quaternions\Quaternion.hpp"
+#include "Math\Vectors\Vector3.hpp"
+
+namespace math
+{
+    // A set of animation tracks, typically one per bone, each track holding a translation, a rotation and
+    // a scale channel. Each channel has its own keys, at increasing times, so that a channel that does
+    // not move can hold a single key.
+    //
+    // The keys of a channel are stored for every track at once, as a structure of arrays : the times in
+    // one array and the values in another, the keys of the track i being [offsets[i], offsets[i + 1]).
+    // A value stays in one piece rather than being split in one array per component : the tracks are
+    // sampled at different keys, and one key is then one cache line instead of three or four.
+    // The clip is only the data, math::animation_sampler reads it
+    template<std::floating_point F>
+    class animation_clip
+    {
+    public:
+        using index = std::uint32_t;
+        using array = std::vector<F, aligned_allocator<F>>;
+
+        template<typename T>
+        struct channel
+        {
+            array times;
+            std::vector<T, aligned_allocator<T>> values;
+            std::vector<index> offsets;
+        };
+
+        using vec3_channel = channel<vec3<F>>;
+        using quat_channel = channel<quat<F>>;
+
+    public:
+        // Constructor that returns a clip without any track
+        animation_clip();
+
+        std::size_t trackCount() const;
+        // Returns the time of the last key of the clip
+        F duration() const;
+
+        void clear();
+
+        // Appends a track and returns its index. Each channel takes its key times (increasing) and its
+        // values, with at least one key and as many values as times
+        index addTrack(std::span<const F> translationTimes, std::span<const vec3<F>> translations,
+                       std::span<const F> rotationTimes, std::span<const quat<F>> rotations,
+                       std::span<const F> scaleTimes, std::span<const vec3<F>> scales);
+
+        const vec3_channel& translations() const;
+        const quat_channel& rotations() const;
+        const vec3_channel& scales() const;
+
+    private:
+        vec3_channel translationKeys;
+        quat_channel rotationKeys;
+        vec3_channel scaleKeys;
+
+        F lastTime;
+    };
+}
+
+#include "Math\Animation\AnimationClip.inl"
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+namespace math
+{
+    namespace detail
+    {
+        template<std::floating_point F, typename T>
+        inline void appendKeys(typename animation_clip<F>::template channel<T>& channel, std::span<const F> times, std::span<const T> values)
+        {
+            channel.times.insert(channel.times.end(), times.begin(), times.end());
+            channel.values.insert(channel.values.end(), values.begin(), values.end());
+            channel.offsets.push_back(static_cast<typename animation_clip<F>::index>(channel.times.size()));
+        }
+    }
+
+    template<std::floating_point F>
+    inline animation_clip<F>::animation_clip() : lastTime(static_cast<F>(0.0))
+    {
+        translationKeys.offsets.push_back(0);
+        rotationKeys.offsets.push_back(0);
+        scaleKeys.offsets.push_back(0);
+    }
+
+    template<std::floating_point F>
+    inline std::size_t animation_clip<F>::trackCount() const
+    {
+        return rotationKeys.offsets.size() - 1;
+    }
+
+    template<std::floating_point F>
+    inline F animation_clip<F>::duration() const
+    {
+        return lastTime;
+    }
+
+    template<std::floating_point F>
+    inline void animation_clip<F>::clear()
+    {
+        *this = animation_clip();
+    }
+
+    template<std::floating_point F>
+    inline typename animation_clip<F>::index animation_clip<F>::addTrack(std::span<const F> translationTimes, std::span<const vec3<F>> translations,
+                                                                         std::span<const F> rotationTimes, std::span<const quat<F>> rotations,
+                                                                         std::span<const F> scaleTimes, std::span<const vec3<F>> scales)
+    {
+        index track = static_cast<index>(trackCount());
+
+        detail::appendKeys<F, vec3<F>>(translationKeys, translationTimes, translations);
+        detail::appendKeys<F, quat<F>>(rotationKeys, rotationTimes, rotations);
+        detail::appendKeys<F, vec3<F>>(scaleKeys, scaleTimes, scales);
+
+        lastTime = std::max({ lastTime, translationTimes.back(), rotationTimes.back(), scaleTimes.back() });
+
+        return track;
+    }
+
+    template<std::floating_point F>
+    inline const typename animation_clip<F>::vec3_channel& animation_clip<F>::translations() const
+    {
+        return translationKeys;
+    }
+
+    template<std::floating_point F>
+    inline const typename animation_clip<F>::quat_channel& animation_clip<F>::rotations() const
+    {
+        return rotationKeys;
+    }
+
+    template<std::floating_point F>
+    inline const typename animation_clip<F>::vec3_channel& animation_clip<F>::scales() const
+    {
+        return scaleKeys;
+    }
+}
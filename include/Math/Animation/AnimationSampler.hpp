@@ -0,0 +1,92 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Animation\AnimationClip.hpp"
+#include "Math\Animation\CompressedClip.hpp"
+#include "Math\Precision.hpp"
+#include "Math\Quaternions\Quaternion.hpp"
+#include "Math\Vectors\Vector3.hpp"
+
+namespace math
+{
+    // Samples every track of an animation_clip at a given time.
+    //
+    // The sampler remembers, for each channel of each track, the key it found last time. As an animation
+    // mostly plays forward by small steps, the next sample finds its key at that cursor or a few keys
+    // after it, and only a jump in time (a loop, a seek) goes through a binary search.
+    // A sampler is meant to follow one playback of a clip : two characters playing the same clip at
+    // different times should each have their own sampler.
+    //
+    // The translations and scales are interpolated linearly. The rotations are gathered by blocks of tracks,
+    // then interpolated and normalized across the SIMD lanes. The tracks are split across the threads of
+    // math::thread_pool.
+    template<std::floating_point F>
+    class animation_sampler
+    {
+    public:
+        using index = typename animation_clip<F>::index;
+
+    public:
+        // Constructor that returns a sampler without any cached key
+        animation_sampler();
+
+        // Forgets the cached keys, the next sample starting from the first keys of every track
+        void reset();
+
+        // Writes the translation, rotation and scale of every track of clip at time in translations, rotations
+        // and scales, that must hold at least clip.trackCount() values each. time is clamped to the keys of each
+        // channel. The rotations are interpolated with quat::nlerp, Policy being the precision of the inverse square root
+        template<Precision Policy = precise>
+        void sample(const animation_clip<F>& clip, F time,
+                    std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales);
+
+        // Same as sample, but the rotations are interpolated with quat::slerp, Policy being the precision of acos and sin
+        template<Precision Policy = precise>
+        void sampleSlerp(const animation_clip<F>& clip, F time,
+                         std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales);
+
+        // Same as sample, the keys of clip being decoded as they are read
+        template<Precision Policy = precise>
+        void sample(const compressed_clip& clip, F time,
+                    std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales);
+
+        // Same as sampleSlerp, the keys of clip being decoded as they are read
+        template<Precision Policy = precise>
+        void sampleSlerp(const compressed_clip& clip, F time,
+                         std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales);
+
+    private:
+        // Samples trackCount tracks from channels that give their key times, their offsets and value(track, key)
+        template<bool Slerp, Precision Policy, typename Vec3Keys, typename QuatKeys>
+        void sampleTracks(std::size_t trackCount, const Vec3Keys& translationKeys, const QuatKeys& rotationKeys, const Vec3Keys& scaleKeys, F time,
+                          std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales);
+
+    private:
+        // The last key found for each track, relative to the first key of the track
+        std::vector<index> translationCursors;
+        std::vector<index> rotationCursors;
+        std::vector<index> scaleCursors;
+    };
+
+    namespace detail
+    {
+        // The number of tracks given to a thread at once by the sampler
+        inline constexpr std::size_t samplingChunkSize = 2048;
+
+        // The number of keys the cursor walks forward before falling back to a binary search
+        inline constexpr std::size_t cursorSteps = 4;
+
+        // Returns the key k of [first, last) such that times[k] <= time < times[k + 1], starting the search from
+        // first + cursor and updating it. next is k + 1, or k for a single key, and t is the position of time
+        // between both, clamped between 0.0 and 1.0. times are either seconds or the 16 bits steps of a compressed_clip
+        template<typename T, std::floating_point F, std::unsigned_integral I>
+        inline I locateKey(const T* times, I first, I last, I& cursor, F time, I& next, F& t);
+    }
+}
+
+#include "Math\Animation\AnimationSampler.inl"
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Math\Memory\AlignedAllocator.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    inline animation_sampler<F>::animation_sampler()
+    {
+    }
+
+    template<std::floating_point F>
+    inline void animation_sampler<F>::reset()
+    {
+        std::fill(translationCursors.begin(), translationCursors.end(), index(0));
+        std::fill(rotationCursors.begin(), rotationCursors.end(), index(0));
+        std::fill(scaleCursors.begin(), scaleCursors.end(), index(0));
+    }
+
+    namespace detail
+    {
+        template<typename T, std::floating_point F, std::unsigned_integral I>
+        inline I locateKey(const T* times, I first, I last, I& cursor, F time, I& next, F& t)
+        {
+            if (last - first == 1)
+            {
+                next = first;
+                t = static_cast<F>(0.0);
+
+                return first;
+            }
+
+            // A cursor is never on the last key of its track, as k + 1 is read : one on or past it comes from
+            // another clip, and the search starts over
+            I k = first + (cursor + 1 < last - first ? cursor : I(0));
+
+            if (time >= times[k])
+            {
+                for (std::size_t step = 0; step < cursorSteps && k + 2 < last && time >= times[k + 1]; step++)
+                {
+                    k++;
+                }
+
+                if (k + 2 < last && time >= times[k + 1])
+                {
+                    k = static_cast<I>(std::upper_bound(times + k + 1, times + last - 1, time) - times) - 1;
+                }
+            }
+            else
+            {
+                // The time went backwards, the key is before the cursor
+                const T* key = std::upper_bound(times + first, times + k, time);
+                k = key == times + first ? first : static_cast<I>(key - times) - 1;
+            }
+
+            cursor = k - first;
+            next = k + 1;
+
+            F length = static_cast<F>(times[next]) - static_cast<F>(times[k]);
+            t = length > static_cast<F>(0.0) ? clamp01((time - static_cast<F>(times[k])) / length) : static_cast<F>(0.0);
+
+            return k;
+        }
+
+        // The keys of a channel of an animation_clip
+        template<std::floating_point F, typename V>
+        struct clip_keys
+        {
+            const F* times;
+            const std::uint32_t* offsets;
+            const V* values;
+
+            clip_keys(const typename animation_clip<F>::template channel<V>& channel) :
+                times(channel.times.data()), offsets(channel.offsets.data()), values(channel.values.data())
+            {
+            }
+
+            V value(std::size_t, std::uint32_t key) const
+            {
+                return values[key];
+            }
+        };
+
+        // The keys of a translation or scale channel of a compressed_clip, decoded when they are read
+        template<std::floating_point F>
+        struct compressed_vec3_keys
+        {
+            const std::uint16_t* times;
+            const std::uint32_t* offsets;
+            compressed_clip::channel_view channel;
+
+            compressed_vec3_keys(const compressed_clip::channel_view& channel) :
+                times(channel.times), offsets(channel.offsets), channel(channel)
+            {
+            }
+
+            vec3<F> value(std::size_t track, std::uint32_t key) const
+            {
+                return decodeVec3Key<F>(channel, track, key);
+            }
+        };
+
+        template<std::floating_point F>
+        struct compressed_quat_keys
+        {
+            const std::uint16_t* times;
+            const std::uint32_t* offsets;
+            compressed_clip::channel_view channel;
+
+            compressed_quat_keys(const compressed_clip::channel_view& channel) :
+                times(channel.times), offsets(channel.offsets), channel(channel)
+            {
+            }
+
+            quat<F> value(std::size_t, std::uint32_t key) const
+            {
+                return decodeQuatKey<F>(channel, key);
+            }
+        };
+
+        // The key times of a compressed_clip are steps of its duration
+        template<std::floating_point F>
+        inline F compressedClipTime(const compressed_clip& clip, F time)
+        {
+            F duration = static_cast<F>(clip.duration());
+
+            return duration > static_cast<F>(0.0) ? time * (static_cast<F>(clipTimeSteps) / duration) : static_cast<F>(0.0);
+        }
+
+        template<std::floating_point F, typename Keys>
+        inline void sampleVec3Channel(const Keys& keys, std::uint32_t* cursors, F time, vec3<F>* out, std::size_t begin, std::size_t end)
+        {
+            for (std::size_t track = begin; track < end; track++)
+            {
+                std::uint32_t next;
+                F t;
+                std::uint32_t k = locateKey(keys.times, keys.offsets[track], keys.offsets[track + 1], cursors[track], time, next, t);
+
+                vec3<F> a = keys.value(track, k);
+                vec3<F> b = keys.value(track, next);
+
+                out[track] = vec3<F>(a.x + (b.x - a.x) * t,
+                                     a.y + (b.y - a.y) * t,
+                                     a.z + (b.z - a.z) * t);
+            }
+        }
+
+        // The keys of a block of rotation tracks, gathered for the SIMD lanes
+        template<std::floating_point F>
+        struct rotation_block
+        {
+            alignas(cacheLineSize) F aw[soaBlockSize];
+            alignas(cacheLineSize) F ax[soaBlockSize];
+            alignas(cacheLineSize) F ay[soaBlockSize];
+            alignas(cacheLineSize) F az[soaBlockSize];
+            alignas(cacheLineSize) F bw[soaBlockSize];
+            alignas(cacheLineSize) F bx[soaBlockSize];
+            alignas(cacheLineSize) F by[soaBlockSize];
+            alignas(cacheLineSize) F bz[soaBlockSize];
+            // t for nlerp, the weights of a and b for slerp
+            alignas(cacheLineSize) F startWeights[soaBlockSize];
+            alignas(cacheLineSize) F endWeights[soaBlockSize];
+        };
+
+        template<bool Slerp, Precision Policy, std::floating_point F, typename Keys>
+        inline void sampleQuatChannel(const Keys& keys, std::uint32_t* cursors, F time, quat<F>* out, std::size_t begin, std::size_t end)
+        {
+            rotation_block<F> block;
+
+            for (std::size_t first = begin; first < end; first += soaBlockSize)
+            {
+                std::size_t count = std::min(soaBlockSize, end - first);
+
+                // The keys of neighbouring tracks are not next to each other : they are gathered one by one
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    std::size_t track = first + i;
+
+                    std::uint32_t next;
+                    F t;
+                    std::uint32_t k = locateKey(keys.times, keys.offsets[track], keys.offsets[track + 1], cursors[track], time, next, t);
+
+                    quat<F> a = keys.value(track, k);
+                    quat<F> b = keys.value(track, next);
+
+                    block.aw[i] = a.w; block.ax[i] = a.x; block.ay[i] = a.y; block.az[i] = a.z;
+                    block.bw[i] = b.w; block.bx[i] = b.x; block.by[i] = b.y; block.bz[i] = b.z;
+
+                    if constexpr (Slerp)
+                    {
+                        F dot = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+                        slerpWeights<Policy>(dot, t, block.startWeights[i], block.endWeights[i]);
+                    }
+                    else
+                    {
+                        block.endWeights[i] = t;
+                    }
+                }
+
+                simd::forEachPack<F>(0, count, [&](auto p, std::size_t i)
+                {
+                    using P = decltype(p);
+
+                    P aw = P::load(block.aw + i), ax = P::load(block.ax + i), ay = P::load(block.ay + i), az = P::load(block.az + i);
+                    P bw = P::load(block.bw + i), bx = P::load(block.bx + i), by = P::load(block.by + i), bz = P::load(block.bz + i);
+
+                    P startWeight;
+                    P endWeight;
+
+                    if constexpr (Slerp)
+                    {
+                        startWeight = P::load(block.startWeights + i);
+                        endWeight = P::load(block.endWeights + i);
+                    }
+                    else
+                    {
+                        // The shortest path : b is negated when it is in the other hemisphere than a
+                        P t = P::load(block.endWeights + i);
+                        P dot = simd::madd(aw, bw, simd::madd(ax, bx, simd::madd(ay, by, az * bz)));
+
+                        startWeight = P::broadcast(static_cast<F>(1.0)) - t;
+                        endWeight = simd::select(simd::cmpLt(dot, P::zero()), -t, t);
+                    }
+
+                    P rw = simd::madd(bw, endWeight, aw * startWeight);
+                    P rx = simd::madd(bx, endWeight, ax * startWeight);
+                    P ry = simd::madd(by, endWeight, ay * startWeight);
+                    P rz = simd::madd(bz, endWeight, az * startWeight);
+
+                    P l = simd::madd(rw, rw, simd::madd(rx, rx, simd::madd(ry, ry, rz * rz)));
+
+                    P inverseLength;
+                    if constexpr (std::same_as<Policy, fast>) inverseLength = simd::rsqrtFast(l);
+                    else inverseLength = P::broadcast(static_cast<F>(1.0)) / simd::sqrt(l);
+
+                    (rw * inverseLength).store(block.aw + i);
+                    (rx * inverseLength).store(block.ax + i);
+                    (ry * inverseLength).store(block.ay + i);
+                    (rz * inverseLength).store(block.az + i);
+                });
+
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    out[first + i] = quat<F>(block.aw[i], block.ax[i], block.ay[i], block.az[i]);
+                }
+            }
+        }
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline void animation_sampler<F>::sample(const animation_clip<F>& clip, F time,
+                                             std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales)
+    {
+        sampleTracks<false, Policy>(clip.trackCount(), detail::clip_keys<F, vec3<F>>(clip.translations()), detail::clip_keys<F, quat<F>>(clip.rotations()),
+                                    detail::clip_keys<F, vec3<F>>(clip.scales()), time, translations, rotations, scales);
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline void animation_sampler<F>::sampleSlerp(const animation_clip<F>& clip, F time,
+                                                  std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales)
+    {
+        sampleTracks<true, Policy>(clip.trackCount(), detail::clip_keys<F, vec3<F>>(clip.translations()), detail::clip_keys<F, quat<F>>(clip.rotations()),
+                                   detail::clip_keys<F, vec3<F>>(clip.scales()), time, translations, rotations, scales);
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline void animation_sampler<F>::sample(const compressed_clip& clip, F time,
+                                             std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales)
+    {
+        sampleTracks<false, Policy>(clip.trackCount(), detail::compressed_vec3_keys<F>(clip.translations()), detail::compressed_quat_keys<F>(clip.rotations()),
+                                    detail::compressed_vec3_keys<F>(clip.scales()), detail::compressedClipTime(clip, time), translations, rotations, scales);
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline void animation_sampler<F>::sampleSlerp(const compressed_clip& clip, F time,
+                                                  std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales)
+    {
+        sampleTracks<true, Policy>(clip.trackCount(), detail::compressed_vec3_keys<F>(clip.translations()), detail::compressed_quat_keys<F>(clip.rotations()),
+                                   detail::compressed_vec3_keys<F>(clip.scales()), detail::compressedClipTime(clip, time), translations, rotations, scales);
+    }
+
+    template<std::floating_point F>
+    template<bool Slerp, Precision Policy, typename Vec3Keys, typename QuatKeys>
+    inline void animation_sampler<F>::sampleTracks(std::size_t trackCount, const Vec3Keys& translationKeys, const QuatKeys& rotationKeys,
+                                                   const Vec3Keys& scaleKeys, F time,
+                                                   std::span<vec3<F>> translations, std::span<quat<F>> rotations, std::span<vec3<F>> scales)
+    {
+        if (rotationCursors.size() != trackCount)
+        {
+            translationCursors.assign(trackCount, index(0));
+            rotationCursors.assign(trackCount, index(0));
+            scaleCursors.assign(trackCount, index(0));
+        }
+
+        index* translationCursor = translationCursors.data();
+        index* rotationCursor = rotationCursors.data();
+        index* scaleCursor = scaleCursors.data();
+        vec3<F>* outTranslations = translations.data();
+        quat<F>* outRotations = rotations.data();
+        vec3<F>* outScales = scales.data();
+
+        math::parallelFor(trackCount, detail::samplingChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            detail::sampleVec3Channel(translationKeys, translationCursor, time, outTranslations, begin, end);
+            detail::sampleQuatChannel<Slerp, Policy>(rotationKeys, rotationCursor, time, outRotations, begin, end);
+            detail::sampleVec3Channel(scaleKeys, scaleCursor, time, outScales, begin, end);
+        });
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Animation\AnimationClip.hpp"
+#include "Math\Memory\MappedFile.hpp"
+#include "Math\Quaternions\Quaternion.hpp"
+#include "Math\Vectors\Vector3.hpp"
+
+namespace math
+{
+    // The error allowed when removing keys from a clip
+    struct clip_compression_settings
+    {
+        // The distance between a translation (or a scale) of the clip and the one rebuilt from the kept keys
+        float translationError = 0.0005f;
+        float scaleError = 0.0005f;
+        // The angle, in degrees, between a rotation of the clip and the one rebuilt from the kept keys
+        float rotationError = 0.05f;
+    };
+
+    // An animation_clip in a compact binary form, that is sampled without being decompressed first.
+    //
+    // - Keyframe reduction : a key is removed when interpolating its neighbours rebuilds it within the
+    //   error of clip_compression_settings. A channel that does not move keeps a single key.
+    // - Key times are stored on 16 bits, relative to the duration of the clip.
+    // - Translations and scales are stored on 16 bits per component, relative to the range of their track.
+    // - Rotations are stored on 48 bits with the smallest three method : the largest component is dropped
+    //   (it is rebuilt from the length of 1.0), and the three others are stored on 15 bits each.
+    //
+    // The quantization adds, on top of the reduction error, at most half a step of 1 / 65535 of the range of
+    // a translation or scale track, about 0.005 degrees to a rotation, and moves the keys by at most half a
+    // step of 1 / 65535 of the duration of the clip.
+    //
+    // The binary form is one block, little-endian, that load() maps in memory as is : no parsing and no
+    // copy happen until the keys are read by animation_sampler. The values are read in place, so the
+    // clip is only available on little-endian targets. The clip is move-only
+    class compressed_clip
+    {
+        static_assert(std::endian::native == std::endian::little, "The mapped clips are read in place, in little-endian");
+
+    public:
+        using index = std::uint32_t;
+
+    public:
+        // Constructor that returns an empty clip
+        compressed_clip();
+
+        compressed_clip(const compressed_clip&) = delete;
+        compressed_clip& operator=(const compressed_clip&) = delete;
+
+        compressed_clip(compressed_clip&& other) noexcept;
+        compressed_clip& operator=(compressed_clip&& other) noexcept;
+
+        template<std::floating_point F>
+        static compressed_clip compress(const animation_clip<F>& clip, const clip_compression_settings& settings = clip_compression_settings());
+
+        // Maps the file at path in memory, and returns false if it could not be opened or is not a valid clip
+        bool load(const char* path);
+        // Copies data, and returns false if it is not a valid clip
+        bool load(std::span<const std::byte> data);
+        // Writes the binary form to the file at path, and returns false if it could not be written
+        bool save(const char* path) const;
+
+        bool empty() const;
+        std::size_t trackCount() const;
+        float duration() const;
+
+        // Returns the binary form of the clip
+        std::span<const std::byte> data() const;
+
+    private:
+        // Checks the header and the size of bytes, and points the clip to it
+        bool attach(std::span<const std::byte> bytes);
+
+    public:
+        // The keys of one channel, read in place by animation_sampler
+        struct channel_view
+        {
+            const index* offsets;
+            const std::uint16_t* times;
+            // For translations and scales : (min.x, min.y, min.z, step.x, step.y, step.z) per track
+            const float* ranges;
+            // 3 values per key
+            const std::uint16_t* values;
+        };
+
+        channel_view translations() const;
+        channel_view rotations() const;
+        channel_view scales() const;
+
+    private:
+        std::vector<std::byte> buffer;
+        mapped_file file;
+
+        std::span<const std::byte> bytes;
+    };
+
+    namespace detail
+    {
+        // "CLIP"
+        inline constexpr std::uint32_t clipMagic = 0x50494c43u;
+        inline constexpr std::uint32_t clipVersion = 1;
+
+        // The largest value of the 16 bits key times
+        inline constexpr float clipTimeSteps = 65535.0f;
+
+        struct clip_header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t trackCount;
+            float duration;
+            // The number of keys of the translation, rotation and scale channels
+            std::uint32_t keyCounts[3];
+            std::uint32_t reserved;
+        };
+
+        // Where the arrays of each channel start in the binary form, each one being aligned on 8 bytes
+        struct clip_layout
+        {
+            std::size_t offsets[3];
+            std::size_t times[3];
+            std::size_t ranges[3];
+            std::size_t values[3];
+            std::size_t size;
+        };
+
+        inline clip_layout clipLayout(const clip_header& header);
+
+        // Decodes a translation or a scale key
+        template<std::floating_point F>
+        vec3<F> decodeVec3Key(const compressed_clip::channel_view& channel, std::size_t track, compressed_clip::index key);
+        // Decodes a smallest three rotation key
+        template<std::floating_point F>
+        quat<F> decodeQuatKey(const compressed_clip::channel_view& channel, compressed_clip::index key);
+    }
+}
+
+#include "Math\Animation\CompressedClip.inl"
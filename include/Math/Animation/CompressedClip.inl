@@ -0,0 +1,507 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Math\MathInternal.hpp"
+
+namespace math
+{
+    namespace detail
+    {
+        inline std::size_t alignClipOffset(std::size_t offset)
+        {
+            return (offset + 7) & ~std::size_t(7);
+        }
+
+        inline clip_layout clipLayout(const clip_header& header)
+        {
+            clip_layout layout = {};
+            std::size_t position = alignClipOffset(sizeof(clip_header));
+
+            for (int channel = 0; channel < 3; channel++)
+            {
+                std::size_t keyCount = header.keyCounts[channel];
+
+                layout.offsets[channel] = position;
+                position = alignClipOffset(position + (std::size_t(header.trackCount) + 1) * sizeof(std::uint32_t));
+
+                layout.times[channel] = position;
+                position = alignClipOffset(position + keyCount * sizeof(std::uint16_t));
+
+                // Rotations have no range
+                layout.ranges[channel] = position;
+                if (channel != 1) position = alignClipOffset(position + std::size_t(header.trackCount) * 6 * sizeof(float));
+
+                layout.values[channel] = position;
+                position = alignClipOffset(position + keyCount * 3 * sizeof(std::uint16_t));
+            }
+
+            layout.size = position;
+
+            return layout;
+        }
+
+        // Greedy keyframe reduction : from each kept key start, the next kept key is the farthest one end such that
+        // fits(start, end, key) is true for every key after start up to end. Writes the kept keys in kept
+        template<typename Fits>
+        inline void reduceKeys(std::size_t count, Fits&& fits, std::vector<std::size_t>& kept)
+        {
+            kept.clear();
+            kept.push_back(0);
+
+            std::size_t start = 0;
+
+            while (start + 1 < count)
+            {
+                std::size_t end = start + 1;
+
+                while (end + 1 < count)
+                {
+                    bool fitting = true;
+
+                    for (std::size_t key = start + 1; key <= end + 1 && fitting; key++)
+                    {
+                        fitting = fits(start, end + 1, key);
+                    }
+
+                    if (!fitting) break;
+
+                    end++;
+                }
+
+                kept.push_back(end);
+                start = end;
+            }
+        }
+
+        template<std::floating_point F>
+        inline F keyPosition(const F* times, std::size_t start, std::size_t end, std::size_t key)
+        {
+            F length = times[end] - times[start];
+
+            return length > static_cast<F>(0.0) ? (times[key] - times[start]) / length : static_cast<F>(0.0);
+        }
+
+        template<std::floating_point F>
+        inline F rotationAngle(const quat<F>& a, const quat<F>& b)
+        {
+            F dot = math::abs(a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z);
+
+            return static_cast<F>(2.0) * math::acos(math::min(dot, static_cast<F>(1.0))) * math::radToDeg<F>();
+        }
+
+        inline std::uint16_t quantizeTime(float time, float duration)
+        {
+            if (duration <= 0.0f) return 0;
+
+            return static_cast<std::uint16_t>(math::clamp(time / duration * clipTimeSteps + 0.5f, 0.0f, clipTimeSteps));
+        }
+
+        // Appends the kept keys of every track of a translation or scale channel
+        template<std::floating_point F>
+        inline void compressVec3Channel(const typename animation_clip<F>::vec3_channel& channel, std::size_t trackCount, float duration, float error,
+                                        std::vector<std::uint32_t>& offsets, std::vector<std::uint16_t>& times,
+                                        std::vector<float>& ranges, std::vector<std::uint16_t>& values)
+        {
+            std::vector<std::size_t> kept;
+
+            offsets.push_back(0);
+
+            for (std::size_t track = 0; track < trackCount; track++)
+            {
+                std::size_t first = channel.offsets[track];
+                std::size_t count = channel.offsets[track + 1] - first;
+
+                const F* keyTimes = channel.times.data() + first;
+                const vec3<F>* keys = channel.values.data() + first;
+
+                F maxError = static_cast<F>(error);
+
+                bool still = std::all_of(keys, keys + count, [&](const vec3<F>& key) { return vec3<F>::template distance<F>(key, keys[0]) <= maxError; });
+
+                if (still)
+                {
+                    kept.assign(1, 0);
+                }
+                else
+                {
+                    reduceKeys(count, [&](std::size_t start, std::size_t end, std::size_t key)
+                    {
+                        vec3<F> rebuilt = vec3<F>::lerpUnclamped(keys[start], keys[end], keyPosition(keyTimes, start, end, key));
+                        return vec3<F>::template distance<F>(rebuilt, keys[key]) <= maxError;
+                    }, kept);
+                }
+
+                // The range of the track, each component being stored as min + q * step
+                vec3<F> low = keys[kept[0]];
+                vec3<F> high = keys[kept[0]];
+
+                for (std::size_t key : kept)
+                {
+                    low = vec3<F>(math::min(low.x, keys[key].x), math::min(low.y, keys[key].y), math::min(low.z, keys[key].z));
+                    high = vec3<F>(math::max(high.x, keys[key].x), math::max(high.y, keys[key].y), math::max(high.z, keys[key].z));
+                }
+
+                float min[3] = { static_cast<float>(low.x), static_cast<float>(low.y), static_cast<float>(low.z) };
+                float step[3] = { static_cast<float>(high.x - low.x) / 65535.0f, static_cast<float>(high.y - low.y) / 65535.0f, static_cast<float>(high.z - low.z) / 65535.0f };
+
+                ranges.insert(ranges.end(), min, min + 3);
+                ranges.insert(ranges.end(), step, step + 3);
+
+                for (std::size_t key : kept)
+                {
+                    times.push_back(quantizeTime(static_cast<float>(keyTimes[key]), duration));
+
+                    F components[3] = { keys[key].x, keys[key].y, keys[key].z };
+
+                    for (int c = 0; c < 3; c++)
+                    {
+                        float q = step[c] > 0.0f ? (static_cast<float>(components[c]) - min[c]) / step[c] + 0.5f : 0.0f;
+                        values.push_back(static_cast<std::uint16_t>(math::clamp(q, 0.0f, 65535.0f)));
+                    }
+                }
+
+                offsets.push_back(static_cast<std::uint32_t>(times.size()));
+            }
+        }
+
+        // Writes the smallest three form of rotation : the three smallest components on 15 bits each, the
+        // index of the largest one being split in the last bit of the first two values
+        template<std::floating_point F>
+        inline void encodeQuatKey(quat<F> rotation, std::uint16_t (&values)[3])
+        {
+            rotation.normalized();
+
+            F components[4] = { rotation.w, rotation.x, rotation.y, rotation.z };
+
+            int largest = 0;
+
+            for (int c = 1; c < 4; c++)
+            {
+                if (math::abs(components[c]) > math::abs(components[largest])) largest = c;
+            }
+
+            // q and -q are the same rotation : the largest component is made positive, so that its sign
+            // does not have to be stored
+            F sign = components[largest] < static_cast<F>(0.0) ? static_cast<F>(-1.0) : static_cast<F>(1.0);
+
+            int v = 0;
+
+            for (int c = 0; c < 4; c++)
+            {
+                if (c == largest) continue;
+
+                // The smallest components are in [-1 / sqrt(2), 1 / sqrt(2)]
+                float q = (static_cast<float>(components[c] * sign) * math::sqrtOf2<float>() + 1.0f) * 0.5f * 32767.0f + 0.5f;
+                values[v++] = static_cast<std::uint16_t>(math::clamp(q, 0.0f, 32767.0f));
+            }
+
+            values[0] |= static_cast<std::uint16_t>((largest & 1) << 15);
+            values[1] |= static_cast<std::uint16_t>((largest >> 1) << 15);
+        }
+
+        template<std::floating_point F>
+        inline void compressQuatChannel(const typename animation_clip<F>::quat_channel& channel, std::size_t trackCount, float duration, float error,
+                                        std::vector<std::uint32_t>& offsets, std::vector<std::uint16_t>& times, std::vector<std::uint16_t>& values)
+        {
+            std::vector<std::size_t> kept;
+
+            offsets.push_back(0);
+
+            for (std::size_t track = 0; track < trackCount; track++)
+            {
+                std::size_t first = channel.offsets[track];
+                std::size_t count = channel.offsets[track + 1] - first;
+
+                const F* keyTimes = channel.times.data() + first;
+                const quat<F>* keys = channel.values.data() + first;
+
+                F maxError = static_cast<F>(error);
+
+                bool still = std::all_of(keys, keys + count, [&](const quat<F>& key) { return rotationAngle(key, keys[0]) <= maxError; });
+
+                if (still)
+                {
+                    kept.assign(1, 0);
+                }
+                else
+                {
+                    // The sampler interpolates with nlerp by default, which is the rebuilt rotation measured here.
+                    // Unlike a lerp, two nlerp do not drift apart the most at the keys : the rotation halfway
+                    // to the previous key is measured too
+                    reduceKeys(count, [&](std::size_t start, std::size_t end, std::size_t key)
+                    {
+                        quat<F> rebuilt = quat<F>::nlerp(keys[start], keys[end], keyPosition(keyTimes, start, end, key));
+                        if (rotationAngle(rebuilt, keys[key]) > maxError) return false;
+
+                        F halfway = (keyTimes[key - 1] + keyTimes[key]) * static_cast<F>(0.5);
+                        F length = keyTimes[end] - keyTimes[start];
+                        F t = length > static_cast<F>(0.0) ? (halfway - keyTimes[start]) / length : static_cast<F>(0.0);
+
+                        quat<F> original = quat<F>::nlerp(keys[key - 1], keys[key], static_cast<F>(0.5));
+                        return rotationAngle(quat<F>::nlerp(keys[start], keys[end], t), original) <= maxError;
+                    }, kept);
+                }
+
+                for (std::size_t key : kept)
+                {
+                    times.push_back(quantizeTime(static_cast<float>(keyTimes[key]), duration));
+
+                    std::uint16_t encoded[3];
+                    encodeQuatKey(keys[key], encoded);
+
+                    values.insert(values.end(), encoded, encoded + 3);
+                }
+
+                offsets.push_back(static_cast<std::uint32_t>(times.size()));
+            }
+        }
+
+        template<typename T>
+        inline void writeClipArray(std::vector<std::byte>& buffer, std::size_t offset, const std::vector<T>& values)
+        {
+            if (!values.empty()) std::memcpy(buffer.data() + offset, values.data(), values.size() * sizeof(T));
+        }
+
+        template<std::floating_point F>
+        inline vec3<F> decodeVec3Key(const compressed_clip::channel_view& channel, std::size_t track, compressed_clip::index key)
+        {
+            const float* range = channel.ranges + track * 6;
+            const std::uint16_t* q = channel.values + std::size_t(key) * 3;
+
+            return vec3<F>(static_cast<F>(range[0] + static_cast<float>(q[0]) * range[3]),
+                           static_cast<F>(range[1] + static_cast<float>(q[1]) * range[4]),
+                           static_cast<F>(range[2] + static_cast<float>(q[2]) * range[5]));
+        }
+
+        template<std::floating_point F>
+        inline quat<F> decodeQuatKey(const compressed_clip::channel_view& channel, compressed_clip::index key)
+        {
+            const std::uint16_t* q = channel.values + std::size_t(key) * 3;
+
+            int largest = (q[0] >> 15) | ((q[1] >> 15) << 1);
+
+            F scale = static_cast<F>(2.0 / 32767.0);
+            F inverseSqrt2 = static_cast<F>(1.0) / math::sqrtOf2<F>();
+
+            F a = (static_cast<F>(q[0] & 0x7fff) * scale - static_cast<F>(1.0)) * inverseSqrt2;
+            F b = (static_cast<F>(q[1] & 0x7fff) * scale - static_cast<F>(1.0)) * inverseSqrt2;
+            F c = (static_cast<F>(q[2] & 0x7fff) * scale - static_cast<F>(1.0)) * inverseSqrt2;
+
+            F l = math::sqrt(math::max(static_cast<F>(1.0) - (a * a + b * b + c * c), static_cast<F>(0.0)));
+
+            switch (largest)
+            {
+                case 0: return quat<F>(l, a, b, c);
+                case 1: return quat<F>(a, l, b, c);
+                case 2: return quat<F>(a, b, l, c);
+                default: return quat<F>(a, b, c, l);
+            }
+        }
+    }
+
+    inline compressed_clip::compressed_clip()
+    {
+    }
+
+    inline compressed_clip::compressed_clip(compressed_clip&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    inline compressed_clip& compressed_clip::operator=(compressed_clip&& other) noexcept
+    {
+        if (this != &other)
+        {
+            // Moving the vector or the mapping keeps their bytes where they are
+            buffer = std::move(other.buffer);
+            file = std::move(other.file);
+            bytes = std::exchange(other.bytes, std::span<const std::byte>());
+
+            other.buffer.clear();
+        }
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    inline compressed_clip compressed_clip::compress(const animation_clip<F>& clip, const clip_compression_settings& settings)
+    {
+        std::size_t trackCount = clip.trackCount();
+        float duration = static_cast<float>(clip.duration());
+
+        std::vector<std::uint32_t> offsets[3];
+        std::vector<std::uint16_t> times[3];
+        std::vector<float> ranges[3];
+        std::vector<std::uint16_t> values[3];
+
+        detail::compressVec3Channel<F>(clip.translations(), trackCount, duration, settings.translationError, offsets[0], times[0], ranges[0], values[0]);
+        detail::compressQuatChannel<F>(clip.rotations(), trackCount, duration, settings.rotationError, offsets[1], times[1], values[1]);
+        detail::compressVec3Channel<F>(clip.scales(), trackCount, duration, settings.scaleError, offsets[2], times[2], ranges[2], values[2]);
+
+        detail::clip_header header = {};
+        header.magic = detail::clipMagic;
+        header.version = detail::clipVersion;
+        header.trackCount = static_cast<std::uint32_t>(trackCount);
+        header.duration = duration;
+
+        for (int channel = 0; channel < 3; channel++)
+        {
+            header.keyCounts[channel] = static_cast<std::uint32_t>(times[channel].size());
+        }
+
+        detail::clip_layout layout = detail::clipLayout(header);
+
+        compressed_clip res;
+        res.buffer.assign(layout.size, std::byte(0));
+
+        std::memcpy(res.buffer.data(), &header, sizeof(header));
+
+        for (int channel = 0; channel < 3; channel++)
+        {
+            detail::writeClipArray(res.buffer, layout.offsets[channel], offsets[channel]);
+            detail::writeClipArray(res.buffer, layout.times[channel], times[channel]);
+            detail::writeClipArray(res.buffer, layout.ranges[channel], ranges[channel]);
+            detail::writeClipArray(res.buffer, layout.values[channel], values[channel]);
+        }
+
+        res.bytes = std::span<const std::byte>(res.buffer);
+
+        return res;
+    }
+
+    inline bool compressed_clip::load(const char* path)
+    {
+        buffer.clear();
+        bytes = std::span<const std::byte>();
+
+        if (!file.open(path)) return false;
+
+        if (!attach(file.data()))
+        {
+            file.close();
+            return false;
+        }
+
+        return true;
+    }
+
+    inline bool compressed_clip::load(std::span<const std::byte> data)
+    {
+        file.close();
+        buffer.assign(data.begin(), data.end());
+        bytes = std::span<const std::byte>();
+
+        if (!attach(std::span<const std::byte>(buffer)))
+        {
+            buffer.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    inline bool compressed_clip::save(const char* path) const
+    {
+        std::FILE* out = std::fopen(path, "wb");
+        if (out == nullptr) return false;
+
+        bool written = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+
+        return std::fclose(out) == 0 && written;
+    }
+
+    inline bool compressed_clip::attach(std::span<const std::byte> data)
+    {
+        if (data.size() < sizeof(detail::clip_header)) return false;
+
+        detail::clip_header header;
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if (header.magic != detail::clipMagic || header.version != detail::clipVersion) return false;
+
+        detail::clip_layout layout = detail::clipLayout(header);
+        if (layout.size != data.size()) return false;
+
+        // Every track needs at least one key in each channel, and the offsets must cover the keys exactly
+        for (int channel = 0; channel < 3; channel++)
+        {
+            const index* offsets = reinterpret_cast<const index*>(data.data() + layout.offsets[channel]);
+
+            if (offsets[0] != 0 || offsets[header.trackCount] != header.keyCounts[channel]) return false;
+
+            for (std::size_t track = 0; track < header.trackCount; track++)
+            {
+                if (offsets[track + 1] <= offsets[track]) return false;
+            }
+        }
+
+        bytes = data;
+
+        return true;
+    }
+
+    inline bool compressed_clip::empty() const
+    {
+        return bytes.empty();
+    }
+
+    inline std::size_t compressed_clip::trackCount() const
+    {
+        if (bytes.empty()) return 0;
+
+        return reinterpret_cast<const detail::clip_header*>(bytes.data())->trackCount;
+    }
+
+    inline float compressed_clip::duration() const
+    {
+        if (bytes.empty()) return 0.0f;
+
+        return reinterpret_cast<const detail::clip_header*>(bytes.data())->duration;
+    }
+
+    inline std::span<const std::byte> compressed_clip::data() const
+    {
+        return bytes;
+    }
+
+    namespace detail
+    {
+        inline compressed_clip::channel_view clipChannel(std::span<const std::byte> bytes, int channel)
+        {
+            if (bytes.empty()) return { nullptr, nullptr, nullptr, nullptr };
+
+            const clip_header* header = reinterpret_cast<const clip_header*>(bytes.data());
+            clip_layout layout = clipLayout(*header);
+
+            return
+            {
+                reinterpret_cast<const compressed_clip::index*>(bytes.data() + layout.offsets[channel]),
+                reinterpret_cast<const std::uint16_t*>(bytes.data() + layout.times[channel]),
+                reinterpret_cast<const float*>(bytes.data() + layout.ranges[channel]),
+                reinterpret_cast<const std::uint16_t*>(bytes.data() + layout.values[channel])
+            };
+        }
+    }
+
+    inline compressed_clip::channel_view compressed_clip::translations() const
+    {
+        return detail::clipChannel(bytes, 0);
+    }
+
+    inline compressed_clip::channel_view compressed_clip::rotations() const
+    {
+        return detail::clipChannel(bytes, 1);
+    }
+
+    inline compressed_clip::channel_view compressed_clip::scales() const
+    {
+        return detail::clipChannel(bytes, 2);
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <concepts>
+
+#include "Math\Vectors\Vector3.hpp"
+
+namespace math
+{
+    // A struct used to represent an axis-aligned bounding box, from its min and max corners
+    template<std::floating_point F>
+    struct aabb
+    {
+    public:
+        vec3<F> min;
+        vec3<F> max;
+
+    public:
+        // Constructor that returns an empty box : min is +infinity and max is -infinity, so that
+        // growing it by anything returns that thing
+        constexpr aabb();
+        // Constructor that returns the box going from min to max
+        constexpr aabb(const vec3<F>& min, const vec3<F>& max);
+
+        // Returns the box of center center and of half-size extents
+        static constexpr aabb fromCenterExtents(const vec3<F>& center, const vec3<F>& extents);
+
+        constexpr bool empty() const;
+
+        constexpr vec3<F> center() const;
+        // Returns the half-size of the box
+        constexpr vec3<F> extents() const;
+        constexpr F surfaceArea() const;
+
+        constexpr bool contains(const vec3<F>& point) const;
+        // Returns true if both boxes overlap, touching boxes overlapping
+        constexpr bool intersects(const aabb& other) const;
+
+        // Grows the box so that it contains point
+        constexpr aabb& grow(const vec3<F>& point);
+        // Grows the box so that it contains other
+        constexpr aabb& grow(const aabb& other);
+
+        // Returns the smallest box containing both a and b
+        static constexpr aabb merge(const aabb& a, const aabb& b);
+    };
+}
+
+#include "Math\Geometry\Aabb.inl"
@@ -0,0 +1,93 @@
+#include <concepts>
+#include <limits>
+
+#include "Math\MathInternal.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    constexpr aabb<F>::aabb() :
+        min(std::numeric_limits<F>::infinity(), std::numeric_limits<F>::infinity(), std::numeric_limits<F>::infinity()),
+        max(-std::numeric_limits<F>::infinity(), -std::numeric_limits<F>::infinity(), -std::numeric_limits<F>::infinity())
+    {
+    }
+
+    template<std::floating_point F>
+    constexpr aabb<F>::aabb(const vec3<F>& min, const vec3<F>& max) : min(min), max(max)
+    {
+    }
+
+    template<std::floating_point F>
+    constexpr aabb<F> aabb<F>::fromCenterExtents(const vec3<F>& center, const vec3<F>& extents)
+    {
+        return aabb(center - extents, center + extents);
+    }
+
+    template<std::floating_point F>
+    constexpr bool aabb<F>::empty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    template<std::floating_point F>
+    constexpr vec3<F> aabb<F>::center() const
+    {
+        return (min + max) * static_cast<F>(0.5);
+    }
+
+    template<std::floating_point F>
+    constexpr vec3<F> aabb<F>::extents() const
+    {
+        return (max - min) * static_cast<F>(0.5);
+    }
+
+    template<std::floating_point F>
+    constexpr F aabb<F>::surfaceArea() const
+    {
+        if (empty()) return static_cast<F>(0.0);
+
+        vec3<F> size = max - min;
+
+        return static_cast<F>(2.0) * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    template<std::floating_point F>
+    constexpr bool aabb<F>::contains(const vec3<F>& point) const
+    {
+        return point.x >= min.x && point.x <= max.x &&
+               point.y >= min.y && point.y <= max.y &&
+               point.z >= min.z && point.z <= max.z;
+    }
+
+    template<std::floating_point F>
+    constexpr bool aabb<F>::intersects(const aabb& other) const
+    {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    template<std::floating_point F>
+    constexpr aabb<F>& aabb<F>::grow(const vec3<F>& point)
+    {
+        min = vec3<F>(math::min(min.x, point.x), math::min(min.y, point.y), math::min(min.z, point.z));
+        max = vec3<F>(math::max(max.x, point.x), math::max(max.y, point.y), math::max(max.z, point.z));
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr aabb<F>& aabb<F>::grow(const aabb& other)
+    {
+        min = vec3<F>(math::min(min.x, other.min.x), math::min(min.y, other.min.y), math::min(min.z, other.min.z));
+        max = vec3<F>(math::max(max.x, other.max.x), math::max(max.y, other.max.y), math::max(max.z, other.max.z));
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr aabb<F> aabb<F>::merge(const aabb& a, const aabb& b)
+    {
+        return aabb(a).grow(b);
+    }
+}
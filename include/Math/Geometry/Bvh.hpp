@@ -0,0 +1,117 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Geometry\Aabb.hpp"
+#include "Math\Memory\AlignedAllocator.hpp"
+#include "Math\Vectors\Vector3.hpp"
+
+namespace math
+{
+    // A bounding volume hierarchy over a set of axis-aligned boxes (the primitives), used to find the
+    // primitives a box overlaps or a ray hits without testing every one of them.
+    //
+    // build() splits the primitives with the surface area heuristic, evaluated on a few bins per axis
+    // instead of every possible split. The top of the tree is built one node at a time, the primitives of
+    // each node being binned across the threads of math::thread_pool, then the subtrees below it are built
+    // in parallel, one per thread at a time.
+    // refit() keeps the tree and only updates its boxes, for primitives that moved without the tree being
+    // rebuilt : it is much cheaper, but the tree gets worse as the primitives move away from where they were
+    // when it was built.
+    //
+    // A node is 32 bytes for float : its box, and either its two children (next to each other) or the range
+    // of its primitives.
+    template<std::floating_point F>
+    class bvh
+    {
+    public:
+        using index = std::uint32_t;
+
+        struct alignas(32) node
+        {
+            vec3<F> min;
+            // The first child for an inner node, the first primitive in primitives() for a leaf
+            index first;
+            vec3<F> max;
+            // The number of primitives of a leaf, 0 for an inner node
+            index count;
+
+            bool isLeaf() const { return count != 0; }
+        };
+
+    public:
+        // Constructor that returns an empty hierarchy
+        bvh();
+
+        // Builds the hierarchy over boxes, the primitive i being boxes[i]
+        void build(std::span<const aabb<F>> boxes);
+        // Updates the boxes of every node for primitives that moved, boxes having as many boxes as in build()
+        void refit(std::span<const aabb<F>> boxes);
+        void clear();
+
+        bool empty() const;
+        // Returns the box of every primitive
+        aabb<F> bounds() const;
+
+        // The root is nodes()[0]
+        std::span<const node> nodes() const;
+        // The primitives in the order of the leaves
+        std::span<const index> primitives() const;
+
+        // Calls fn(primitive) for every primitive whose box overlaps box
+        template<typename Fn>
+        void queryOverlaps(const aabb<F>& box, Fn&& fn) const;
+
+        // Calls hit(primitive, maxDistance) for the primitives whose box is hit by the ray before maxDistance,
+        // the nearest nodes first. hit returns the distance at which the ray hits the primitive, or maxDistance
+        // if it misses it : the ray stops at the closest hit so far, and the nodes behind it are skipped.
+        // Returns the distance of the closest hit, or maxDistance if nothing was hit
+        template<typename Hit>
+        F raycast(const vec3<F>& origin, const vec3<F>& direction, F maxDistance, Hit&& hit) const;
+
+    private:
+        // Nodes [first, last) of a subtree built on its own, refit in parallel with the others
+        struct subtree
+        {
+            index root;
+            index first;
+            index last;
+        };
+
+        std::vector<node, aligned_allocator<node>> treeNodes;
+        std::vector<index> primitiveIndices;
+        // The box of each primitive, in the order of primitiveIndices
+        std::vector<aabb<F>> leafBoxes;
+
+        std::vector<subtree> subtrees;
+        // The nodes built before the subtrees
+        index topNodeCount = 0;
+    };
+
+    namespace detail
+    {
+        // The number of bins per axis the split is chosen from
+        inline constexpr std::size_t bvhBinCount = 16;
+        // A leaf holds at most this number of primitives
+        inline constexpr std::size_t bvhMaxLeafSize = 8;
+        // A node with at most this number of primitives becomes a leaf without looking for a split
+        inline constexpr std::size_t bvhMinSplitSize = 4;
+        // A node with at most this number of primitives is built as a subtree, by a single thread
+        inline constexpr std::size_t bvhSubtreeSize = 8192;
+        // The number of primitives binned at once by a thread when building the top of the tree
+        inline constexpr std::size_t bvhBinningChunkSize = 16384;
+        // The cost of visiting a node relative to testing a primitive
+        inline constexpr double bvhTraversalCost = 1.0;
+
+        // The depth of the traversal stacks. Past bvhMedianDepth, the nodes are split in half, which
+        // keeps any tree of 2^32 primitives within it
+        inline constexpr std::size_t bvhStackSize = 96;
+        inline constexpr std::size_t bvhMedianDepth = 56;
+    }
+}
+
+#include "Math\Geometry\Bvh.inl"
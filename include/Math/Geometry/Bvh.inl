@@ -0,0 +1,573 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    namespace detail
+    {
+        // A node of the hierarchy still to be built, from the primitives [begin, end)
+        struct bvh_build_task
+        {
+            std::uint32_t node;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t depth;
+        };
+
+        // A primitive being built, moved with its box so that the nodes read them in order
+        template<std::floating_point F>
+        struct bvh_primitive
+        {
+            aabb<F> box;
+            std::uint32_t index;
+
+            // Twice the center of the box, which saves a multiplication and gives the same splits
+            vec3<F> centroid() const { return box.min + box.max; }
+        };
+
+        template<std::floating_point F>
+        struct bvh_range_bounds
+        {
+            aabb<F> boxes;
+            aabb<F> centroids;
+        };
+
+        template<std::floating_point F>
+        struct bvh_bins
+        {
+            aabb<F> bounds[3][bvhBinCount];
+            std::size_t counts[3][bvhBinCount] = {};
+        };
+
+        template<std::floating_point F>
+        inline F axisValue(const vec3<F>& vec, int axis)
+        {
+            return axis == 0 ? vec.x : (axis == 1 ? vec.y : vec.z);
+        }
+
+        template<std::floating_point F>
+        inline std::size_t binIndex(F centroid, F min, F scale, std::size_t binCount)
+        {
+            // Through int, which converts far faster than std::size_t
+            int bin = static_cast<int>((centroid - min) * scale);
+
+            return static_cast<std::size_t>(std::clamp(bin, 0, static_cast<int>(binCount) - 1));
+        }
+
+        template<std::floating_point F>
+        inline typename bvh<F>::node bvhNode(const aabb<F>& bounds, std::size_t first, std::size_t count)
+        {
+            return { bounds.min, static_cast<std::uint32_t>(first), bounds.max, static_cast<std::uint32_t>(count) };
+        }
+
+        // Runs fn(first, last, partial) over [begin, end), by chunks of bvhBinningChunkSize across the threads when
+        // parallel is true, and returns the partial results merged with merge(res, partial)
+        template<typename T, typename Fn, typename Merge>
+        inline T reduceChunks(std::size_t begin, std::size_t end, bool parallel, Fn&& fn, Merge&& merge)
+        {
+            T res = T();
+
+            if (!parallel || end - begin <= bvhBinningChunkSize)
+            {
+                fn(begin, end, res);
+                return res;
+            }
+
+            std::size_t chunkCount = (end - begin + bvhBinningChunkSize - 1) / bvhBinningChunkSize;
+            std::vector<T> partials(chunkCount);
+
+            math::parallelFor(chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+            {
+                for (std::size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+                {
+                    std::size_t first = begin + chunk * bvhBinningChunkSize;
+                    fn(first, std::min(first + bvhBinningChunkSize, end), partials[chunk]);
+                }
+            });
+
+            for (const T& partial : partials)
+            {
+                merge(res, partial);
+            }
+
+            return res;
+        }
+
+        // Writes the box of the primitives [begin, end) in bounds, and returns where they were split in two,
+        // the primitives being reordered, or begin if they should make a leaf
+        template<std::floating_point F>
+        inline std::size_t splitPrimitives(bvh_primitive<F>* primitives, std::size_t begin, std::size_t end, std::size_t depth, bool parallel, aabb<F>& bounds)
+        {
+            std::size_t count = end - begin;
+
+            bvh_range_bounds<F> range = reduceChunks<bvh_range_bounds<F>>(begin, end, parallel,
+                [&](std::size_t first, std::size_t last, bvh_range_bounds<F>& partial)
+                {
+                    for (std::size_t i = first; i < last; i++)
+                    {
+                        partial.boxes.grow(primitives[i].box);
+                        partial.centroids.grow(primitives[i].centroid());
+                    }
+                },
+                [](bvh_range_bounds<F>& res, const bvh_range_bounds<F>& partial)
+                {
+                    res.boxes.grow(partial.boxes);
+                    res.centroids.grow(partial.centroids);
+                });
+
+            bounds = range.boxes;
+
+            if (count <= bvhMinSplitSize) return begin;
+
+            // Fewer primitives than bins would leave most of them empty
+            std::size_t binCount = std::min(bvhBinCount, count);
+
+            F min[3] = { range.centroids.min.x, range.centroids.min.y, range.centroids.min.z };
+            F scale[3];
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                F extent = axisValue(range.centroids.max, axis) - min[axis];
+                scale[axis] = extent > static_cast<F>(0.0) ? static_cast<F>(binCount) / extent : static_cast<F>(0.0);
+            }
+
+            bool spread = scale[0] > static_cast<F>(0.0) || scale[1] > static_cast<F>(0.0) || scale[2] > static_cast<F>(0.0);
+
+            if (spread && depth < bvhMedianDepth)
+            {
+                bvh_bins<F> bins = reduceChunks<bvh_bins<F>>(begin, end, parallel,
+                    [&](std::size_t first, std::size_t last, bvh_bins<F>& partial)
+                    {
+                        for (std::size_t i = first; i < last; i++)
+                        {
+                            vec3<F> centroid = primitives[i].centroid();
+                            const aabb<F>& box = primitives[i].box;
+
+                            for (int axis = 0; axis < 3; axis++)
+                            {
+                                std::size_t bin = binIndex(axisValue(centroid, axis), min[axis], scale[axis], binCount);
+
+                                partial.bounds[axis][bin].grow(box);
+                                partial.counts[axis][bin]++;
+                            }
+                        }
+                    },
+                    [&](bvh_bins<F>& res, const bvh_bins<F>& partial)
+                    {
+                        for (int axis = 0; axis < 3; axis++)
+                        {
+                            for (std::size_t bin = 0; bin < binCount; bin++)
+                            {
+                                res.bounds[axis][bin].grow(partial.bounds[axis][bin]);
+                                res.counts[axis][bin] += partial.counts[axis][bin];
+                            }
+                        }
+                    });
+
+                // The cost of a split after the bin b : area(left) * count(left) + area(right) * count(right)
+                int bestAxis = -1;
+                std::size_t bestBin = 0;
+                double bestCost = 0.0;
+
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    if (scale[axis] == static_cast<F>(0.0)) continue;
+
+                    double rightCosts[bvhBinCount];
+                    aabb<F> right;
+                    std::size_t rightCount = 0;
+
+                    for (std::size_t bin = binCount - 1; bin > 0; bin--)
+                    {
+                        right.grow(bins.bounds[axis][bin]);
+                        rightCount += bins.counts[axis][bin];
+                        rightCosts[bin - 1] = rightCount == 0 ? -1.0 : static_cast<double>(right.surfaceArea()) * static_cast<double>(rightCount);
+                    }
+
+                    aabb<F> left;
+                    std::size_t leftCount = 0;
+
+                    for (std::size_t bin = 0; bin + 1 < binCount; bin++)
+                    {
+                        left.grow(bins.bounds[axis][bin]);
+                        leftCount += bins.counts[axis][bin];
+
+                        if (leftCount == 0 || rightCosts[bin] < 0.0) continue;
+
+                        double cost = static_cast<double>(left.surfaceArea()) * static_cast<double>(leftCount) + rightCosts[bin];
+
+                        if (bestAxis < 0 || cost < bestCost)
+                        {
+                            bestAxis = axis;
+                            bestBin = bin;
+                            bestCost = cost;
+                        }
+                    }
+                }
+
+                if (bestAxis >= 0)
+                {
+                    double area = static_cast<double>(bounds.surfaceArea());
+                    double splitCost = area > 0.0 ? bvhTraversalCost + bestCost / area : static_cast<double>(count);
+
+                    if (count <= bvhMaxLeafSize && splitCost >= static_cast<double>(count)) return begin;
+
+                    bvh_primitive<F>* mid = std::partition(primitives + begin, primitives + end, [&](const bvh_primitive<F>& primitive)
+                    {
+                        return binIndex(axisValue(primitive.centroid(), bestAxis), min[bestAxis], scale[bestAxis], binCount) <= bestBin;
+                    });
+
+                    return static_cast<std::size_t>(mid - primitives);
+                }
+            }
+
+            if (count <= bvhMaxLeafSize) return begin;
+
+            // The centroids are all at the same place, or the tree is too deep : the primitives are split in half
+            // along the largest axis
+            vec3<F> extent = range.centroids.max - range.centroids.min;
+            int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+            std::size_t mid = begin + count / 2;
+
+            std::nth_element(primitives + begin, primitives + mid, primitives + end, [&](const bvh_primitive<F>& a, const bvh_primitive<F>& b)
+            {
+                return axisValue(a.centroid(), axis) < axisValue(b.centroid(), axis);
+            });
+
+            return mid;
+        }
+
+        // Builds the nodes of tasks into nodes, depth first so that the children always come after their parent.
+        // When subtreeTasks is not null, the tasks of at most bvhSubtreeSize primitives are moved to it instead
+        template<std::floating_point F, typename Nodes>
+        inline void buildNodes(bvh_primitive<F>* primitives, Nodes& nodes,
+                               std::vector<bvh_build_task>& tasks, bool parallel, std::vector<bvh_build_task>* subtreeTasks)
+        {
+            while (!tasks.empty())
+            {
+                bvh_build_task task = tasks.back();
+                tasks.pop_back();
+
+                if (subtreeTasks != nullptr && task.end - task.begin <= bvhSubtreeSize)
+                {
+                    subtreeTasks->push_back(task);
+                    continue;
+                }
+
+                aabb<F> bounds;
+                std::size_t mid = splitPrimitives(primitives, task.begin, task.end, task.depth, parallel, bounds);
+
+                if (mid == task.begin)
+                {
+                    nodes[task.node] = bvhNode(bounds, task.begin, task.end - task.begin);
+                    continue;
+                }
+
+                std::uint32_t first = static_cast<std::uint32_t>(nodes.size());
+                nodes.resize(nodes.size() + 2);
+                nodes[task.node] = bvhNode(bounds, first, 0);
+
+                tasks.push_back({ first + 1, mid, task.end, task.depth + 1 });
+                tasks.push_back({ first, task.begin, mid, task.depth + 1 });
+            }
+        }
+    }
+
+    template<std::floating_point F>
+    inline bvh<F>::bvh()
+    {
+    }
+
+    template<std::floating_point F>
+    inline void bvh<F>::build(std::span<const aabb<F>> boxes)
+    {
+        clear();
+
+        std::size_t count = boxes.size();
+        if (count == 0) return;
+
+        std::vector<detail::bvh_primitive<F>> primitives(count);
+
+        math::parallelFor(count, detail::bvhBinningChunkSize, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                primitives[i] = { boxes[i], static_cast<index>(i) };
+            }
+        });
+
+        // The top of the tree, each node binned across the threads
+        std::vector<detail::bvh_build_task> tasks = { { 0, 0, count, 0 } };
+        std::vector<detail::bvh_build_task> subtreeTasks;
+
+        treeNodes.resize(1);
+        detail::buildNodes(primitives.data(), treeNodes, tasks, true, &subtreeTasks);
+
+        topNodeCount = static_cast<index>(treeNodes.size());
+
+        // The subtrees, each one built by a single thread in its own array
+        std::vector<std::vector<node>> subtreeNodes(subtreeTasks.size());
+
+        math::parallelFor(subtreeTasks.size(), 1, [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<detail::bvh_build_task> localTasks;
+
+            for (std::size_t s = begin; s < end; s++)
+            {
+                const detail::bvh_build_task& task = subtreeTasks[s];
+
+                localTasks.push_back({ 0, task.begin, task.end, task.depth });
+                subtreeNodes[s].resize(1);
+
+                detail::buildNodes(primitives.data(), subtreeNodes[s], localTasks, false, nullptr);
+            }
+        });
+
+        // The root of a subtree replaces its task, and the other nodes are appended, the children moving with them
+        for (std::size_t s = 0; s < subtreeTasks.size(); s++)
+        {
+            const std::vector<node>& local = subtreeNodes[s];
+            index first = static_cast<index>(treeNodes.size());
+            index offset = first - 1;
+
+            auto moved = [&](node n)
+            {
+                if (!n.isLeaf()) n.first += offset;
+                return n;
+            };
+
+            treeNodes[subtreeTasks[s].node] = moved(local[0]);
+
+            for (std::size_t k = 1; k < local.size(); k++)
+            {
+                treeNodes.push_back(moved(local[k]));
+            }
+
+            subtrees.push_back({ subtreeTasks[s].node, first, static_cast<index>(treeNodes.size()) });
+        }
+
+        primitiveIndices.resize(count);
+        leafBoxes.resize(count);
+
+        math::parallelFor(count, detail::bvhBinningChunkSize, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                primitiveIndices[i] = primitives[i].index;
+                leafBoxes[i] = primitives[i].box;
+            }
+        });
+    }
+
+    template<std::floating_point F>
+    inline void bvh<F>::refit(std::span<const aabb<F>> boxes)
+    {
+        std::size_t count = primitiveIndices.size();
+
+        math::parallelFor(count, detail::bvhBinningChunkSize, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; i++) leafBoxes[i] = boxes[primitiveIndices[i]];
+        });
+
+        auto refitNode = [&](node& n)
+        {
+            aabb<F> box;
+
+            if (n.isLeaf())
+            {
+                for (index i = n.first; i < n.first + n.count; i++) box.grow(leafBoxes[i]);
+            }
+            else
+            {
+                const node& left = treeNodes[n.first];
+                const node& right = treeNodes[n.first + 1];
+
+                box = aabb<F>::merge(aabb<F>(left.min, left.max), aabb<F>(right.min, right.max));
+            }
+
+            n.min = box.min;
+            n.max = box.max;
+        };
+
+        // The children come after their parent : going backwards refits them first
+        math::parallelFor(subtrees.size(), 1, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t s = begin; s < end; s++)
+            {
+                for (index k = subtrees[s].last; k-- > subtrees[s].first;) refitNode(treeNodes[k]);
+            }
+        });
+
+        for (index k = topNodeCount; k-- > 0;) refitNode(treeNodes[k]);
+    }
+
+    template<std::floating_point F>
+    inline void bvh<F>::clear()
+    {
+        treeNodes.clear();
+        primitiveIndices.clear();
+        leafBoxes.clear();
+        subtrees.clear();
+        topNodeCount = 0;
+    }
+
+    template<std::floating_point F>
+    inline bool bvh<F>::empty() const
+    {
+        return treeNodes.empty();
+    }
+
+    template<std::floating_point F>
+    inline aabb<F> bvh<F>::bounds() const
+    {
+        return empty() ? aabb<F>() : aabb<F>(treeNodes[0].min, treeNodes[0].max);
+    }
+
+    template<std::floating_point F>
+    inline std::span<const typename bvh<F>::node> bvh<F>::nodes() const
+    {
+        return std::span<const node>(treeNodes.data(), treeNodes.size());
+    }
+
+    template<std::floating_point F>
+    inline std::span<const typename bvh<F>::index> bvh<F>::primitives() const
+    {
+        return primitiveIndices;
+    }
+
+    template<std::floating_point F>
+    template<typename Fn>
+    inline void bvh<F>::queryOverlaps(const aabb<F>& box, Fn&& fn) const
+    {
+        if (empty()) return;
+
+        index stack[detail::bvhStackSize];
+        std::size_t size = 0;
+        stack[size++] = 0;
+
+        while (size > 0)
+        {
+            const node& n = treeNodes[stack[--size]];
+
+            if (!box.intersects(aabb<F>(n.min, n.max))) continue;
+
+            if (n.isLeaf())
+            {
+                for (index i = n.first; i < n.first + n.count; i++)
+                {
+                    if (box.intersects(leafBoxes[i])) fn(primitiveIndices[i]);
+                }
+            }
+            else
+            {
+                stack[size++] = n.first + 1;
+                stack[size++] = n.first;
+            }
+        }
+    }
+
+    namespace detail
+    {
+        // Returns true if the ray enters the box before maxDistance, entry being where it does (0.0 if it starts in it)
+        template<std::floating_point F>
+        inline bool rayEntersBox(const vec3<F>& origin, const vec3<F>& inverseDirection, const vec3<F>& min, const vec3<F>& max,
+                                 F maxDistance, F& entry)
+        {
+            F x1 = (min.x - origin.x) * inverseDirection.x, x2 = (max.x - origin.x) * inverseDirection.x;
+            F y1 = (min.y - origin.y) * inverseDirection.y, y2 = (max.y - origin.y) * inverseDirection.y;
+            F z1 = (min.z - origin.z) * inverseDirection.z, z2 = (max.z - origin.z) * inverseDirection.z;
+
+            F enter = math::max(math::max(math::min(x1, x2), math::min(y1, y2)), math::max(math::min(z1, z2), static_cast<F>(0.0)));
+            F exit = math::min(math::min(math::max(x1, x2), math::max(y1, y2)), math::min(math::max(z1, z2), maxDistance));
+
+            entry = enter;
+
+            return enter <= exit;
+        }
+    }
+
+    template<std::floating_point F>
+    template<typename Hit>
+    inline F bvh<F>::raycast(const vec3<F>& origin, const vec3<F>& direction, F maxDistance, Hit&& hit) const
+    {
+        if (empty()) return maxDistance;
+
+        // A component of 0.0 gives an infinite inverse, the slabs of that axis then containing the whole ray or nothing
+        vec3<F> inverseDirection(static_cast<F>(1.0) / direction.x, static_cast<F>(1.0) / direction.y, static_cast<F>(1.0) / direction.z);
+
+        struct entry
+        {
+            index node;
+            F distance;
+        };
+
+        entry stack[detail::bvhStackSize];
+        std::size_t size = 0;
+
+        F distance;
+        if (!detail::rayEntersBox(origin, inverseDirection, treeNodes[0].min, treeNodes[0].max, maxDistance, distance)) return maxDistance;
+
+        stack[size++] = { 0, distance };
+
+        while (size > 0)
+        {
+            entry e = stack[--size];
+
+            // A closer hit was found since the node was pushed
+            if (e.distance > maxDistance) continue;
+
+            const node& n = treeNodes[e.node];
+
+            if (n.isLeaf())
+            {
+                for (index i = n.first; i < n.first + n.count; i++)
+                {
+                    if (detail::rayEntersBox(origin, inverseDirection, leafBoxes[i].min, leafBoxes[i].max, maxDistance, distance))
+                    {
+                        maxDistance = math::min(maxDistance, static_cast<F>(hit(primitiveIndices[i], maxDistance)));
+                    }
+                }
+
+                continue;
+            }
+
+            F leftDistance;
+            F rightDistance;
+            bool left = detail::rayEntersBox(origin, inverseDirection, treeNodes[n.first].min, treeNodes[n.first].max, maxDistance, leftDistance);
+            bool right = detail::rayEntersBox(origin, inverseDirection, treeNodes[n.first + 1].min, treeNodes[n.first + 1].max, maxDistance, rightDistance);
+
+            // The nearest child is visited first
+            if (left && right)
+            {
+                if (leftDistance <= rightDistance)
+                {
+                    stack[size++] = { n.first + 1, rightDistance };
+                    stack[size++] = { n.first, leftDistance };
+                }
+                else
+                {
+                    stack[size++] = { n.first, leftDistance };
+                    stack[size++] = { n.first + 1, rightDistance };
+                }
+            }
+            else if (left)
+            {
+                stack[size++] = { n.first, leftDistance };
+            }
+            else if (right)
+            {
+                stack[size++] = { n.first + 1, rightDistance };
+            }
+        }
+
+        return maxDistance;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Math\Matrices\Matrix4x4.hpp"
+#include "Math\Vectors\Vector3.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+#include "Math\Vectors\Vector4.hpp"
+
+namespace math
+{
+    // The depth range of the clip space a projection maps to
+    enum class depth_range
+    {
+        // OpenGL : -w <= z <= w
+        minusOneToOne,
+        // Direct3D, Vulkan, Metal : 0 <= z <= w
+        zeroToOne
+    };
+
+    // A struct used to represent the six planes of a view frustum, extracted from a view-projection matrix.
+    // Each plane is stored as (normal.x, normal.y, normal.z, distance), the normal having a length of 1.0 and
+    // pointing inside the frustum : a point p is inside a plane when dot(normal, p) + distance >= 0.0.
+    // The tests are conservative : an object near a corner of the frustum, outside of it but not fully behind
+    // any plane, is kept.
+    //
+    // The bulk tests read the centers (and extents) of the objects from vec3_soa, test a whole SIMD pack of
+    // objects against every plane, and write the indices of the visible ones next to each other. The objects
+    // are split across the threads of math::thread_pool.
+    template<std::floating_point F>
+    struct frustum
+    {
+    public:
+        // left, right, bottom, top, near, far
+        vec4<F> planes[6];
+
+    public:
+        // Constructor that returns a frustum that contains everything
+        constexpr frustum();
+        // Constructor that extracts the planes of viewProjection, a projection matrix times a view matrix
+        explicit constexpr frustum(const mat4<F>& viewProjection, depth_range depth = depth_range::minusOneToOne);
+
+        constexpr bool containsPoint(const vec3<F>& point) const;
+        // Returns true if the sphere is inside the frustum or crosses it
+        constexpr bool intersectsSphere(const vec3<F>& center, F radius) const;
+        // Returns true if the axis-aligned box, of half-size extents, is inside the frustum or crosses it
+        constexpr bool intersectsAabb(const vec3<F>& center, const vec3<F>& extents) const;
+
+        // Writes the index of every sphere that intersects the frustum in visible, in increasing order, and
+        // returns their number. radii has centers.size() values, and visible must hold centers.size() indices
+        static std::size_t cullSpheres(const frustum& view, const vec3_soa<F>& centers, std::span<const F> radii, std::span<std::uint32_t> visible);
+        // Same as cullSpheres, for axis-aligned boxes of half-size extents
+        static std::size_t cullAabbs(const frustum& view, const vec3_soa<F>& centers, const vec3_soa<F>& extents, std::span<std::uint32_t> visible);
+    };
+
+    namespace detail
+    {
+        // The number of objects culled at once by a thread, a multiple of every pack width
+        inline constexpr std::size_t cullingChunkSize = 4096;
+    }
+}
+
+#include "Math\Geometry\Frustum.inl"
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    inline constexpr frustum<F>::frustum() :
+        planes{ vec4<F>(0, 0, 0, 1), vec4<F>(0, 0, 0, 1), vec4<F>(0, 0, 0, 1), vec4<F>(0, 0, 0, 1), vec4<F>(0, 0, 0, 1), vec4<F>(0, 0, 0, 1) }
+    {
+    }
+
+    template<std::floating_point F>
+    inline constexpr frustum<F>::frustum(const mat4<F>& viewProjection, depth_range depth) : frustum()
+    {
+        // Gribb and Hartmann : a point is inside the clip volume when -w <= x, y, z <= w, each
+        // of these inequalities being a plane made of two rows of the matrix
+        auto row = [&](int i) { return vec4<F>(viewProjection.columns[0][i], viewProjection.columns[1][i], viewProjection.columns[2][i], viewProjection.columns[3][i]); };
+
+        vec4<F> x = row(0), y = row(1), z = row(2), w = row(3);
+
+        planes[0] = vec4<F>(w.x + x.x, w.y + x.y, w.z + x.z, w.w + x.w);
+        planes[1] = vec4<F>(w.x - x.x, w.y - x.y, w.z - x.z, w.w - x.w);
+        planes[2] = vec4<F>(w.x + y.x, w.y + y.y, w.z + y.z, w.w + y.w);
+        planes[3] = vec4<F>(w.x - y.x, w.y - y.y, w.z - y.z, w.w - y.w);
+        planes[4] = depth == depth_range::zeroToOne ? z : vec4<F>(w.x + z.x, w.y + z.y, w.z + z.z, w.w + z.w);
+        planes[5] = vec4<F>(w.x - z.x, w.y - z.y, w.z - z.z, w.w - z.w);
+
+        // The distances become euclidean, which the sphere and box tests need
+        for (vec4<F>& plane : planes)
+        {
+            F length = math::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+
+            if (length > static_cast<F>(0.0))
+            {
+                plane = vec4<F>(plane.x / length, plane.y / length, plane.z / length, plane.w / length);
+            }
+        }
+    }
+
+    template<std::floating_point F>
+    inline constexpr bool frustum<F>::containsPoint(const vec3<F>& point) const
+    {
+        return intersectsSphere(point, static_cast<F>(0.0));
+    }
+
+    template<std::floating_point F>
+    inline constexpr bool frustum<F>::intersectsSphere(const vec3<F>& center, F radius) const
+    {
+        for (const vec4<F>& plane : planes)
+        {
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) return false;
+        }
+
+        return true;
+    }
+
+    template<std::floating_point F>
+    inline constexpr bool frustum<F>::intersectsAabb(const vec3<F>& center, const vec3<F>& extents) const
+    {
+        for (const vec4<F>& plane : planes)
+        {
+            // The half-size of the box along the normal of the plane
+            F radius = math::abs(plane.x) * extents.x + math::abs(plane.y) * extents.y + math::abs(plane.z) * extents.z;
+
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) return false;
+        }
+
+        return true;
+    }
+
+    namespace detail
+    {
+        // Runs test(P{}, i) over every pack of [begin, end), and writes the indices of the lanes it keeps
+        // next to each other from out. Every index is written, but the count only moves forward on the kept
+        // ones : no branch depends on the visibility, which is unpredictable
+        template<std::floating_point F, typename Test>
+        inline std::size_t compactVisible(std::size_t begin, std::size_t end, std::uint32_t* out, Test&& test)
+        {
+            std::size_t count = 0;
+
+            simd::forEachPack<F>(begin, end, [&](auto p, std::size_t i)
+            {
+                using P = decltype(p);
+
+                unsigned bits = simd::moveMask(test(p, i));
+
+                for (std::size_t lane = 0; lane < P::width; lane++)
+                {
+                    out[count] = static_cast<std::uint32_t>(i + lane);
+                    count += (bits >> lane) & 1u;
+                }
+            });
+
+            return count;
+        }
+
+        // Culls [0, count) by chunks of cullingChunkSize across the threads, each chunk writing its indices at
+        // its own place in visible, then moves them next to each other
+        template<std::floating_point F, typename Test>
+        inline std::size_t cullObjects(std::size_t count, std::uint32_t* visible, const Test& test)
+        {
+            std::size_t chunkCount = (count + cullingChunkSize - 1) / cullingChunkSize;
+            std::vector<std::size_t> visibleCounts(chunkCount);
+
+            math::parallelFor(chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+            {
+                for (std::size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+                {
+                    std::size_t begin = chunk * cullingChunkSize;
+                    std::size_t end = std::min(begin + cullingChunkSize, count);
+
+                    visibleCounts[chunk] = compactVisible<F>(begin, end, visible + begin, test);
+                }
+            });
+
+            std::size_t total = 0;
+
+            for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+            {
+                std::size_t begin = chunk * cullingChunkSize;
+
+                if (total != begin) std::memmove(visible + total, visible + begin, visibleCounts[chunk] * sizeof(std::uint32_t));
+
+                total += visibleCounts[chunk];
+            }
+
+            return total;
+        }
+    }
+
+    template<std::floating_point F>
+    inline std::size_t frustum<F>::cullSpheres(const frustum& view, const vec3_soa<F>& centers, std::span<const F> radii, std::span<std::uint32_t> visible)
+    {
+        const F* x = centers.x.data();
+        const F* y = centers.y.data();
+        const F* z = centers.z.data();
+        const F* r = radii.data();
+        const vec4<F>* planes = view.planes;
+
+        return detail::cullObjects<F>(centers.size(), visible.data(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P cx = P::load(x + i), cy = P::load(y + i), cz = P::load(z + i);
+            P negRadius = -P::loadu(r + i);
+
+            P inside = P::zero();
+
+            for (int plane = 0; plane < 6; plane++)
+            {
+                P distance = simd::madd(P::broadcast(planes[plane].x), cx,
+                             simd::madd(P::broadcast(planes[plane].y), cy,
+                             simd::madd(P::broadcast(planes[plane].z), cz, P::broadcast(planes[plane].w))));
+
+                P insidePlane = simd::cmpGe(distance, negRadius);
+                inside = plane == 0 ? insidePlane : simd::maskAnd(inside, insidePlane);
+            }
+
+            return inside;
+        });
+    }
+
+    template<std::floating_point F>
+    inline std::size_t frustum<F>::cullAabbs(const frustum& view, const vec3_soa<F>& centers, const vec3_soa<F>& extents, std::span<std::uint32_t> visible)
+    {
+        const F* x = centers.x.data();
+        const F* y = centers.y.data();
+        const F* z = centers.z.data();
+        const F* ex = extents.x.data();
+        const F* ey = extents.y.data();
+        const F* ez = extents.z.data();
+        const vec4<F>* planes = view.planes;
+
+        return detail::cullObjects<F>(centers.size(), visible.data(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P cx = P::load(x + i), cy = P::load(y + i), cz = P::load(z + i);
+            P hx = P::load(ex + i), hy = P::load(ey + i), hz = P::load(ez + i);
+
+            P inside = P::zero();
+
+            for (int plane = 0; plane < 6; plane++)
+            {
+                P nx = P::broadcast(planes[plane].x), ny = P::broadcast(planes[plane].y), nz = P::broadcast(planes[plane].z);
+
+                P distance = simd::madd(nx, cx, simd::madd(ny, cy, simd::madd(nz, cz, P::broadcast(planes[plane].w))));
+                // The half-size of the boxes along the normal of the plane
+                P radius = simd::madd(simd::abs(nx), hx, simd::madd(simd::abs(ny), hy, simd::abs(nz) * hz));
+
+                P insidePlane = simd::cmpGe(distance, -radius);
+                inside = plane == 0 ? insidePlane : simd::maskAnd(inside, insidePlane);
+            }
+
+            return inside;
+        });
+    }
+}
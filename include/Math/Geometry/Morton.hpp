@@ -0,0 +1,38 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Math\Geometry\Aabb.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+
+namespace math
+{
+    // Morton codes (or Z-order) : the bits of the x, y and z cells of a point interleaved into one integer,
+    // bit i of x going to bit 3i, bit i of y to bit 3i + 1 and bit i of z to bit 3i + 2. Sorting points by
+    // their code orders them along a curve that keeps the points close in space close in memory.
+
+    // Returns the code of the cell (x, y, z), each coordinate keeping its 10 low bits
+    constexpr std::uint32_t encodeMorton30(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+    // Returns the code of the cell (x, y, z), each coordinate keeping its 21 low bits
+    constexpr std::uint64_t encodeMorton63(std::uint64_t x, std::uint64_t y, std::uint64_t z);
+
+    // Writes the 30 bit code of every point in codes, bounds being split in 1024 cells along each axis, the
+    // points outside of it going to its nearest cell. codes must hold at least points.size() values.
+    // The points are quantized a whole SIMD pack at a time, and split across the threads of math::thread_pool
+    template<std::floating_point F>
+    void mortonCodes(const vec3_soa<F>& points, const aabb<F>& bounds, std::span<std::uint32_t> codes);
+    // Same as the 30 bit mortonCodes, with 2097152 cells along each axis
+    template<std::floating_point F>
+    void mortonCodes(const vec3_soa<F>& points, const aabb<F>& bounds, std::span<std::uint64_t> codes);
+
+    namespace detail
+    {
+        // The number of points a thread encodes at once
+        inline constexpr std::size_t mortonChunkSize = 4096;
+    }
+}
+
+#include "Math\Geometry\Morton.inl"
@@ -0,0 +1,194 @@
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Math\Simd\Pack.hpp"
+#include "Math\Simd\Simd.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    namespace detail
+    {
+        // Moves bit i of the 10 low bits of v to bit 3i
+        constexpr std::uint32_t spreadBits10(std::uint32_t v)
+        {
+            v &= 0x3FFu;
+            v = (v | (v << 16)) & 0x030000FFu;
+            v = (v | (v << 8)) & 0x0300F00Fu;
+            v = (v | (v << 4)) & 0x030C30C3u;
+            v = (v | (v << 2)) & 0x09249249u;
+
+            return v;
+        }
+
+        // Moves bit i of the 21 low bits of v to bit 3i
+        constexpr std::uint64_t spreadBits21(std::uint64_t v)
+        {
+            v &= 0x1FFFFFull;
+            v = (v | (v << 32)) & 0x001F00000000FFFFull;
+            v = (v | (v << 16)) & 0x001F0000FF0000FFull;
+            v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+            v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+            v = (v | (v << 2)) & 0x1249249249249249ull;
+
+            return v;
+        }
+    }
+
+    constexpr std::uint32_t encodeMorton30(std::uint32_t x, std::uint32_t y, std::uint32_t z)
+    {
+        return detail::spreadBits10(x) | (detail::spreadBits10(y) << 1) | (detail::spreadBits10(z) << 2);
+    }
+
+    constexpr std::uint64_t encodeMorton63(std::uint64_t x, std::uint64_t y, std::uint64_t z)
+    {
+        return detail::spreadBits21(x) | (detail::spreadBits21(y) << 1) | (detail::spreadBits21(z) << 2);
+    }
+
+    namespace detail
+    {
+        // Writes the codes of the cells x, y and z, whole numbers held by a pack. Any pack goes through the
+        // scalar encoding, lane by lane, and the AVX2 overloads below interleave every lane at once
+        template<typename P, typename Code>
+        inline void storeMortonCodes(P x, P y, P z, Code* out)
+        {
+            for (std::size_t lane = 0; lane < P::width; lane++)
+            {
+                if constexpr (sizeof(Code) == 4)
+                {
+                    out[lane] = encodeMorton30(static_cast<std::uint32_t>(x.lane(lane)), static_cast<std::uint32_t>(y.lane(lane)), static_cast<std::uint32_t>(z.lane(lane)));
+                }
+                else
+                {
+                    out[lane] = encodeMorton63(static_cast<std::uint64_t>(x.lane(lane)), static_cast<std::uint64_t>(y.lane(lane)), static_cast<std::uint64_t>(z.lane(lane)));
+                }
+            }
+        }
+
+    #if defined(MATH_SIMD_AVX2)
+
+        inline __m256i spreadBits10(__m256i v)
+        {
+            v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi32(v, 16)), _mm256_set1_epi32(0x030000FF));
+            v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi32(v, 8)), _mm256_set1_epi32(0x0300F00F));
+            v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi32(v, 4)), _mm256_set1_epi32(0x030C30C3));
+            v = _mm256_and_si256(_mm256_or_si256(v, _mm256_slli_epi32(v, 2)), _mm256_set1_epi32(0x09249249));
+
+            return v;
+        }
+
+        inline __m128i spreadBits10(__m128i v)
+        {
+            v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 16)), _mm_set1_epi32(0x030000FF));
+            v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 8)), _mm_set1_epi32(0x0300F00F));
+            v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 4)), _mm_set1_epi32(0x030C30C3));
+            v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 2)), _mm_set1_epi32(0x09249249));
+
+            return v;
+        }
+
+        // Spreads 4 values of 32 bits into 4 lanes of 64 bits
+        inline __m256i spreadBits21(__m128i v)
+        {
+            __m256i wide = _mm256_cvtepu32_epi64(v);
+
+            wide = _mm256_and_si256(_mm256_or_si256(wide, _mm256_slli_epi64(wide, 32)), _mm256_set1_epi64x(0x001F00000000FFFFll));
+            wide = _mm256_and_si256(_mm256_or_si256(wide, _mm256_slli_epi64(wide, 16)), _mm256_set1_epi64x(0x001F0000FF0000FFll));
+            wide = _mm256_and_si256(_mm256_or_si256(wide, _mm256_slli_epi64(wide, 8)), _mm256_set1_epi64x(0x100F00F00F00F00Fll));
+            wide = _mm256_and_si256(_mm256_or_si256(wide, _mm256_slli_epi64(wide, 4)), _mm256_set1_epi64x(0x10C30C30C30C30C3ll));
+            wide = _mm256_and_si256(_mm256_or_si256(wide, _mm256_slli_epi64(wide, 2)), _mm256_set1_epi64x(0x1249249249249249ll));
+
+            return wide;
+        }
+
+        inline __m256i interleave63(__m128i x, __m128i y, __m128i z)
+        {
+            return _mm256_or_si256(spreadBits21(x), _mm256_or_si256(_mm256_slli_epi64(spreadBits21(y), 1), _mm256_slli_epi64(spreadBits21(z), 2)));
+        }
+
+        inline void storeMortonCodes(simd::avx_float_pack x, simd::avx_float_pack y, simd::avx_float_pack z, std::uint32_t* out)
+        {
+            __m256i code = _mm256_or_si256(spreadBits10(_mm256_cvttps_epi32(x.v)),
+                           _mm256_or_si256(_mm256_slli_epi32(spreadBits10(_mm256_cvttps_epi32(y.v)), 1),
+                                           _mm256_slli_epi32(spreadBits10(_mm256_cvttps_epi32(z.v)), 2)));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), code);
+        }
+
+        inline void storeMortonCodes(simd::avx_float_pack x, simd::avx_float_pack y, simd::avx_float_pack z, std::uint64_t* out)
+        {
+            __m256i xi = _mm256_cvttps_epi32(x.v), yi = _mm256_cvttps_epi32(y.v), zi = _mm256_cvttps_epi32(z.v);
+
+            __m256i low = interleave63(_mm256_castsi256_si128(xi), _mm256_castsi256_si128(yi), _mm256_castsi256_si128(zi));
+            __m256i high = interleave63(_mm256_extracti128_si256(xi, 1), _mm256_extracti128_si256(yi, 1), _mm256_extracti128_si256(zi, 1));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4), high);
+        }
+
+        inline void storeMortonCodes(simd::avx_double_pack x, simd::avx_double_pack y, simd::avx_double_pack z, std::uint32_t* out)
+        {
+            __m128i code = _mm_or_si128(spreadBits10(_mm256_cvttpd_epi32(x.v)),
+                           _mm_or_si128(_mm_slli_epi32(spreadBits10(_mm256_cvttpd_epi32(y.v)), 1),
+                                        _mm_slli_epi32(spreadBits10(_mm256_cvttpd_epi32(z.v)), 2)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), code);
+        }
+
+        inline void storeMortonCodes(simd::avx_double_pack x, simd::avx_double_pack y, simd::avx_double_pack z, std::uint64_t* out)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), interleave63(_mm256_cvttpd_epi32(x.v), _mm256_cvttpd_epi32(y.v), _mm256_cvttpd_epi32(z.v)));
+        }
+
+    #endif
+
+        // Quantizes the points on cellCount cells per axis, then interleaves the cells
+        template<std::floating_point F, typename Code>
+        inline void computeMortonCodes(const vec3_soa<F>& points, const aabb<F>& bounds, Code* codes, F cellCount)
+        {
+            const F* px = points.x.data();
+            const F* py = points.y.data();
+            const F* pz = points.z.data();
+
+            vec3<F> size = bounds.max - bounds.min;
+            // A flat box puts every point in the first cell of that axis
+            auto cellScale = [&](F extent) { return extent > static_cast<F>(0.0) ? cellCount / extent : static_cast<F>(0.0); };
+            vec3<F> scale(cellScale(size.x), cellScale(size.y), cellScale(size.z));
+
+            math::parallelFor(points.size(), mortonChunkSize, [&](std::size_t begin, std::size_t end)
+            {
+                simd::forEachPack<F>(begin, end, [&](auto p, std::size_t i)
+                {
+                    using P = decltype(p);
+
+                    P zero = P::zero();
+                    P lastCell = P::broadcast(cellCount - static_cast<F>(1.0));
+
+                    // max before min sends NaN to the first cell
+                    auto quantize = [&](P value, F min, F axisScale)
+                    {
+                        return simd::min(simd::max((value - P::broadcast(min)) * P::broadcast(axisScale), zero), lastCell);
+                    };
+
+                    storeMortonCodes(quantize(P::loadu(px + i), bounds.min.x, scale.x),
+                                     quantize(P::loadu(py + i), bounds.min.y, scale.y),
+                                     quantize(P::loadu(pz + i), bounds.min.z, scale.z), codes + i);
+                });
+            });
+        }
+    }
+
+    template<std::floating_point F>
+    inline void mortonCodes(const vec3_soa<F>& points, const aabb<F>& bounds, std::span<std::uint32_t> codes)
+    {
+        detail::computeMortonCodes(points, bounds, codes.data(), static_cast<F>(1024.0));
+    }
+
+    template<std::floating_point F>
+    inline void mortonCodes(const vec3_soa<F>& points, const aabb<F>& bounds, std::span<std::uint64_t> codes)
+    {
+        detail::computeMortonCodes(points, bounds, codes.data(), static_cast<F>(2097152.0));
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Geometry\Aabb.hpp"
+#include "Math\Memory\AlignedAllocator.hpp"
+#include "Math\Vectors\Vector3.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+
+namespace math
+{
+    // A struct used to store many rays as a structure of arrays, for hitscan and line of sight queries.
+    // A ray goes from its origin along its direction, up to maxDistance : the distances are measured in
+    // lengths of the direction, which does not have to be normalized.
+    //
+    // The static kernels load a whole SIMD pack of rays (8 for float and 4 for double with AVX) and test
+    // them against one triangle or box at a time, its values being broadcast to every lane. The rays are
+    // split across the threads of math::thread_pool.
+    // A ray that only grazes an edge or a face may hit or miss it : the tests are not watertight.
+    template<std::floating_point F>
+    struct ray_soa
+    {
+    public:
+        using array = std::vector<F, aligned_allocator<F>>;
+
+        // The index written for the rays that hit nothing
+        static constexpr std::uint32_t noHit = 0xFFFFFFFFu;
+
+        vec3_soa<F> origins;
+        vec3_soa<F> directions;
+        array maxDistances;
+
+    public:
+        // Constructor that returns an empty ray_soa
+        ray_soa();
+        // Constructor that returns count rays, all starting at (0.0, 0.0, 0.0) with a direction of
+        // (0.0, 0.0, 0.0) and a maxDistance of 0.0
+        explicit ray_soa(std::size_t count);
+
+        std::size_t size() const;
+        bool empty() const;
+
+        void resize(std::size_t count);
+        void reserve(std::size_t count);
+        void clear();
+
+        void pushBack(const vec3<F>& origin, const vec3<F>& direction, F maxDistance);
+
+        // Finds the closest triangle hit by every ray, Möller-Trumbore : vertices holds three vertices per
+        // triangle. Writes the distance of the hit in distances[i] and the index of the triangle in
+        // triangles[i], or maxDistances[i] and noHit if the ray hits nothing before maxDistances[i].
+        // Both faces of a triangle are hit. distances and triangles must hold at least size() values
+        static void intersectTriangles(const ray_soa& rays, std::span<const vec3<F>> vertices, std::span<F> distances, std::span<std::uint32_t> triangles);
+        // Same as intersectTriangles for boxes, distances[i] being where the ray enters the box, or 0.0 if
+        // it starts inside it
+        static void intersectAabbs(const ray_soa& rays, std::span<const aabb<F>> boxes, std::span<F> distances, std::span<std::uint32_t> hits);
+
+        // Writes the index of every ray that hits no triangle before its maxDistance in visible, in increasing
+        // order, and returns their number. visible must hold at least size() indices
+        static std::size_t unoccluded(const ray_soa& rays, std::span<const vec3<F>> vertices, std::span<std::uint32_t> visible);
+    };
+
+    namespace detail
+    {
+        // The number of rays cast at once by a thread, a multiple of every pack width
+        inline constexpr std::size_t rayChunkSize = 1024;
+    }
+}
+
+#include "Math\Geometry\RaySoA.inl"
@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Geometry\Frustum.hpp"
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+
+    #pragma region Container
+
+    template<std::floating_point F>
+    inline ray_soa<F>::ray_soa()
+    {
+    }
+
+    template<std::floating_point F>
+    inline ray_soa<F>::ray_soa(std::size_t count)
+    {
+        resize(count);
+    }
+
+    template<std::floating_point F>
+    inline std::size_t ray_soa<F>::size() const
+    {
+        return maxDistances.size();
+    }
+
+    template<std::floating_point F>
+    inline bool ray_soa<F>::empty() const
+    {
+        return maxDistances.empty();
+    }
+
+    template<std::floating_point F>
+    inline void ray_soa<F>::resize(std::size_t count)
+    {
+        origins.resize(count);
+        directions.resize(count);
+        maxDistances.resize(count, static_cast<F>(0.0));
+    }
+
+    template<std::floating_point F>
+    inline void ray_soa<F>::reserve(std::size_t count)
+    {
+        origins.reserve(count);
+        directions.reserve(count);
+        maxDistances.reserve(count);
+    }
+
+    template<std::floating_point F>
+    inline void ray_soa<F>::clear()
+    {
+        origins.clear();
+        directions.clear();
+        maxDistances.clear();
+    }
+
+    template<std::floating_point F>
+    inline void ray_soa<F>::pushBack(const vec3<F>& origin, const vec3<F>& direction, F maxDistance)
+    {
+        origins.pushBack(origin);
+        directions.pushBack(direction);
+        maxDistances.push_back(maxDistance);
+    }
+
+    #pragma endregion Container
+
+    #pragma region Kernels
+
+    namespace detail
+    {
+        // The x, y and z of a pack of vectors
+        template<typename P>
+        struct packed_vec3
+        {
+            P x, y, z;
+        };
+
+        // A triangle as its first vertex and its two edges from it, computed once per call instead of once per pack
+        template<std::floating_point F>
+        struct ray_triangle
+        {
+            vec3<F> v0;
+            vec3<F> e1;
+            vec3<F> e2;
+        };
+
+        template<std::floating_point F>
+        inline std::vector<ray_triangle<F>> rayTriangles(std::span<const vec3<F>> vertices)
+        {
+            std::vector<ray_triangle<F>> triangles(vertices.size() / 3);
+
+            for (std::size_t i = 0; i < triangles.size(); i++)
+            {
+                const vec3<F>& v0 = vertices[3 * i];
+
+                triangles[i] = { v0, vertices[3 * i + 1] - v0, vertices[3 * i + 2] - v0 };
+            }
+
+            return triangles;
+        }
+
+        template<typename P, std::floating_point F>
+        inline packed_vec3<P> loadPacked(const vec3_soa<F>& vecs, std::size_t i)
+        {
+            return { P::load(vecs.x.data() + i), P::load(vecs.y.data() + i), P::load(vecs.z.data() + i) };
+        }
+
+        // Möller-Trumbore : returns the mask of the rays that hit the triangle between 0.0 and maxDistance,
+        // and the distance of the hit in distance. A ray parallel to the triangle gives an infinite or NaN
+        // determinant inverse, that fails the comparisons
+        template<typename P, std::floating_point F>
+        inline P intersectTrianglePacket(const packed_vec3<P>& origin, const packed_vec3<P>& direction, const ray_triangle<F>& triangle,
+                                         P maxDistance, P& distance)
+        {
+            P e1x = P::broadcast(triangle.e1.x), e1y = P::broadcast(triangle.e1.y), e1z = P::broadcast(triangle.e1.z);
+            P e2x = P::broadcast(triangle.e2.x), e2y = P::broadcast(triangle.e2.y), e2z = P::broadcast(triangle.e2.z);
+
+            // p = direction x e2
+            P px = direction.y * e2z - direction.z * e2y;
+            P py = direction.z * e2x - direction.x * e2z;
+            P pz = direction.x * e2y - direction.y * e2x;
+
+            P inverseDeterminant = P::broadcast(static_cast<F>(1.0)) / simd::madd(e1x, px, simd::madd(e1y, py, e1z * pz));
+
+            P sx = origin.x - P::broadcast(triangle.v0.x);
+            P sy = origin.y - P::broadcast(triangle.v0.y);
+            P sz = origin.z - P::broadcast(triangle.v0.z);
+
+            // q = s x e1
+            P qx = sy * e1z - sz * e1y;
+            P qy = sz * e1x - sx * e1z;
+            P qz = sx * e1y - sy * e1x;
+
+            P u = simd::madd(sx, px, simd::madd(sy, py, sz * pz)) * inverseDeterminant;
+            P v = simd::madd(direction.x, qx, simd::madd(direction.y, qy, direction.z * qz)) * inverseDeterminant;
+            distance = simd::madd(e2x, qx, simd::madd(e2y, qy, e2z * qz)) * inverseDeterminant;
+
+            P zero = P::zero();
+
+            P inside = simd::maskAnd(simd::maskAnd(simd::cmpGe(u, zero), simd::cmpGe(v, zero)),
+                                     simd::cmpLe(u + v, P::broadcast(static_cast<F>(1.0))));
+
+            return simd::maskAnd(inside, simd::maskAnd(simd::cmpGe(distance, zero), simd::cmpLt(distance, maxDistance)));
+        }
+
+        // The slab test of bvh::raycast for a pack of rays : returns the mask of the rays that enter the box
+        // before maxDistance, and where they enter it in distance
+        template<typename P, std::floating_point F>
+        inline P intersectBoxPacket(const packed_vec3<P>& origin, const packed_vec3<P>& inverseDirection, const aabb<F>& box,
+                                    P maxDistance, P& distance)
+        {
+            P x1 = (P::broadcast(box.min.x) - origin.x) * inverseDirection.x, x2 = (P::broadcast(box.max.x) - origin.x) * inverseDirection.x;
+            P y1 = (P::broadcast(box.min.y) - origin.y) * inverseDirection.y, y2 = (P::broadcast(box.max.y) - origin.y) * inverseDirection.y;
+            P z1 = (P::broadcast(box.min.z) - origin.z) * inverseDirection.z, z2 = (P::broadcast(box.max.z) - origin.z) * inverseDirection.z;
+
+            P enter = simd::max(simd::max(simd::min(x1, x2), simd::min(y1, y2)), simd::max(simd::min(z1, z2), P::zero()));
+            P exit = simd::min(simd::min(simd::max(x1, x2), simd::max(y1, y2)), simd::max(z1, z2));
+
+            distance = enter;
+
+            return simd::maskAnd(simd::cmpLe(enter, exit), simd::cmpLt(enter, maxDistance));
+        }
+
+        // Casts the rays by chunks of rayChunkSize across the threads. kernel(P{}, i, closest, hits) tests the
+        // pack of rays starting at i, closest starting at their maxDistances and hits at noHit
+        template<std::floating_point F, typename Kernel>
+        inline void castRays(const ray_soa<F>& rays, F* distances, std::uint32_t* hits, const Kernel& kernel)
+        {
+            std::size_t count = rays.size();
+            std::size_t chunkCount = (count + rayChunkSize - 1) / rayChunkSize;
+
+            math::parallelFor(chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+            {
+                for (std::size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+                {
+                    std::size_t begin = chunk * rayChunkSize;
+                    std::size_t end = std::min(begin + rayChunkSize, count);
+
+                    simd::forEachPack<F>(begin, end, [&](auto p, std::size_t i)
+                    {
+                        using P = decltype(p);
+
+                        P closest = P::load(rays.maxDistances.data() + i);
+                        std::uint32_t closestHits[P::width];
+
+                        std::fill_n(closestHits, P::width, ray_soa<F>::noHit);
+
+                        kernel(p, i, closest, closestHits);
+
+                        closest.storeu(distances + i);
+                        std::copy_n(closestHits, P::width, hits + i);
+                    });
+                }
+            });
+        }
+
+        // Records primitive as the closest hit of the lanes set in bits
+        inline void recordHits(unsigned bits, std::uint32_t primitive, std::uint32_t* hits)
+        {
+            while (bits != 0)
+            {
+                hits[std::countr_zero(bits)] = primitive;
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    template<std::floating_point F>
+    inline void ray_soa<F>::intersectTriangles(const ray_soa& rays, std::span<const vec3<F>> vertices, std::span<F> distances, std::span<std::uint32_t> triangles)
+    {
+        std::vector<detail::ray_triangle<F>> edges = detail::rayTriangles(vertices);
+
+        detail::castRays<F>(rays, distances.data(), triangles.data(), [&](auto p, std::size_t i, auto& closest, std::uint32_t* hits)
+        {
+            using P = decltype(p);
+
+            detail::packed_vec3<P> origin = detail::loadPacked<P>(rays.origins, i);
+            detail::packed_vec3<P> direction = detail::loadPacked<P>(rays.directions, i);
+
+            for (std::size_t triangle = 0; triangle < edges.size(); triangle++)
+            {
+                P distance;
+                P mask = detail::intersectTrianglePacket(origin, direction, edges[triangle], closest, distance);
+                unsigned bits = simd::moveMask(mask);
+
+                // Most triangles miss the whole pack
+                if (bits == 0) continue;
+
+                closest = simd::select(mask, distance, closest);
+                detail::recordHits(bits, static_cast<std::uint32_t>(triangle), hits);
+            }
+        });
+    }
+
+    template<std::floating_point F>
+    inline void ray_soa<F>::intersectAabbs(const ray_soa& rays, std::span<const aabb<F>> boxes, std::span<F> distances, std::span<std::uint32_t> hits)
+    {
+        detail::castRays<F>(rays, distances.data(), hits.data(), [&](auto p, std::size_t i, auto& closest, std::uint32_t* closestHits)
+        {
+            using P = decltype(p);
+
+            P one = P::broadcast(static_cast<F>(1.0));
+
+            detail::packed_vec3<P> origin = detail::loadPacked<P>(rays.origins, i);
+            detail::packed_vec3<P> direction = detail::loadPacked<P>(rays.directions, i);
+            // A component of 0.0 gives an infinite inverse, the slabs of that axis then containing the whole ray or nothing
+            detail::packed_vec3<P> inverseDirection{ one / direction.x, one / direction.y, one / direction.z };
+
+            for (std::size_t box = 0; box < boxes.size(); box++)
+            {
+                P distance;
+                P mask = detail::intersectBoxPacket(origin, inverseDirection, boxes[box], closest, distance);
+                unsigned bits = simd::moveMask(mask);
+
+                if (bits == 0) continue;
+
+                closest = simd::select(mask, distance, closest);
+                detail::recordHits(bits, static_cast<std::uint32_t>(box), closestHits);
+            }
+        });
+    }
+
+    template<std::floating_point F>
+    inline std::size_t ray_soa<F>::unoccluded(const ray_soa& rays, std::span<const vec3<F>> vertices, std::span<std::uint32_t> visible)
+    {
+        std::vector<detail::ray_triangle<F>> edges = detail::rayTriangles(vertices);
+
+        return detail::cullObjects<F>(rays.size(), visible.data(), [&](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            detail::packed_vec3<P> origin = detail::loadPacked<P>(rays.origins, i);
+            detail::packed_vec3<P> direction = detail::loadPacked<P>(rays.directions, i);
+            P maxDistance = P::load(rays.maxDistances.data() + i);
+
+            P zero = P::zero();
+            // Every lane set
+            P clear = simd::cmpLe(zero, zero);
+
+            for (const detail::ray_triangle<F>& triangle : edges)
+            {
+                P distance;
+                clear = simd::select(detail::intersectTrianglePacket(origin, direction, triangle, maxDistance, distance), zero, clear);
+
+                // Any hit blocks a ray, so the pack is done once every ray is blocked
+                if (simd::moveMask(clear) == 0) break;
+            }
+
+            return clear;
+        });
+    }
+
+    #pragma endregion Kernels
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Geometry\Aabb.hpp"
+#include "Math\Vectors\Vector3.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+
+namespace math
+{
+    // A uniform grid over a set of points, stored in a hash table of cells, used to find the points near
+    // a position without testing every one of them. It is meant to be rebuilt every frame.
+    //
+    // build() counting-sorts the points by cell into a single array, the points of a cell being next to each
+    // other, in linear time and without any allocation once the buffers have grown to the number of points.
+    // The points are split across the threads of math::thread_pool, and the result does not depend on how.
+    // The cells of a row along x are next to each other in the table, so a query reads each row of cells it
+    // covers as a single range, and tests a whole SIMD pack of points at a time.
+    //
+    // The cell size should be about the radius of the queries : a query reads the points of every cell its
+    // box touches.
+    template<std::floating_point F>
+    class spatial_hash
+    {
+    public:
+        using index = std::uint32_t;
+
+    public:
+        // Constructor that returns an empty hash
+        spatial_hash();
+
+        // Sorts positions into cells of size cellSize, the point i being positions[i]. Returns false, the hash
+        // being empty, if cellSize is not greater than 0.0
+        bool build(std::span<const vec3<F>> positions, F cellSize);
+        void clear();
+
+        bool empty() const;
+        // Returns the number of points
+        std::size_t size() const;
+        F cellSize() const;
+
+        // Calls fn(point) for every point whose distance to center is at most radius
+        template<typename Fn>
+        void queryRadius(const vec3<F>& center, F radius, Fn&& fn) const;
+        // Calls fn(point) for every point inside box, its faces included
+        template<typename Fn>
+        void queryAabb(const aabb<F>& box, Fn&& fn) const;
+
+    private:
+        // Calls visit(begin, end) on ranges of sortedPositions that hold every cell overlapped by box, each
+        // point being in a single range
+        template<typename Visit>
+        void forEachRange(const aabb<F>& box, Visit&& visit) const;
+
+    private:
+        F gridCellSize = static_cast<F>(0.0);
+        F inverseCellSize = static_cast<F>(0.0);
+
+        // The points of the cells hashed to the bucket b are [cellStarts[b], cellStarts[b + 1]) in
+        // sortedPositions and pointIndices. The bucket count is a power of 2
+        std::vector<index> cellStarts;
+        vec3_soa<F> sortedPositions;
+        std::vector<index> pointIndices;
+
+        // Build buffers, kept to avoid allocating every frame
+        std::vector<index> pointBuckets;
+        std::vector<index> rangePoints;
+        std::vector<index> rangeCounts;
+        std::vector<index> rangeStarts;
+    };
+
+    namespace detail
+    {
+        // The fewest points a thread sorts during a build
+        inline constexpr std::size_t spatialHashChunkSize = 4096;
+        // The number of rows of cells a query keeps on the stack, larger queries allocating them
+        inline constexpr std::size_t spatialHashQueryRows = 64;
+    }
+}
+
+#include "Math\Geometry\SpatialHash.inl"
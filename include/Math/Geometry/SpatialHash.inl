@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    namespace detail
+    {
+        // A range of buckets, [first, last)
+        struct spatial_hash_range
+        {
+            std::uint64_t first;
+            std::uint64_t last;
+        };
+
+        template<std::floating_point F>
+        inline std::int64_t cellCoordinate(F value, F inverseCellSize)
+        {
+            return static_cast<std::int64_t>(std::floor(value * inverseCellSize));
+        }
+
+        // The bucket of the first cell of the row (y, z), the next cells along x being in the next buckets
+        inline std::uint64_t rowBucket(std::int64_t y, std::int64_t z)
+        {
+            std::uint64_t hash = static_cast<std::uint64_t>(y) * 0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(z) * 0xC2B2AE3D27D4EB4Full;
+
+            return hash ^ (hash >> 32);
+        }
+
+        template<std::floating_point F>
+        inline std::uint32_t cellBucket(const vec3<F>& position, F inverseCellSize, std::uint64_t mask)
+        {
+            std::int64_t x = cellCoordinate(position.x, inverseCellSize);
+            std::int64_t y = cellCoordinate(position.y, inverseCellSize);
+            std::int64_t z = cellCoordinate(position.z, inverseCellSize);
+
+            return static_cast<std::uint32_t>((rowBucket(y, z) + static_cast<std::uint64_t>(x)) & mask);
+        }
+    }
+
+    template<std::floating_point F>
+    inline spatial_hash<F>::spatial_hash()
+    {
+    }
+
+    template<std::floating_point F>
+    inline bool spatial_hash<F>::build(std::span<const vec3<F>> positions, F cellSize)
+    {
+        clear();
+
+        if (!(cellSize > static_cast<F>(0.0))) return false;
+
+        gridCellSize = cellSize;
+        inverseCellSize = static_cast<F>(1.0) / cellSize;
+
+        std::size_t count = positions.size();
+        // About a point per bucket
+        std::size_t bucketCount = std::bit_ceil(std::max<std::size_t>(count, 1));
+        std::uint64_t mask = bucketCount - 1;
+
+        // The points are sorted in two passes, so that the counts never grow with the number of threads times
+        // the number of buckets. The buckets are split in as many ranges as there are chunks of points :
+        // - each thread hashes its own consecutive points, and counts them per range of buckets,
+        // - each thread moves its points to their range, keeping their order,
+        // - each thread counting-sorts the points of its own range, using its part of cellStarts as counts.
+        // No count is shared between the threads, and the points of a bucket keep their order
+        std::size_t chunkCount = std::clamp<std::size_t>(count / detail::spatialHashChunkSize, 1, thread_pool::instance().concurrency());
+        auto chunkBegin = [&](std::size_t chunk) { return chunk * count / chunkCount; };
+
+        // A single range holds every point in order, which needs no move
+        bool singleRange = chunkCount == 1;
+
+        // The bucket b is in the range b * chunkCount / bucketCount
+        auto rangeBegin = [&](std::size_t range) { return (range * bucketCount + chunkCount - 1) / chunkCount; };
+        auto rangeOf = [&](index bucket) { return static_cast<std::size_t>(bucket) * chunkCount / bucketCount; };
+
+        pointBuckets.resize(count);
+        rangePoints.resize(singleRange ? 0 : count);
+        rangeCounts.assign(chunkCount * chunkCount, 0);
+
+        math::parallelFor(chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+        {
+            for (std::size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                index* counts = rangeCounts.data() + chunk * chunkCount;
+                std::size_t end = chunkBegin(chunk + 1);
+
+                for (std::size_t i = chunkBegin(chunk); i < end; i++)
+                {
+                    index bucket = detail::cellBucket(positions[i], inverseCellSize, mask);
+
+                    pointBuckets[i] = bucket;
+                    counts[rangeOf(bucket)]++;
+                }
+            }
+        });
+
+        // Turns the counts into the slot of the next point of each chunk in each range, the ranges being one
+        // after the other in rangePoints, and the chunks one after the other in each range
+        rangeStarts.resize(chunkCount + 1);
+
+        index slot = 0;
+
+        for (std::size_t range = 0; range < chunkCount; range++)
+        {
+            rangeStarts[range] = slot;
+
+            for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+            {
+                index& counts = rangeCounts[chunk * chunkCount + range];
+                index rangeSize = counts;
+
+                counts = slot;
+                slot += rangeSize;
+            }
+        }
+
+        rangeStarts[chunkCount] = slot;
+
+        if (!singleRange) math::parallelFor(chunkCount, 1, [&](std::size_t firstChunk, std::size_t lastChunk)
+        {
+            for (std::size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                index* slots = rangeCounts.data() + chunk * chunkCount;
+                std::size_t end = chunkBegin(chunk + 1);
+
+                for (std::size_t i = chunkBegin(chunk); i < end; i++) rangePoints[slots[rangeOf(pointBuckets[i])]++] = static_cast<index>(i);
+            }
+        });
+
+        // Sorts the points of each range by bucket, in the slots of that range
+        cellStarts.resize(bucketCount + 1);
+        sortedPositions.resize(count);
+        pointIndices.resize(count);
+
+        math::parallelFor(chunkCount, 1, [&](std::size_t firstRange, std::size_t lastRange)
+        {
+            for (std::size_t range = firstRange; range < lastRange; range++)
+            {
+                std::size_t begin = rangeBegin(range), end = rangeBegin(range + 1);
+                const index* points = rangePoints.data() + rangeStarts[range];
+                std::size_t pointCount = rangeStarts[range + 1] - rangeStarts[range];
+
+                std::fill(cellStarts.begin() + begin, cellStarts.begin() + end, index(0));
+
+                for (std::size_t p = 0; p < pointCount; p++) cellStarts[pointBuckets[singleRange ? p : points[p]]]++;
+
+                // cellStarts[b] becomes the end of the bucket b, then goes back to its start as its points are
+                // moved from the last one, which keeps their order
+                index bucketEnd = rangeStarts[range];
+
+                for (std::size_t bucket = begin; bucket < end; bucket++)
+                {
+                    bucketEnd += cellStarts[bucket];
+                    cellStarts[bucket] = bucketEnd;
+                }
+
+                for (std::size_t p = pointCount; p-- > 0;)
+                {
+                    index i = singleRange ? static_cast<index>(p) : points[p];
+                    index pointSlot = --cellStarts[pointBuckets[i]];
+
+                    sortedPositions.x[pointSlot] = positions[i].x;
+                    sortedPositions.y[pointSlot] = positions[i].y;
+                    sortedPositions.z[pointSlot] = positions[i].z;
+                    pointIndices[pointSlot] = i;
+                }
+            }
+        });
+
+        cellStarts[bucketCount] = static_cast<index>(count);
+
+        return true;
+    }
+
+    template<std::floating_point F>
+    inline void spatial_hash<F>::clear()
+    {
+        gridCellSize = static_cast<F>(0.0);
+        inverseCellSize = static_cast<F>(0.0);
+
+        cellStarts.clear();
+        sortedPositions.clear();
+        pointIndices.clear();
+    }
+
+    template<std::floating_point F>
+    inline bool spatial_hash<F>::empty() const
+    {
+        return pointIndices.empty();
+    }
+
+    template<std::floating_point F>
+    inline std::size_t spatial_hash<F>::size() const
+    {
+        return pointIndices.size();
+    }
+
+    template<std::floating_point F>
+    inline F spatial_hash<F>::cellSize() const
+    {
+        return gridCellSize;
+    }
+
+    template<std::floating_point F>
+    template<typename Visit>
+    inline void spatial_hash<F>::forEachRange(const aabb<F>& box, Visit&& visit) const
+    {
+        if (empty() || box.empty()) return;
+
+        std::uint64_t bucketCount = cellStarts.size() - 1;
+        std::uint64_t mask = bucketCount - 1;
+
+        // Checked before the cells are computed, so that a huge or infinite box does not overflow them
+        F cellsX = (box.max.x - box.min.x) * inverseCellSize + static_cast<F>(1.0);
+        F cellsY = (box.max.y - box.min.y) * inverseCellSize + static_cast<F>(1.0);
+        F cellsZ = (box.max.z - box.min.z) * inverseCellSize + static_cast<F>(1.0);
+
+        // Reading every point costs about as much as reading that many buckets
+        if (!(cellsX * cellsY * cellsZ < static_cast<F>(bucketCount)))
+        {
+            visit(index(0), static_cast<index>(size()));
+            return;
+        }
+
+        std::int64_t minX = detail::cellCoordinate(box.min.x, inverseCellSize), maxX = detail::cellCoordinate(box.max.x, inverseCellSize);
+        std::int64_t minY = detail::cellCoordinate(box.min.y, inverseCellSize), maxY = detail::cellCoordinate(box.max.y, inverseCellSize);
+        std::int64_t minZ = detail::cellCoordinate(box.min.z, inverseCellSize), maxZ = detail::cellCoordinate(box.max.z, inverseCellSize);
+
+        std::uint64_t rowLength = static_cast<std::uint64_t>(maxX - minX + 1);
+        std::size_t rowCount = static_cast<std::size_t>((maxY - minY + 1) * (maxZ - minZ + 1));
+
+        // A row wrapping around the end of the table is split in two ranges
+        detail::spatial_hash_range local[2 * detail::spatialHashQueryRows];
+        std::vector<detail::spatial_hash_range> allocated;
+        detail::spatial_hash_range* ranges = local;
+
+        if (rowCount > detail::spatialHashQueryRows)
+        {
+            allocated.resize(2 * rowCount);
+            ranges = allocated.data();
+        }
+
+        std::size_t rangeCount = 0;
+
+        for (std::int64_t z = minZ; z <= maxZ; z++)
+        {
+            for (std::int64_t y = minY; y <= maxY; y++)
+            {
+                std::uint64_t first = (detail::rowBucket(y, z) + static_cast<std::uint64_t>(minX)) & mask;
+                std::uint64_t last = first + rowLength;
+
+                if (last > bucketCount)
+                {
+                    ranges[rangeCount++] = { first, bucketCount };
+                    ranges[rangeCount++] = { 0, last - bucketCount };
+                }
+                else
+                {
+                    ranges[rangeCount++] = { first, last };
+                }
+            }
+        }
+
+        // Different rows can share buckets, which must only be read once. The merged ranges are also longer,
+        // which fills the packs better
+        std::sort(ranges, ranges + rangeCount, [](const detail::spatial_hash_range& a, const detail::spatial_hash_range& b) { return a.first < b.first; });
+
+        detail::spatial_hash_range current = ranges[0];
+
+        for (std::size_t i = 1; i < rangeCount; i++)
+        {
+            if (ranges[i].first <= current.last)
+            {
+                current.last = std::max(current.last, ranges[i].last);
+            }
+            else
+            {
+                visit(cellStarts[current.first], cellStarts[current.last]);
+                current = ranges[i];
+            }
+        }
+
+        visit(cellStarts[current.first], cellStarts[current.last]);
+    }
+
+    template<std::floating_point F>
+    template<typename Fn>
+    inline void spatial_hash<F>::queryRadius(const vec3<F>& center, F radius, Fn&& fn) const
+    {
+        const F* x = sortedPositions.x.data();
+        const F* y = sortedPositions.y.data();
+        const F* z = sortedPositions.z.data();
+        const index* indices = pointIndices.data();
+
+        vec3<F> extents(radius, radius, radius);
+
+        forEachRange(aabb<F>(center - extents, center + extents), [&](index begin, index end)
+        {
+            simd::forEachPack<F>(begin, end, [&](auto p, std::size_t i)
+            {
+                using P = decltype(p);
+
+                P dx = P::loadu(x + i) - P::broadcast(center.x);
+                P dy = P::loadu(y + i) - P::broadcast(center.y);
+                P dz = P::loadu(z + i) - P::broadcast(center.z);
+
+                P distanceSquared = simd::madd(dx, dx, simd::madd(dy, dy, dz * dz));
+
+                for (unsigned bits = simd::moveMask(simd::cmpLe(distanceSquared, P::broadcast(radius * radius))); bits != 0; bits &= bits - 1)
+                {
+                    fn(indices[i + std::countr_zero(bits)]);
+                }
+            });
+        });
+    }
+
+    template<std::floating_point F>
+    template<typename Fn>
+    inline void spatial_hash<F>::queryAabb(const aabb<F>& box, Fn&& fn) const
+    {
+        const F* x = sortedPositions.x.data();
+        const F* y = sortedPositions.y.data();
+        const F* z = sortedPositions.z.data();
+        const index* indices = pointIndices.data();
+
+        forEachRange(box, [&](index begin, index end)
+        {
+            simd::forEachPack<F>(begin, end, [&](auto p, std::size_t i)
+            {
+                using P = decltype(p);
+
+                P px = P::loadu(x + i), py = P::loadu(y + i), pz = P::loadu(z + i);
+
+                P inside = simd::maskAnd(simd::maskAnd(simd::cmpGe(px, P::broadcast(box.min.x)), simd::cmpLe(px, P::broadcast(box.max.x))),
+                           simd::maskAnd(simd::maskAnd(simd::cmpGe(py, P::broadcast(box.min.y)), simd::cmpLe(py, P::broadcast(box.max.y))),
+                                         simd::maskAnd(simd::cmpGe(pz, P::broadcast(box.min.z)), simd::cmpLe(pz, P::broadcast(box.max.z)))));
+
+                for (unsigned bits = simd::moveMask(inside); bits != 0; bits &= bits - 1)
+                {
+                    fn(indices[i + std::countr_zero(bits)]);
+                }
+            });
+        });
+    }
+}
@@ -1,35 +1,272 @@
 #pragma once
 #include <cmath>
+#include <limits>
+#include <numbers>
+#include <type_traits>
 
 #include "Math\Concepts.hpp"
 
 namespace math
 {
-   
-    // Min and Max methods, taking two or an infinite number of arguments 
+    // Everything below is constexpr : at compile time the functions of <cmath> are replaced
+    // by the series of math::detail, which are evaluated in long double and then rounded to
+    // the asked type, while at runtime they still go through <cmath>.
+    // This lets the vectors, matrices and quaternions of the library be built in constant expressions.
+    namespace detail
+    {
+        using constexpr_float = long double;
+
+        constexpr constexpr_float constexprPi = std::numbers::pi_v<constexpr_float>;
+        constexpr constexpr_float constexprLn2 = std::numbers::ln2_v<constexpr_float>;
+
+        constexpr constexpr_float constexprNaN()
+        {
+            return std::numeric_limits<constexpr_float>::quiet_NaN();
+        }
+
+        constexpr bool constexprIsFinite(constexpr_float value)
+        {
+            return value == value &&
+                   value <=  std::numeric_limits<constexpr_float>::max() &&
+                   value >= -std::numeric_limits<constexpr_float>::max();
+        }
+
+        constexpr constexpr_float constexprAbs(constexpr_float value)
+        {
+            return value < 0.0L ? -value : value;
+        }
+
+        // Rounds toward zero, values too large to have a fractional part are returned as they are
+        constexpr constexpr_float constexprTrunc(constexpr_float value)
+        {
+            if (!constexprIsFinite(value) || constexprAbs(value) >= 9.2e18L) return value;
+
+            return static_cast<constexpr_float>(static_cast<long long>(value));
+        }
+
+        // Rounds to the nearest integer, halfway cases away from zero
+        constexpr constexpr_float constexprRound(constexpr_float value)
+        {
+            return constexprTrunc(value < 0.0L ? value - 0.5L : value + 0.5L);
+        }
+
+        // Newton-Raphson iterations, until the estimate stops moving
+        constexpr constexpr_float constexprSqrt(constexpr_float value)
+        {
+            if (value != value || value < 0.0L) return constexprNaN();
+            if (value == 0.0L || !constexprIsFinite(value)) return value;
+
+            constexpr_float current = value < 1.0L ? 1.0L : value;
+            constexpr_float previous = 0.0L;
+
+            for (int i = 0; i < 128 && current != previous; i++)
+            {
+                previous = current;
+                current = 0.5L * (current + value / current);
+            }
+
+            return current;
+        }
+
+        // Taylor series of sin(x) and cos(x), x being reduced to [-pi, pi] first
+        constexpr constexpr_float constexprSin(constexpr_float value)
+        {
+            if (!constexprIsFinite(value)) return constexprNaN();
+
+            constexpr_float x = value - constexprRound(value / (2.0L * constexprPi)) * (2.0L * constexprPi);
+            constexpr_float term = x;
+            constexpr_float sum = x;
+
+            for (int n = 1; n < 32; n++)
+            {
+                term *= -(x * x) / static_cast<constexpr_float>((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        constexpr constexpr_float constexprCos(constexpr_float value)
+        {
+            if (!constexprIsFinite(value)) return constexprNaN();
+
+            constexpr_float x = value - constexprRound(value / (2.0L * constexprPi)) * (2.0L * constexprPi);
+            constexpr_float term = 1.0L;
+            constexpr_float sum = 1.0L;
+
+            for (int n = 1; n < 32; n++)
+            {
+                term *= -(x * x) / static_cast<constexpr_float>((2 * n - 1) * (2 * n));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        // atan(x) = 2 * atan(x / (1 + sqrt(1 + x * x))) brings x under 0.25 before the Taylor series
+        constexpr constexpr_float constexprAtan(constexpr_float value)
+        {
+            if (value != value) return value;
+            if (value < 0.0L) return -constexprAtan(-value);
+            if (value > 1.0L) return constexprPi / 2.0L - constexprAtan(1.0L / value);
+
+            constexpr_float x = value;
+            constexpr_float factor = 1.0L;
+
+            for (int i = 0; i < 2; i++)
+            {
+                x = x / (1.0L + constexprSqrt(1.0L + x * x));
+                factor *= 2.0L;
+            }
+
+            constexpr_float term = x;
+            constexpr_float sum = x;
+
+            for (int n = 1; n < 40; n++)
+            {
+                term *= -(x * x);
+                sum += term / static_cast<constexpr_float>(2 * n + 1);
+            }
+
+            return sum * factor;
+        }
+
+        constexpr constexpr_float constexprAtan2(constexpr_float y, constexpr_float x)
+        {
+            if (x != x || y != y) return constexprNaN();
+
+            if (x > 0.0L) return constexprAtan(y / x);
+            if (x < 0.0L) return y < 0.0L ? constexprAtan(y / x) - constexprPi : constexprAtan(y / x) + constexprPi;
+
+            if (y > 0.0L) return constexprPi / 2.0L;
+            if (y < 0.0L) return -constexprPi / 2.0L;
+
+            return 0.0L;
+        }
+
+        constexpr constexpr_float constexprAsin(constexpr_float value)
+        {
+            if (value != value || value < -1.0L || value > 1.0L) return constexprNaN();
+
+            return constexprAtan2(value, constexprSqrt((1.0L - value) * (1.0L + value)));
+        }
+
+        constexpr constexpr_float constexprAcos(constexpr_float value)
+        {
+            if (value != value || value < -1.0L || value > 1.0L) return constexprNaN();
+
+            return constexprAtan2(constexprSqrt((1.0L - value) * (1.0L + value)), value);
+        }
+
+        // exp(x) = 2^k * exp(r), with x = k * ln(2) + r and |r| <= ln(2) / 2
+        constexpr constexpr_float constexprExp(constexpr_float value)
+        {
+            if (value != value) return value;
+            if (value > 11356.0L) return std::numeric_limits<constexpr_float>::infinity();
+            if (value < -11400.0L) return 0.0L;
+
+            constexpr_float k = constexprRound(value / constexprLn2);
+            constexpr_float r = value - k * constexprLn2;
+
+            constexpr_float term = 1.0L;
+            constexpr_float sum = 1.0L;
+
+            for (int n = 1; n < 32; n++)
+            {
+                term *= r / static_cast<constexpr_float>(n);
+                sum += term;
+            }
+
+            for (; k > 0.0L; k -= 1.0L) sum *= 2.0L;
+            for (; k < 0.0L; k += 1.0L) sum *= 0.5L;
+
+            return sum;
+        }
+
+        // log(x) = k * ln(2) + log(m), with x = 2^k * m and m in [1, 2),
+        // log(m) being 2 * atanh((m - 1) / (m + 1)) through its series
+        constexpr constexpr_float constexprLog(constexpr_float value)
+        {
+            if (value != value || value < 0.0L) return constexprNaN();
+            if (value == 0.0L) return -std::numeric_limits<constexpr_float>::infinity();
+            if (!constexprIsFinite(value)) return value;
+
+            constexpr_float m = value;
+            constexpr_float k = 0.0L;
+
+            while (m >= 2.0L) { m *= 0.5L; k += 1.0L; }
+            while (m < 1.0L) { m *= 2.0L; k -= 1.0L; }
+
+            constexpr_float s = (m - 1.0L) / (m + 1.0L);
+            constexpr_float term = s;
+            constexpr_float sum = s;
+
+            for (int n = 1; n < 64; n++)
+            {
+                term *= s * s;
+                sum += term / static_cast<constexpr_float>(2 * n + 1);
+            }
+
+            return k * constexprLn2 + 2.0L * sum;
+        }
+
+        constexpr constexpr_float constexprPow(constexpr_float value, constexpr_float exponent)
+        {
+            if (exponent == 0.0L) return 1.0L;
+
+            // Integer exponents are exact, and are the only ones allowed for a negative value
+            if (constexprTrunc(exponent) == exponent && constexprAbs(exponent) < 9.2e18L)
+            {
+                long long n = static_cast<long long>(constexprAbs(exponent));
+                constexpr_float base = value;
+                constexpr_float res = 1.0L;
+
+                for (; n > 0; n >>= 1)
+                {
+                    if (n & 1) res *= base;
+                    base *= base;
+                }
+
+                return exponent < 0.0L ? 1.0L / res : res;
+            }
+
+            if (value < 0.0L) return constexprNaN();
+
+            return constexprExp(exponent * constexprLog(value));
+        }
+
+        constexpr constexpr_float constexprFmod(constexpr_float value, constexpr_float modulus)
+        {
+            if (modulus == 0.0L || !constexprIsFinite(value)) return constexprNaN();
+
+            return value - constexprTrunc(value / modulus) * modulus;
+        }
+    }
+
+    // Min and Max methods, taking two or an infinite number of arguments
     template<IsComparable T>
-    T max(T a, T b) 
+    constexpr T max(T a, T b)
     {
         return a > b ? a : b;
     }
     template<IsComparable T>
-    T min(T a, T b) 
+    constexpr T min(T a, T b)
     {
         return a < b ? a : b;
     }
 
     template<IsComparable T, IsComparable... Args>
-    T max(T first, Args... args) 
+    constexpr T max(T first, Args... args)
     {
         T result = first;
-        ((result = max(result, args)), ...); 
+        ((result = max(result, args)), ...);
         return result;
     }
     template<IsComparable T, IsComparable... Args>
-    T mMin(T first, Args... args) 
+    constexpr T mMin(T first, Args... args)
     {
         T result = first;
-        ((result = min(result, args)), ...); 
+        ((result = min(result, args)), ...);
         return result;
     }
 
@@ -37,7 +274,7 @@ namespace math
     // Methods to clamp a float or an Angle between two numbers
 
     template<Number N>
-    inline N clamp(N value, N minInclusive, N maxInclusive)
+    constexpr N clamp(N value, N minInclusive, N maxInclusive)
     {
         if (value < minInclusive) value = minInclusive;
         else if (value > maxInclusive) value = maxInclusive;
@@ -45,7 +282,7 @@ namespace math
         return value;
     }
     template<Number N>
-    inline N clamp01(N value)
+    constexpr N clamp01(N value)
     {
         return clamp(value, static_cast<N>(0.0), static_cast<N>(1.0));
     }
@@ -54,55 +291,101 @@ namespace math
     // Simple Absolute Value and Square Root methods, with floats and Angles
 
     template<Number N>
-    inline N abs(N value) { return std::abs(value); }
+    constexpr N abs(N value)
+    {
+        if (std::is_constant_evaluated()) return value < static_cast<N>(0) ? -value : value;
+        return std::abs(value);
+    }
     template<std::floating_point F>
-    inline F sqrt(F value) { return static_cast<F>(std::sqrt(value)); }
-    
+    constexpr F sqrt(F value)
+    {
+        if (std::is_constant_evaluated()) return static_cast<F>(detail::constexprSqrt(value));
+        return static_cast<F>(std::sqrt(value));
+    }
+
     // All the trigonometry stuff with floats, and Angles, returning floats and Angles
 
     template<std::floating_point F>
-    inline F sin(F value) { return static_cast<F>(std::sin(value)); }
+    constexpr F sin(F value)
+    {
+        if (std::is_constant_evaluated()) return static_cast<F>(detail::constexprSin(value));
+        return static_cast<F>(std::sin(value));
+    }
+    template<std::floating_point F>
+    constexpr F cos(F value)
+    {
+        if (std::is_constant_evaluated()) return static_cast<F>(detail::constexprCos(value));
+        return static_cast<F>(std::cos(value));
+    }
     template<std::floating_point F>
-    inline F cos(F value) { return static_cast<F>(std::cos(value)); }
+    constexpr F tan(F value)
+    {
+        if (std::is_constant_evaluated()) return static_cast<F>(detail::constexprSin(value) / detail::constexprCos(value));
+        return static_cast<F>(std::tan(value));
+    }
     template<std::floating_point F>
-    inline float tan(float value) { return static_cast<F>(std::tan(value)); }
+    constexpr F asin(F value)
+    {
+        if (std::is_constant_evaluated()) return static_cast<F>(detail::constexprAsin(value));
+        return static_cast<F>(std::asin(value));
+    }
     template<std::floating_point F>
-    inline F asin(F value) { return static_cast<F>(std::asin(value)); }
+    constexpr F acos(F value)
+    {
+        if (std::is_constant_evaluated()) return static_cast<F>(detail::constexprAcos(value));
+        return static_cast<F>(std::acos(value));
+    }
     template<std::floating_point F>
-    inline F acos(F value) { return static_cast<F>(std::acos(value)); }
+    constexpr F atan(F value)
+    {
+        if (std::is_constant_evaluated()) return static_cast<F>(detail::constexprAtan(value));
+        return static_cast<F>(std::atan(value));
+    }
     template<std::floating_point F>
-    inline F atan(F value) { return static_cast<F>(std::atan(value)); }
+    constexpr F atan2(F y, F x)
+    {
+        if (std::is_constant_evaluated()) return static_cast<F>(detail::constexprAtan2(y, x));
+        return static_cast<F>(std::atan2(y, x));
+    }
+
+    // Returns the magnitude of value with the sign of sign
     template<std::floating_point F>
-    inline F atan2(F y, F x) { return static_cast<F>(std::atan2(y, x)); }
+    constexpr F copysign(F value, F sign)
+    {
+        if (std::is_constant_evaluated()) return (sign < static_cast<F>(0.0)) != (value < static_cast<F>(0.0)) ? -value : value;
+        return static_cast<F>(std::copysign(value, sign));
+    }
 
     // Just a Lerp method, which will be defined in each struct Vec, Angle... seperatly
 
     template<Number N>
-    inline N lerp(N start, N end, N t)
+    constexpr N lerp(N start, N end, N t)
     {
         return start + (end - start) * clamp01(t);
     }
 
     template<Number N>
-    inline N mod(N value, N modulus)
+    constexpr N mod(N value, N modulus)
     {
+        if (std::is_constant_evaluated()) return static_cast<N>(detail::constexprFmod(value, modulus));
         return static_cast<N>(std::fmod(value, modulus));
     }
 
     template<Number N>
-    inline N pow(N value, N exponent)
+    constexpr N pow(N value, N exponent)
     {
+        if (std::is_constant_evaluated()) return static_cast<N>(detail::constexprPow(value, exponent));
         return static_cast<N>(std::pow(value, exponent));
     }
 
     template<Number N>
-    inline N toRadians(N degAngle)
+    constexpr N toRadians(N degAngle)
     {
         return degAngle * static_cast<N>(0.0174532925);
     }
 
     template<Number N>
-    inline N toDegrees(N radAngle)
+    constexpr N toDegrees(N radAngle)
     {
         return radAngle * static_cast<N>(57.295779513);
     }
@@ -110,50 +393,50 @@ namespace math
 
 
     template<Number N>
-    inline N pi()
+    constexpr N pi()
     {
         return static_cast<N>(std::numbers::pi);
     }
     template<Number N>
-    inline N twoPi()
+    constexpr N twoPi()
     {
         return static_cast<N>(std::numbers::pi * 2.0);
     }
     template<Number N>
-    inline N e()
+    constexpr N e()
     {
         return static_cast<N>(std::numbers::e);
     }
     template<Number N>
-    inline N degToRad()
+    constexpr N degToRad()
     {
         return static_cast<N>(0.0174532925);
     }
     template<Number N>
-    inline N radToDeg()
+    constexpr N radToDeg()
     {
         return static_cast<N>(57.295779513);
     }
     template<Number N>
-    inline N sqrtOf2()
+    constexpr N sqrtOf2()
     {
         return static_cast<N>(std::numbers::sqrt2);
     }
     template<Number N>
-    inline N sqrtOf3()
+    constexpr N sqrtOf3()
     {
         return static_cast<N>(std::numbers::sqrt3);
     }
     template<Number N>
-    inline N epsilon()
+    constexpr N epsilon()
     {
-        return static_cast<N>(0.1e+06);
+        return static_cast<N>(1e-06);
     }
 
     template<std::floating_point F>
-    inline bool nearlyEqual(F lhs, F rhs)
+    constexpr bool nearlyEqual(F lhs, F rhs)
     {
-        return std::abs(rhs - lhs) < static_cast<F>(0.1e+06);
+        return math::abs(rhs - lhs) < static_cast<F>(1e-06);
     }
-    
-}
\ No newline at end of file
+
+}
@@ -3,6 +3,7 @@
 #include <concepts>
 
 #include "Math\Concepts.hpp"
+#include "Math\Vectors\Vector2.hpp"
 
 namespace math
 {
@@ -16,63 +17,62 @@ namespace math
     struct mat2
     {
     public:
-        union
-        {
-            F indices[4];   // [index] access
-            F columns[2][2]; // [col][row] access
-        };
+        F columns[2][2]; // [col][row] access
         
     public: 
         // stored in column-major
-        mat2(F m00, F m01, 
+        constexpr mat2(F m00, F m01, 
              F m10, F m11);
 
-        mat2();
+        constexpr mat2();
 
         template<std::floating_point f>
-        mat2<f> toMat() const;
+        constexpr mat2<f> toMat() const;
 
-        static mat2 rotateZ(F zAngDeg);
+        static constexpr mat2 rotateZ(F zAngDeg);
 
         template<Number N>
-        N determinant() const;
+        constexpr N determinant() const;
 
-        mat2& inverted();
-        mat2& transposed();
+        constexpr mat2& inverted();
+        constexpr mat2& transposed();
 
         template<std::floating_point f = F>
-        mat2<f> getInvertedMat() const;
+        constexpr mat2<f> getInvertedMat() const;
 
         template<std::floating_point f = F>
-        mat2<f> getTransposedMat() const;
+        constexpr mat2<f> getTransposedMat() const;
 
 
-        static mat2<F> diagonal(F diagonal);
+        static constexpr mat2<F> diagonal(F diagonal);
 
-        static mat2<F> identity();
+        static constexpr mat2<F> identity();
         
 
-        F& at(int row, int col);
-        F at(int row, int col) const;        
+        constexpr F& at(int row, int col);
+        constexpr F at(int row, int col) const;        
+
+        // Returns a pointer to the 4 values, in column-major order
+        constexpr const F* valuePtr() const;
     };
 
     template<std::floating_point F>
-    inline mat2<F> operator+(const mat2<F>& a, const mat2<F>& b);
+    constexpr mat2<F> operator+(const mat2<F>& a, const mat2<F>& b);
 
     template<std::floating_point F>
-    inline mat2<F> operator-(const mat2<F>& a, const mat2<F>& b);
+    constexpr mat2<F> operator-(const mat2<F>& a, const mat2<F>& b);
 
     template<std::floating_point F>
-    inline mat2<F> operator*(const mat2<F>& a, const mat2<F>& b);
+    constexpr mat2<F> operator*(const mat2<F>& a, const mat2<F>& b);
     template<std::floating_point F>
-    inline mat2<F> operator*(const mat2<F>& a, F scalar);
+    constexpr mat2<F> operator*(const mat2<F>& a, F scalar);
     template<std::floating_point F>
-    inline mat2<F> operator*(F scalar, const mat2<F>& a);
+    constexpr mat2<F> operator*(F scalar, const mat2<F>& a);
     template<std::floating_point F>
-    inline vec2<F> operator*(const mat2<F>& a, const vec2<F>& vec);
+    constexpr vec2<F> operator*(const mat2<F>& a, const vec2<F>& vec);
 
     template<std::floating_point F>
-    inline mat2<F> operator/(const mat2<F>& a, F scalar);
+    constexpr mat2<F> operator/(const mat2<F>& a, F scalar);
 }
 
 #include "Math\Matrices\Matrix2x2.inl"
\ No newline at end of file
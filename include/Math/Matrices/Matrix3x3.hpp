@@ -3,6 +3,7 @@
 #include <concepts>
 
 #include "Math\Concepts.hpp"
+#include "Math\Vectors\Vector3.hpp"
 
 namespace math
 {
@@ -16,70 +17,69 @@ namespace math
     struct mat3
     {
     public:
-        union
-        {
-            F columns[3][3]; // [col][row] access
-            F indices[9];   // [index] access
-        };
+        F columns[3][3]; // [col][row] access
         
     public: 
         // stored in column-major
-        mat3(F m00, F m01, F m02,
+        constexpr mat3(F m00, F m01, F m02,
              F m10, F m11, F m12,
              F m20, F m21, F m22);
 
-        mat3();
+        constexpr mat3();
 
         template<std::floating_point f>
-        mat3<f> toMat() const;
+        constexpr mat3<f> toMat() const;
 
-        static mat3 rotateX(F xAngDeg);
-        static mat3 rotateY(F yAngDeg);
-        static mat3 rotateZ(F zAngDeg);
+        static constexpr mat3 rotateX(F xAngDeg);
+        static constexpr mat3 rotateY(F yAngDeg);
+        static constexpr mat3 rotateZ(F zAngDeg);
         // static mat3 rotate(const quat<F>& rotationQuat);
         
 
         template<Number N>
-        N determinant() const;
+        constexpr N determinant() const;
 
-        mat3& inverted();
-        mat3& transposed();
+        constexpr mat3& inverted();
+        constexpr mat3& transposed();
 
         template<std::floating_point f = F>
-        mat3<f> getInvertedMat() const;
+        constexpr mat3<f> getInvertedMat() const;
 
         template<std::floating_point f = F>
-        mat3<f> getTransposedMat() const;
+        constexpr mat3<f> getTransposedMat() const;
 
         template<std::floating_point f = F>
-        mat3<f> getComatrix() const;
+        constexpr mat3<f> getComatrix() const;
 
-        static mat3<F> diagonal(F diagonal);
+        static constexpr mat3<F> diagonal(F diagonal);
 
-        static mat3<F> identity();
+        static constexpr mat3<F> identity();
         
 
-        F& at(int row, int col);
-        F at(int row, int col) const;        
+        constexpr F& at(int row, int col);
+        constexpr F at(int row, int col) const;        
+
+        // Returns a pointer to the 9 values, in column-major order
+        constexpr const F* valuePtr() const;
     };
 
     template<std::floating_point F>
-    inline mat3<F> operator+(const mat3<F>& a, const mat3<F>& b);
+    constexpr mat3<F> operator+(const mat3<F>& a, const mat3<F>& b);
 
     template<std::floating_point F>
-    inline mat3<F> operator-(const mat3<F>& a, const mat3<F>& b);
+    constexpr mat3<F> operator-(const mat3<F>& a, const mat3<F>& b);
 
     template<std::floating_point F>
-    inline mat3<F> operator*(const mat3<F>& a, const mat3<F>& b);
+    constexpr mat3<F> operator*(const mat3<F>& a, const mat3<F>& b);
     template<std::floating_point F>
-    inline mat3<F> operator*(const mat3<F>& a, F scalar);
+    constexpr mat3<F> operator*(const mat3<F>& a, F scalar);
     template<std::floating_point F>
-    inline mat3<F> operator*(F scalar, const mat3<F>& a);
+    constexpr mat3<F> operator*(F scalar, const mat3<F>& a);
     template<std::floating_point F>
-    inline vec3<F> operator*(const mat3<F>& a, const vec3<F>& vec);
+    constexpr vec3<F> operator*(const mat3<F>& a, const vec3<F>& vec);
 
     template<std::floating_point F>
-    inline mat3<F> operator/(const mat3<F>& a, F scalar);
+    constexpr mat3<F> operator/(const mat3<F>& a, F scalar);
 }
 
 #include "Math\Matrices\Matrix3x3.inl"
\ No newline at end of file
@@ -1,34 +1,25 @@
-#include <cmath>
 #include <concepts>
 
+#include "Math\MathInternal.hpp"
+
 namespace math
 {
     
     #pragma region Constructors
 
     template<std::floating_point F>
-    inline mat3<F>::mat3(F m00, F m01, F m02, 
+    constexpr mat3<F>::mat3(F m00, F m01, F m02, 
                          F m10, F m11, F m12,
                          F m20, F m21, F m22)
+        : columns{ { m00, m10, m20 },
+                   { m01, m11, m21 },
+                   { m02, m12, m22 } }
     {
-        columns[0][0] = m00; columns[0][1] = m10; columns[0][2] = m20;
-        columns[1][0] = m01; columns[1][1] = m11; columns[1][2] = m21;
-        columns[2][0] = m02; columns[2][1] = m12; columns[2][2] = m22;
     }
 
     template<std::floating_point F>
-    inline mat3<F>::mat3()
+    constexpr mat3<F>::mat3() : columns{}
     {
-        F f0 = static_cast<F>(0.0);
-
-        indices[0] = f0;
-        indices[1] = f0;
-        indices[2] = f0;
-        indices[4] = f0;
-        indices[5] = f0;
-        indices[6] = f0;
-        indices[7] = f0;
-        indices[8] = f0;
     }
 
     #pragma endregion Constructors
@@ -37,7 +28,7 @@ namespace math
     
     
     template<std::floating_point F>
-    inline mat3<F> mat3<F>::diagonal(F diagonal)
+    constexpr mat3<F> mat3<F>::diagonal(F diagonal)
     {
         mat3<F> baseMat;
 
@@ -49,7 +40,7 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline mat3<F> mat3<F>::identity()
+    constexpr mat3<F> mat3<F>::identity()
     {
         mat3<F> baseMat;
 
@@ -68,19 +59,19 @@ namespace math
     
     template<std::floating_point F>
     template<std::floating_point f>
-    inline mat3<f> mat3<F>::toMat() const
+    constexpr mat3<f> mat3<F>::toMat() const
     {
         mat3<f> res;
 
-        res.indices[0] = static_cast<f>(indices[0]);
-        res.indices[1] = static_cast<f>(indices[1]);
-        res.indices[2] = static_cast<f>(indices[2]);
-        res.indices[3] = static_cast<f>(indices[3]);
-        res.indices[4] = static_cast<f>(indices[4]);
-        res.indices[5] = static_cast<f>(indices[5]);
-        res.indices[6] = static_cast<f>(indices[6]);
-        res.indices[7] = static_cast<f>(indices[7]);
-        res.indices[8] = static_cast<f>(indices[8]);
+        res.columns[0][0] = static_cast<f>(columns[0][0]);
+        res.columns[0][1] = static_cast<f>(columns[0][1]);
+        res.columns[0][2] = static_cast<f>(columns[0][2]);
+        res.columns[1][0] = static_cast<f>(columns[1][0]);
+        res.columns[1][1] = static_cast<f>(columns[1][1]);
+        res.columns[1][2] = static_cast<f>(columns[1][2]);
+        res.columns[2][0] = static_cast<f>(columns[2][0]);
+        res.columns[2][1] = static_cast<f>(columns[2][1]);
+        res.columns[2][2] = static_cast<f>(columns[2][2]);
         
         return res;
     }
@@ -91,171 +82,110 @@ namespace math
     
     template<std::floating_point F>
     template<Number N>
-    inline N mat3<F>::determinant() const
+    constexpr N mat3<F>::determinant() const
     {
-        return columns[0][0] * (columns[1][1] * columns[2][2] - columns[2][1] - columns[1][2]) - 
-               columns[1][0] * (columns[0][1] * columns[2][2] - columns[0][2] - columns[2][1]) + 
-               columns[2][0] * (columns[0][1] * columns[1][2] - columns[1][1] - columns[0][2]);
+        // det(M) = det(transpose(M)), so the columns can be read as the rows
+        const F (&a)[3][3] = columns;
+
+        return static_cast<N>(a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) - 
+                              a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) + 
+                              a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]));
     }
 
     template<std::floating_point F>
-    inline mat3<F>& mat3<F>::inverted()
+    constexpr mat3<F>& mat3<F>::inverted()
     {
-        // TODO: Fix this :)
-
-        #if 0
-
         F det = this->determinant<F>();
 
-        if (std::abs(det) > math::epsilon<F>())
-        { 
-            *this = ( this->getComatrix().getTransposedMat() ) * ( static_cast<F>(1.0) / det );
-        }
-
-        return *this;
-
-        #else
-        
-        F det = this->determinant<F>();
-
-        if (std::abs(det) > math::epsilon<F>())
+        if (math::abs(det) > math::epsilon<F>())
         {
+            // The adjugate (transposed comatrix) divided by the determinant. As for mat4, reading the columns
+            // as the rows gives the transposed inverse, which is written back the same way
+            const F (&a)[3][3] = columns;
 
-            F m00 = + ( columns[1][1] * columns[2][2] - columns[2][1] * columns[1][2] );
-            F m01 = - ( columns[1][0] * columns[2][2] - columns[2][0] * columns[1][2] );
-            F m02 = + ( columns[1][0] * columns[2][1] - columns[2][0] * columns[1][1] );
-
-            F m10 = - ( columns[0][1] * columns[2][0] - columns[2][1] * columns[0][2] );
-            F m11 = + ( columns[0][0] * columns[2][2] - columns[2][0] * columns[0][2] );
-            F m12 = - ( columns[0][0] * columns[2][1] - columns[2][0] * columns[0][1] );
-
-            F m20 = + ( columns[0][1] * columns[1][2] - columns[1][1] * columns[0][2] );
-            F m21 = - ( columns[0][0] * columns[1][2] - columns[1][0] * columns[0][2] );
-            F m22 = + ( columns[0][0] * columns[1][1] - columns[1][0] * columns[0][1] );
-
-            columns[0][0] = m00;
-            columns[0][1] = m01;
-            columns[0][2] = m02;
-            columns[1][0] = m10;
-            columns[1][1] = m11;
-            columns[1][2] = m12;
-            columns[2][0] = m20;
-            columns[2][1] = m21;
-            columns[2][2] = m22;
-
-            //         ^^^^^^^^^
-            // La matrice est devenue sa comatrice 
-
-            m01 = columns[1][0];
-            m02 = columns[0][2];
-            m10 = columns[1][0];
-            m12 = columns[1][2];
-            m20 = columns[2][0];
-            m21 = columns[2][1];
-
-            columns[0][1] = m01;
-            columns[0][2] = m02;
-            columns[1][0] = m10;
-            columns[1][2] = m12;
-            columns[2][0] = m20;
-            columns[2][1] = m21;
-
-            //         ^^^^^^^^^^ 
-            // La matrice est transposée !!
-            
             F invDet = static_cast<F>(1.0) / det;
 
-            indices[0] *= invDet;
-            indices[1] *= invDet;
-            indices[2] *= invDet;
-            indices[3] *= invDet;
-            indices[4] *= invDet;
-            indices[5] *= invDet;
-            indices[6] *= invDet;
-            indices[7] *= invDet;
-            indices[8] *= invDet;
-            
-            //     ^^^^^^^^^
-            // Et la matrice est enfin multipliée par l'inverse du déterminant !!
+            *this = mat3<F>((a[1][1] * a[2][2] - a[1][2] * a[2][1]) * invDet,
+                            (a[1][2] * a[2][0] - a[1][0] * a[2][2]) * invDet,
+                            (a[1][0] * a[2][1] - a[1][1] * a[2][0]) * invDet,
+
+                            (a[0][2] * a[2][1] - a[0][1] * a[2][2]) * invDet,
+                            (a[0][0] * a[2][2] - a[0][2] * a[2][0]) * invDet,
+                            (a[0][1] * a[2][0] - a[0][0] * a[2][1]) * invDet,
+
+                            (a[0][1] * a[1][2] - a[0][2] * a[1][1]) * invDet,
+                            (a[0][2] * a[1][0] - a[0][0] * a[1][2]) * invDet,
+                            (a[0][0] * a[1][1] - a[0][1] * a[1][0]) * invDet);
         }
         
         return *this;
-        #endif
     }
 
     template<std::floating_point F>
-    inline mat3<F>& mat3<F>::transposed()
+    constexpr mat3<F>& mat3<F>::transposed()
     {
-        F m01 = columns[1][0];
-        F m02 = columns[0][2];
-        F m10 = columns[1][0];
-        F m12 = columns[1][2];
-        F m20 = columns[2][0];
-        F m21 = columns[2][1];
-
-        columns[0][1] = m01;
-        columns[0][2] = m02;
-        columns[1][0] = m10;
-        columns[1][2] = m12;
-        columns[2][0] = m20;
-        columns[2][1] = m21;
+        F tmp;
+
+        tmp = columns[0][1]; columns[0][1] = columns[1][0]; columns[1][0] = tmp;
+        tmp = columns[0][2]; columns[0][2] = columns[2][0]; columns[2][0] = tmp;
+        tmp = columns[1][2]; columns[1][2] = columns[2][1]; columns[2][1] = tmp;
 
         return *this;
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline mat3<f> mat3<F>::getInvertedMat() const
+    constexpr mat3<f> mat3<F>::getInvertedMat() const
     {
         mat3<F> mat = *this;
         mat = mat.inverted();
 
         mat3<f> res;
 
-        res.indices[0] = static_cast<f>(mat.indices[0]);
-        res.indices[1] = static_cast<f>(mat.indices[1]);
-        res.indices[2] = static_cast<f>(mat.indices[2]);
-        res.indices[3] = static_cast<f>(mat.indices[3]);
-        res.indices[4] = static_cast<f>(mat.indices[4]);
-        res.indices[5] = static_cast<f>(mat.indices[5]);
-        res.indices[6] = static_cast<f>(mat.indices[6]);
-        res.indices[7] = static_cast<f>(mat.indices[7]);
-        res.indices[8] = static_cast<f>(mat.indices[8]);
+        res.columns[0][0] = static_cast<f>(mat.columns[0][0]);
+        res.columns[0][1] = static_cast<f>(mat.columns[0][1]);
+        res.columns[0][2] = static_cast<f>(mat.columns[0][2]);
+        res.columns[1][0] = static_cast<f>(mat.columns[1][0]);
+        res.columns[1][1] = static_cast<f>(mat.columns[1][1]);
+        res.columns[1][2] = static_cast<f>(mat.columns[1][2]);
+        res.columns[2][0] = static_cast<f>(mat.columns[2][0]);
+        res.columns[2][1] = static_cast<f>(mat.columns[2][1]);
+        res.columns[2][2] = static_cast<f>(mat.columns[2][2]);
 
         return res;
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline mat3<f> mat3<F>::getTransposedMat() const
+    constexpr mat3<f> mat3<F>::getTransposedMat() const
     {
         mat3<F> mat = *this;
         mat = mat.transposed();
 
         mat3<f> res;
 
-        res.indices[0] = static_cast<f>(mat.indices[0]);
-        res.indices[1] = static_cast<f>(mat.indices[1]);
-        res.indices[2] = static_cast<f>(mat.indices[2]);
-        res.indices[3] = static_cast<f>(mat.indices[3]);
-        res.indices[4] = static_cast<f>(mat.indices[4]);
-        res.indices[5] = static_cast<f>(mat.indices[5]);
-        res.indices[6] = static_cast<f>(mat.indices[6]);
-        res.indices[7] = static_cast<f>(mat.indices[7]);
-        res.indices[8] = static_cast<f>(mat.indices[8]);
+        res.columns[0][0] = static_cast<f>(mat.columns[0][0]);
+        res.columns[0][1] = static_cast<f>(mat.columns[0][1]);
+        res.columns[0][2] = static_cast<f>(mat.columns[0][2]);
+        res.columns[1][0] = static_cast<f>(mat.columns[1][0]);
+        res.columns[1][1] = static_cast<f>(mat.columns[1][1]);
+        res.columns[1][2] = static_cast<f>(mat.columns[1][2]);
+        res.columns[2][0] = static_cast<f>(mat.columns[2][0]);
+        res.columns[2][1] = static_cast<f>(mat.columns[2][1]);
+        res.columns[2][2] = static_cast<f>(mat.columns[2][2]);
 
         return res;
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline mat3<f> mat3<F>::getComatrix() const
+    constexpr mat3<f> mat3<F>::getComatrix() const
     {
         F m00 = + ( columns[1][1] * columns[2][2] - columns[2][1] * columns[1][2] );
         F m01 = - ( columns[1][0] * columns[2][2] - columns[2][0] * columns[1][2] );
         F m02 = + ( columns[1][0] * columns[2][1] - columns[2][0] * columns[1][1] );
 
-        F m10 = - ( columns[0][1] * columns[2][0] - columns[2][1] * columns[0][2] );
+        F m10 = - ( columns[0][1] * columns[2][2] - columns[2][1] * columns[0][2] );
         F m11 = + ( columns[0][0] * columns[2][2] - columns[2][0] * columns[0][2] );
         F m12 = - ( columns[0][0] * columns[2][1] - columns[2][0] * columns[0][1] );
 
@@ -280,57 +210,68 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline F& mat3<F>::at(int row, int col)
+    constexpr F& mat3<F>::at(int row, int col)
     {
         return columns[col][row];
     }
 
     template<std::floating_point F>
-    inline F mat3<F>::at(int row, int col) const
+    constexpr F mat3<F>::at(int row, int col) const
     {
         return columns[col][row];
     }
 
+    template<std::floating_point F>
+    constexpr const F* mat3<F>::valuePtr() const
+    {
+        return &columns[0][0];
+    }
+
     #pragma endregion MemberMethods
     
     #pragma region StaticMethods
 
     template<std::floating_point F>
-    inline mat3<F> mat3<F>::rotateX(F zAngDeg)
+    constexpr mat3<F> mat3<F>::rotateX(F xAngDeg)
     {
-        F cosAng = static_cast<F>(std::cos(zAngDeg * math::degToRad<F>()));
-        F sinAng = static_cast<F>(std::sin(zAngDeg * math::radToDeg<F>()));
+        F cosAng = math::cos(xAngDeg * math::degToRad<F>());
+        F sinAng = math::sin(xAngDeg * math::degToRad<F>());
 
         mat3<F> res = mat3<F>::identity();
 
-
                                   res.columns[1][1] = cosAng; res.columns[2][1] = -sinAng;
                                   res.columns[1][2] = sinAng; res.columns[2][2] = cosAng;
+
+        return res;
     }
 
     template<std::floating_point F>
-    inline mat3<F> mat3<F>::rotateY(F zAngDeg)
+    constexpr mat3<F> mat3<F>::rotateY(F yAngDeg)
     {
-        F cosAng = static_cast<F>(std::cos(zAngDeg * math::degToRad<F>()));
-        F sinAng = static_cast<F>(std::sin(zAngDeg * math::radToDeg<F>()));
+        F cosAng = math::cos(yAngDeg * math::degToRad<F>());
+        F sinAng = math::sin(yAngDeg * math::degToRad<F>());
 
         mat3<F> res = mat3<F>::identity();
 
         res.columns[0][0] = cosAng;                            res.columns[2][0] = sinAng;
 
         res.columns[0][2] = -sinAng;                           res.columns[2][2] = cosAng;
+
+        return res;
     }
 
     template<std::floating_point F>
-    inline mat3<F> mat3<F>::rotateZ(F zAngDeg)
+    constexpr mat3<F> mat3<F>::rotateZ(F zAngDeg)
     {
-        F cosAng = static_cast<F>(std::cos(zAngDeg * math::degToRad<F>()));
-        F sinAng = static_cast<F>(std::sin(zAngDeg * math::radToDeg<F>()));
+        F cosAng = math::cos(zAngDeg * math::degToRad<F>());
+        F sinAng = math::sin(zAngDeg * math::degToRad<F>());
 
         mat3<F> res = mat3<F>::identity();
 
         res.columns[0][0] = cosAng; res.columns[1][0] = -sinAng;
         res.columns[0][1] = sinAng; res.columns[1][1] = cosAng;
+
+        return res;
     }
 
     #pragma endregion 
@@ -338,43 +279,43 @@ namespace math
     #pragma region ArithmeticOperators
 
     template<std::floating_point F>
-    inline mat3<F> operator+(const mat3<F>& a, const mat3<F>& b) 
+    constexpr mat3<F> operator+(const mat3<F>& a, const mat3<F>& b) 
     {
         mat3<F> res;
 
-        res.indices[0] = a.indices[0] + b.indices[0];
-        res.indices[1] = a.indices[1] + b.indices[1];
-        res.indices[2] = a.indices[2] + b.indices[2];
-        res.indices[3] = a.indices[3] + b.indices[3];
-        res.indices[4] = a.indices[4] + b.indices[4];
-        res.indices[5] = a.indices[5] + b.indices[5];
-        res.indices[6] = a.indices[6] + b.indices[6];
-        res.indices[7] = a.indices[7] + b.indices[7];
-        res.indices[8] = a.indices[8] + b.indices[8];
+        res.columns[0][0] = a.columns[0][0] + b.columns[0][0];
+        res.columns[0][1] = a.columns[0][1] + b.columns[0][1];
+        res.columns[0][2] = a.columns[0][2] + b.columns[0][2];
+        res.columns[1][0] = a.columns[1][0] + b.columns[1][0];
+        res.columns[1][1] = a.columns[1][1] + b.columns[1][1];
+        res.columns[1][2] = a.columns[1][2] + b.columns[1][2];
+        res.columns[2][0] = a.columns[2][0] + b.columns[2][0];
+        res.columns[2][1] = a.columns[2][1] + b.columns[2][1];
+        res.columns[2][2] = a.columns[2][2] + b.columns[2][2];
 
         return res;
     }
 
     template<std::floating_point F>
-    inline mat3<F> operator-(const mat3<F>& a, const mat3<F>& b) 
+    constexpr mat3<F> operator-(const mat3<F>& a, const mat3<F>& b) 
     {
         mat3<F> res;
 
-        res.indices[0] = a.indices[0] - b.indices[0];
-        res.indices[1] = a.indices[1] - b.indices[1];
-        res.indices[2] = a.indices[2] - b.indices[2];
-        res.indices[3] = a.indices[3] - b.indices[3];
-        res.indices[4] = a.indices[4] - b.indices[4];
-        res.indices[5] = a.indices[5] - b.indices[5];
-        res.indices[6] = a.indices[6] - b.indices[6];
-        res.indices[7] = a.indices[7] - b.indices[7];
-        res.indices[8] = a.indices[8] - b.indices[8];
+        res.columns[0][0] = a.columns[0][0] - b.columns[0][0];
+        res.columns[0][1] = a.columns[0][1] - b.columns[0][1];
+        res.columns[0][2] = a.columns[0][2] - b.columns[0][2];
+        res.columns[1][0] = a.columns[1][0] - b.columns[1][0];
+        res.columns[1][1] = a.columns[1][1] - b.columns[1][1];
+        res.columns[1][2] = a.columns[1][2] - b.columns[1][2];
+        res.columns[2][0] = a.columns[2][0] - b.columns[2][0];
+        res.columns[2][1] = a.columns[2][1] - b.columns[2][1];
+        res.columns[2][2] = a.columns[2][2] - b.columns[2][2];
 
         return res;
     }
 
     template<std::floating_point F>
-    inline mat3<F> operator*(const mat3<F>& a, const mat3<F>& b) 
+    constexpr mat3<F> operator*(const mat3<F>& a, const mat3<F>& b) 
     {
         mat3<F> res;
 
@@ -394,54 +335,51 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline mat3<F> operator*(const mat3<F>& mat, F scalar) 
+    constexpr mat3<F> operator*(const mat3<F>& mat, F scalar) 
     {
         mat3<F> res;
 
-        res.indices[0] = mat.indices[0] * scalar;
-        res.indices[1] = mat.indices[1] * scalar;
-        res.indices[2] = mat.indices[2] * scalar;
-        res.indices[3] = mat.indices[3] * scalar;
-        res.indices[4] = mat.indices[4] * scalar;
-        res.indices[5] = mat.indices[5] * scalar;
-        res.indices[6] = mat.indices[6] * scalar;
-        res.indices[7] = mat.indices[7] * scalar;
-        res.indices[8] = mat.indices[8] * scalar;
+        res.columns[0][0] = mat.columns[0][0] * scalar;
+        res.columns[0][1] = mat.columns[0][1] * scalar;
+        res.columns[0][2] = mat.columns[0][2] * scalar;
+        res.columns[1][0] = mat.columns[1][0] * scalar;
+        res.columns[1][1] = mat.columns[1][1] * scalar;
+        res.columns[1][2] = mat.columns[1][2] * scalar;
+        res.columns[2][0] = mat.columns[2][0] * scalar;
+        res.columns[2][1] = mat.columns[2][1] * scalar;
+        res.columns[2][2] = mat.columns[2][2] * scalar;
 
         return res;
     }
 
     template<std::floating_point F>
-    inline mat3<F> operator*(F scalar, const mat3<F>& mat) 
+    constexpr mat3<F> operator*(F scalar, const mat3<F>& mat) 
     {
         mat3<F> res;
 
-        res.indices[0] = mat.indices[0] * scalar;
-        res.indices[1] = mat.indices[1] * scalar;
-        res.indices[2] = mat.indices[2] * scalar;
-        res.indices[3] = mat.indices[3] * scalar;
-        res.indices[4] = mat.indices[4] * scalar;
-        res.indices[5] = mat.indices[5] * scalar;
-        res.indices[6] = mat.indices[6] * scalar;
-        res.indices[7] = mat.indices[7] * scalar;
-        res.indices[8] = mat.indices[8] * scalar;
+        res.columns[0][0] = mat.columns[0][0] * scalar;
+        res.columns[0][1] = mat.columns[0][1] * scalar;
+        res.columns[0][2] = mat.columns[0][2] * scalar;
+        res.columns[1][0] = mat.columns[1][0] * scalar;
+        res.columns[1][1] = mat.columns[1][1] * scalar;
+        res.columns[1][2] = mat.columns[1][2] * scalar;
+        res.columns[2][0] = mat.columns[2][0] * scalar;
+        res.columns[2][1] = mat.columns[2][1] * scalar;
+        res.columns[2][2] = mat.columns[2][2] * scalar;
 
         return res;
     }
 
-    // template<std::floating_point F>
-    // inline vec3<F> operator*(const mat3<F>& mat, const vec3<F>& vec) 
-    // {
-    //     vec3<F> res;
-
-    //     res.x = mat.columns[0][0] * vec.x + mat.columns[1][0] * vec.y;
-    //     res.y = mat.columns[0][1] * vec.x + mat.columns[1][1] * vec.y;
-
-    //     return res;
-    // }
+    template<std::floating_point F>
+    constexpr vec3<F> operator*(const mat3<F>& mat, const vec3<F>& vec) 
+    {
+        return vec3<F>(mat.columns[0][0] * vec.x + mat.columns[1][0] * vec.y + mat.columns[2][0] * vec.z,
+                       mat.columns[0][1] * vec.x + mat.columns[1][1] * vec.y + mat.columns[2][1] * vec.z,
+                       mat.columns[0][2] * vec.x + mat.columns[1][2] * vec.y + mat.columns[2][2] * vec.z);
+    }
 
     template<std::floating_point F>
-    inline mat3<F> operator/(const mat3<F>& mat, F scalar) 
+    constexpr mat3<F> operator/(const mat3<F>& mat, F scalar) 
     {
         if (scalar == static_cast<F>(0.0)) return mat;
 
@@ -449,15 +387,15 @@ namespace math
 
         F invScalar = static_cast<F>(1.0) / scalar;
 
-        res.indices[0] = mat.indices[0] * invScalar;
-        res.indices[1] = mat.indices[1] * invScalar;
-        res.indices[2] = mat.indices[2] * invScalar;
-        res.indices[3] = mat.indices[3] * invScalar;
-        res.indices[4] = mat.indices[4] * invScalar;
-        res.indices[5] = mat.indices[5] * invScalar;
-        res.indices[6] = mat.indices[6] * invScalar;
-        res.indices[7] = mat.indices[7] * invScalar;
-        res.indices[8] = mat.indices[8] * invScalar;
+        res.columns[0][0] = mat.columns[0][0] * invScalar;
+        res.columns[0][1] = mat.columns[0][1] * invScalar;
+        res.columns[0][2] = mat.columns[0][2] * invScalar;
+        res.columns[1][0] = mat.columns[1][0] * invScalar;
+        res.columns[1][1] = mat.columns[1][1] * invScalar;
+        res.columns[1][2] = mat.columns[1][2] * invScalar;
+        res.columns[2][0] = mat.columns[2][0] * invScalar;
+        res.columns[2][1] = mat.columns[2][1] * invScalar;
+        res.columns[2][2] = mat.columns[2][2] * invScalar;
 
         return res;
     }
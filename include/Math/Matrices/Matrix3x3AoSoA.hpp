@@ -0,0 +1,96 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Memory\AlignedAllocator.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Vectors\Vector3.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+#include "Math\Matrices\Matrix3x3.hpp"
+
+namespace math
+{
+    // A struct used to store many mat3 as an array of structures of arrays : the matrices are grouped by
+    // blocks of blockWidth (8 for float and 4 for double with AVX, 1 for long double), and a block stores
+    // each of the 9 values of its matrices contiguously, so that a whole block is loaded in 9 SIMD registers.
+    // The last block is padded with identity matrices.
+    //
+    // The static kernels work on a whole block at once, with the closed forms of mat3. The nearly singular
+    // matrices are not branched on, but flagged in a mask of blockWidth bits per block, the bit `lane` of
+    // singular[block] being set for the matrix block * blockWidth + lane. A matrix is nearly singular when
+    // |determinant| <= numeric_limits<F>::epsilon() * the product of the lengths of its columns : the test is
+    // relative, so a matrix scaled by 1e-3 (an inertia tensor, say) is as invertible as the matrix itself,
+    // unlike the absolute math::epsilon threshold of mat3::inverted.
+    // The blocks are split across the threads of math::thread_pool.
+    template<std::floating_point F>
+    struct mat3_aosoa
+    {
+    public:
+        using array = std::vector<F, aligned_allocator<F>>;
+
+        // The number of matrices of a block
+        static constexpr std::size_t blockWidth = simd::pack<F>::width;
+
+    public:
+        // Constructor that returns an empty mat3_aosoa
+        mat3_aosoa();
+        // Constructor that returns a mat3_aosoa of count identity matrices
+        explicit mat3_aosoa(std::size_t count);
+        // Constructor that returns a mat3_aosoa holding a copy of every matrix of mats
+        explicit mat3_aosoa(std::span<const mat3<F>> mats);
+
+        std::size_t size() const;
+        bool empty() const;
+        // Returns the number of blocks, the size of the masks of the kernels
+        std::size_t blockCount() const;
+
+        // The matrices added are identity matrices
+        void resize(std::size_t count);
+        void clear();
+
+        // Returns a copy of the matrix at index i
+        mat3<F> get(std::size_t i) const;
+        // Replaces the matrix at index i
+        void set(std::size_t i, const mat3<F>& mat);
+
+        // Returns the 9 * blockWidth values of a block, for the kernels that work on whole blocks
+        F* blockValues(std::size_t block);
+        const F* blockValues(std::size_t block) const;
+
+        // Writes the determinant of mats[i] in out[i], out holding at least mats.size() values
+        static void determinant(const mat3_aosoa& mats, std::span<F> out);
+
+        // Writes the inverse of every matrix in out, that is resized if needed and can be mats. A nearly singular
+        // matrix is copied as it is. Writes the singular matrices in the masks of
+        // singular, that holds blockCount() masks or is empty, and returns their number
+        static std::size_t inverse(const mat3_aosoa& mats, mat3_aosoa& out, std::span<std::uint32_t> singular);
+
+        // Solves mats[i] * x[i] = b[i] for every i, b holding mats.size() vectors, and x being resized if needed
+        // (it can be b). x[i] is (0.0, 0.0, 0.0) for a singular matrix. Writes the singular matrices in the masks
+        // of singular, that holds blockCount() masks or is empty, and returns their number
+        static std::size_t solve(const mat3_aosoa& mats, const vec3_soa<F>& b, vec3_soa<F>& x, std::span<std::uint32_t> singular);
+
+    private:
+        // Returns the first value of the matrix at index i, the next value of the matrix being blockWidth values further
+        F* valuesOf(std::size_t i);
+        const F* valuesOf(std::size_t i) const;
+
+    private:
+        // The blocks one after another : the value [col][row] of the matrix `lane` of the block b is at
+        // (b * 9 + col * 3 + row) * blockWidth + lane
+        array values;
+        std::size_t count = 0;
+    };
+
+    namespace detail
+    {
+        // The number of blocks a thread processes at least
+        inline constexpr std::size_t mat3BlockChunkSize = 256;
+    }
+}
+
+#include "Math\Matrices\Matrix3x3AoSoA.inl"
@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+
+    #pragma region Container
+
+    template<std::floating_point F>
+    inline mat3_aosoa<F>::mat3_aosoa()
+    {
+    }
+
+    template<std::floating_point F>
+    inline mat3_aosoa<F>::mat3_aosoa(std::size_t count)
+    {
+        resize(count);
+    }
+
+    template<std::floating_point F>
+    inline mat3_aosoa<F>::mat3_aosoa(std::span<const mat3<F>> mats)
+    {
+        resize(mats.size());
+
+        for (std::size_t i = 0; i < mats.size(); i++) set(i, mats[i]);
+    }
+
+    template<std::floating_point F>
+    inline std::size_t mat3_aosoa<F>::size() const
+    {
+        return count;
+    }
+
+    template<std::floating_point F>
+    inline bool mat3_aosoa<F>::empty() const
+    {
+        return count == 0;
+    }
+
+    template<std::floating_point F>
+    inline std::size_t mat3_aosoa<F>::blockCount() const
+    {
+        return (count + blockWidth - 1) / blockWidth;
+    }
+
+    template<std::floating_point F>
+    inline void mat3_aosoa<F>::resize(std::size_t newCount)
+    {
+        std::size_t first = std::min(count, newCount);
+
+        count = newCount;
+        values.resize(blockCount() * 9 * blockWidth);
+
+        // The new matrices, and the padding of the last block
+        for (std::size_t i = first; i < blockCount() * blockWidth; i++) set(i, mat3<F>::identity());
+    }
+
+    template<std::floating_point F>
+    inline void mat3_aosoa<F>::clear()
+    {
+        values.clear();
+        count = 0;
+    }
+
+    template<std::floating_point F>
+    inline F* mat3_aosoa<F>::valuesOf(std::size_t i)
+    {
+        return values.data() + (i / blockWidth) * 9 * blockWidth + i % blockWidth;
+    }
+
+    template<std::floating_point F>
+    inline const F* mat3_aosoa<F>::valuesOf(std::size_t i) const
+    {
+        return values.data() + (i / blockWidth) * 9 * blockWidth + i % blockWidth;
+    }
+
+    template<std::floating_point F>
+    inline F* mat3_aosoa<F>::blockValues(std::size_t block)
+    {
+        return values.data() + block * 9 * blockWidth;
+    }
+
+    template<std::floating_point F>
+    inline const F* mat3_aosoa<F>::blockValues(std::size_t block) const
+    {
+        return values.data() + block * 9 * blockWidth;
+    }
+
+    template<std::floating_point F>
+    inline mat3<F> mat3_aosoa<F>::get(std::size_t i) const
+    {
+        const F* v = valuesOf(i);
+        mat3<F> mat;
+
+        for (std::size_t value = 0; value < 9; value++) mat.columns[value / 3][value % 3] = v[value * blockWidth];
+
+        return mat;
+    }
+
+    template<std::floating_point F>
+    inline void mat3_aosoa<F>::set(std::size_t i, const mat3<F>& mat)
+    {
+        F* v = valuesOf(i);
+
+        for (std::size_t value = 0; value < 9; value++) v[value * blockWidth] = mat.columns[value / 3][value % 3];
+    }
+
+    #pragma endregion Container
+
+    #pragma region StaticMethods
+
+    namespace detail
+    {
+        // The 9 values of a block of matrices, a[col][row] holding that value for every matrix of the block
+        template<typename P>
+        struct mat3_lanes
+        {
+            P a[3][3];
+        };
+
+        template<typename P, std::floating_point F>
+        inline mat3_lanes<P> loadMat3Block(const F* block)
+        {
+            mat3_lanes<P> m;
+
+            for (std::size_t value = 0; value < 9; value++) m.a[value / 3][value % 3] = P::load(block + value * P::width);
+
+            return m;
+        }
+
+        template<typename P, std::floating_point F>
+        inline void storeMat3Block(const mat3_lanes<P>& m, F* block)
+        {
+            for (std::size_t value = 0; value < 9; value++) m.a[value / 3][value % 3].store(block + value * P::width);
+        }
+
+        // Returns the adjugate of m (the transposed comatrix), lane by lane, the same way as mat3::inverted
+        template<typename P>
+        inline mat3_lanes<P> adjugateLanes(const mat3_lanes<P>& m)
+        {
+            const P (&a)[3][3] = m.a;
+            mat3_lanes<P> r;
+
+            r.a[0][0] = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+            r.a[1][0] = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+            r.a[2][0] = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+
+            r.a[0][1] = a[0][2] * a[2][1] - a[0][1] * a[2][2];
+            r.a[1][1] = a[0][0] * a[2][2] - a[0][2] * a[2][0];
+            r.a[2][1] = a[0][1] * a[2][0] - a[0][0] * a[2][1];
+
+            r.a[0][2] = a[0][1] * a[1][2] - a[0][2] * a[1][1];
+            r.a[1][2] = a[0][2] * a[1][0] - a[0][0] * a[1][2];
+            r.a[2][2] = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+
+            return r;
+        }
+
+        // Returns the determinant of m from the first row of its adjugate
+        template<typename P>
+        inline P determinantLanes(const mat3_lanes<P>& m, const mat3_lanes<P>& adjugate)
+        {
+            return simd::madd(m.a[0][0], adjugate.a[0][0], simd::madd(m.a[0][1], adjugate.a[1][0], m.a[0][2] * adjugate.a[2][0]));
+        }
+
+        // Returns the mask of the lanes whose matrix is not nearly singular : |det| must be greater than
+        // numeric_limits<F>::epsilon() times the product of the lengths of the columns, the largest determinant
+        // they can have. The test does not depend on the scale of the matrix. A NaN determinant is not invertible
+        template<std::floating_point F, typename P>
+        inline P invertibleLanes(const mat3_lanes<P>& m, P det)
+        {
+            P lengths = P::broadcast(std::numeric_limits<F>::epsilon());
+
+            // One square root per column rather than one of the product, which could overflow
+            for (std::size_t col = 0; col < 3; col++)
+            {
+                const P (&c)[3] = m.a[col];
+                lengths = lengths * simd::sqrt(simd::madd(c[0], c[0], simd::madd(c[1], c[1], c[2] * c[2])));
+            }
+
+            return simd::cmpGt(simd::abs(det), lengths);
+        }
+
+        // Returns one bit per matrix of the block, set for the singular ones
+        template<typename P>
+        inline std::uint32_t singularBits(P invertible)
+        {
+            return ~simd::moveMask(invertible) & ((1u << P::width) - 1u);
+        }
+
+        // Loads the first laneCount values of in, the other lanes being 0.0
+        template<typename P, std::floating_point F>
+        inline P loadLanes(const F* in, std::size_t laneCount)
+        {
+            if (laneCount == P::width) return P::loadu(in);
+
+            alignas(cacheLineSize) F lanes[P::width] = {};
+            std::copy_n(in, laneCount, lanes);
+
+            return P::load(lanes);
+        }
+
+        // Stores the first laneCount lanes of v to out
+        template<typename P, std::floating_point F>
+        inline void storeLanes(P v, F* out, std::size_t laneCount)
+        {
+            if (laneCount == P::width)
+            {
+                v.storeu(out);
+                return;
+            }
+
+            alignas(cacheLineSize) F lanes[P::width];
+            v.store(lanes);
+            std::copy_n(lanes, laneCount, out);
+        }
+
+        // Calls kernel(block, first, laneCount) on every block of count matrices, across the thread pool, first being
+        // the index of the first matrix of the block and laneCount the number of matrices of the block that are not padding.
+        // Adds up the singular matrices that the kernel returns
+        template<std::size_t BlockWidth, typename Kernel>
+        inline std::size_t forEachMat3Block(std::size_t count, Kernel&& kernel)
+        {
+            std::atomic<std::size_t> singularCount = 0;
+
+            math::parallelFor((count + BlockWidth - 1) / BlockWidth, mat3BlockChunkSize, [&](std::size_t begin, std::size_t end)
+            {
+                std::size_t chunkSingular = 0;
+
+                for (std::size_t block = begin; block < end; block++)
+                {
+                    std::size_t first = block * BlockWidth;
+
+                    chunkSingular += kernel(block, first, std::min(BlockWidth, count - first));
+                }
+
+                singularCount.fetch_add(chunkSingular, std::memory_order_relaxed);
+            });
+
+            return singularCount.load(std::memory_order_relaxed);
+        }
+    }
+
+    template<std::floating_point F>
+    inline void mat3_aosoa<F>::determinant(const mat3_aosoa<F>& mats, std::span<F> out)
+    {
+        using P = simd::pack<F>;
+
+        const F* in = mats.values.data();
+        F* res = out.data();
+
+        detail::forEachMat3Block<blockWidth>(mats.size(), [=](std::size_t block, std::size_t first, std::size_t laneCount)
+        {
+            detail::mat3_lanes<P> m = detail::loadMat3Block<P>(in + block * 9 * blockWidth);
+
+            detail::storeLanes(detail::determinantLanes(m, detail::adjugateLanes(m)), res + first, laneCount);
+
+            return std::size_t(0);
+        });
+    }
+
+    template<std::floating_point F>
+    inline std::size_t mat3_aosoa<F>::inverse(const mat3_aosoa<F>& mats, mat3_aosoa<F>& out, std::span<std::uint32_t> singular)
+    {
+        using P = simd::pack<F>;
+
+        out.resize(mats.size());
+
+        const F* in = mats.values.data();
+        F* res = out.values.data();
+        std::uint32_t* masks = singular.empty() ? nullptr : singular.data();
+
+        return detail::forEachMat3Block<blockWidth>(mats.size(), [=](std::size_t block, std::size_t, std::size_t)
+        {
+            detail::mat3_lanes<P> m = detail::loadMat3Block<P>(in + block * 9 * blockWidth);
+            detail::mat3_lanes<P> adjugate = detail::adjugateLanes(m);
+
+            P det = detail::determinantLanes(m, adjugate);
+            P invertible = detail::invertibleLanes<F>(m, det);
+
+            // The singular lanes divide by 1.0, then keep their matrix
+            P one = P::broadcast(static_cast<F>(1.0));
+            P invDet = one / simd::select(invertible, det, one);
+
+            for (std::size_t value = 0; value < 9; value++)
+            {
+                P& a = adjugate.a[value / 3][value % 3];
+                a = simd::select(invertible, a * invDet, m.a[value / 3][value % 3]);
+            }
+
+            detail::storeMat3Block(adjugate, res + block * 9 * blockWidth);
+
+            std::uint32_t bits = detail::singularBits(invertible);
+            if (masks) masks[block] = bits;
+
+            return static_cast<std::size_t>(std::popcount(bits));
+        });
+    }
+
+    template<std::floating_point F>
+    inline std::size_t mat3_aosoa<F>::solve(const mat3_aosoa<F>& mats, const vec3_soa<F>& b, vec3_soa<F>& x, std::span<std::uint32_t> singular)
+    {
+        using P = simd::pack<F>;
+
+        x.resize(mats.size());
+
+        const F* in = mats.values.data();
+        const F* bx = b.x.data(); const F* by = b.y.data(); const F* bz = b.z.data();
+        F* xx = x.x.data(); F* xy = x.y.data(); F* xz = x.z.data();
+        std::uint32_t* masks = singular.empty() ? nullptr : singular.data();
+
+        return detail::forEachMat3Block<blockWidth>(mats.size(), [=](std::size_t block, std::size_t first, std::size_t laneCount)
+        {
+            detail::mat3_lanes<P> m = detail::loadMat3Block<P>(in + block * 9 * blockWidth);
+            detail::mat3_lanes<P> adjugate = detail::adjugateLanes(m);
+
+            P det = detail::determinantLanes(m, adjugate);
+            P invertible = detail::invertibleLanes<F>(m, det);
+
+            // Cramer's rule : x = adjugate * b / det, the singular lanes dividing by 1.0, then giving 0.0
+            P one = P::broadcast(static_cast<F>(1.0));
+            P invDet = one / simd::select(invertible, det, one);
+
+            P vx = detail::loadLanes<P>(bx + first, laneCount);
+            P vy = detail::loadLanes<P>(by + first, laneCount);
+            P vz = detail::loadLanes<P>(bz + first, laneCount);
+
+            const P (&r)[3][3] = adjugate.a;
+
+            P sx = simd::select(invertible, simd::madd(r[0][0], vx, simd::madd(r[1][0], vy, r[2][0] * vz)) * invDet, P::zero());
+            P sy = simd::select(invertible, simd::madd(r[0][1], vx, simd::madd(r[1][1], vy, r[2][1] * vz)) * invDet, P::zero());
+            P sz = simd::select(invertible, simd::madd(r[0][2], vx, simd::madd(r[1][2], vy, r[2][2] * vz)) * invDet, P::zero());
+
+            detail::storeLanes(sx, xx + first, laneCount);
+            detail::storeLanes(sy, xy + first, laneCount);
+            detail::storeLanes(sz, xz + first, laneCount);
+
+            std::uint32_t bits = detail::singularBits(invertible);
+            if (masks) masks[block] = bits;
+
+            return static_cast<std::size_t>(std::popcount(bits));
+        });
+    }
+
+    #pragma endregion StaticMethods
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+
+#include "Math\Precision.hpp"
+#include "Math\Vectors\Vector3.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+#include "Math\Matrices\Matrix3x3.hpp"
+#include "Math\Matrices\Matrix3x3AoSoA.hpp"
+
+namespace math
+{
+    // Singular value decomposition and polar decomposition of 3x3 matrices, after McAdams et al.,
+    // "Computing the Singular Value Decomposition of 3x3 matrices with minimal branching and elementary
+    // floating point operations" : a fixed number of Jacobi sweeps on mat^T * mat gives V, the columns of
+    // mat * V are sorted by decreasing length, then Givens rotations turn mat * V into U * sigma.
+    //
+    // Every step runs the same instructions whatever the matrix, the choices being made with lane masks,
+    // so the batched versions decompose a whole block of a mat3_aosoa at once, split across the threads of
+    // math::thread_pool. Policy is the precision of the inverse square roots of the rotations.
+    //
+    // U and V are rotations (their determinant is +1), so the smallest singular value is negative when the
+    // determinant of mat is : sigma holds the singular values by decreasing magnitude, and
+    // mat = U * diagonal(sigma) * V^T.
+
+    template<Precision Policy = precise, std::floating_point F>
+    void svd(const mat3<F>& mat, mat3<F>& u, vec3<F>& sigma, mat3<F>& v);
+
+    // Writes mat = rotation * stretch, rotation being the closest rotation to mat and stretch a symmetric
+    // matrix, from the singular value decomposition : rotation = U * V^T and stretch = V * diagonal(sigma) * V^T.
+    // A mat that mirrors space gives a stretch with a negative eigenvalue, rotation remaining a rotation
+    template<Precision Policy = precise, std::floating_point F>
+    void polarDecomposition(const mat3<F>& mat, mat3<F>& rotation, mat3<F>& stretch);
+
+    // Same as svd for every matrix of mats, u, sigma and v being resized if needed
+    template<Precision Policy = precise, std::floating_point F>
+    void svd(const mat3_aosoa<F>& mats, mat3_aosoa<F>& u, vec3_soa<F>& sigma, mat3_aosoa<F>& v);
+
+    // Same as polarDecomposition for every matrix of mats, rotations and stretches being resized if needed
+    // (rotations can be mats)
+    template<Precision Policy = precise, std::floating_point F>
+    void polarDecomposition(const mat3_aosoa<F>& mats, mat3_aosoa<F>& rotations, mat3_aosoa<F>& stretches);
+
+    namespace detail
+    {
+        // The number of Jacobi sweeps, each one rotating the 3 pairs of axes once : below 6 for float and 8 for
+        // double, a few matrices in a thousand are not diagonalized to the precision of F
+        template<std::floating_point F>
+        inline constexpr std::size_t svdSweepCount = sizeof(F) <= 4 ? 6 : 8;
+    }
+}
+
+#include "Math\Matrices\Matrix3x3Decomposition.inl"
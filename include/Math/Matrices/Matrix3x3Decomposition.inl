@@ -0,0 +1,335 @@
+#include <concepts>
+#include <cstddef>
+#include <limits>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    namespace detail
+    {
+        template<Precision Policy, std::floating_point F, typename P>
+        inline P inverseSqrtLanes(P value)
+        {
+            if constexpr (std::same_as<Policy, fast>) return simd::rsqrtFast(value);
+            else return P::broadcast(static_cast<F>(1.0)) / simd::sqrt(value);
+        }
+
+        template<std::floating_point F, typename P>
+        inline mat3_lanes<P> identityLanes()
+        {
+            mat3_lanes<P> m;
+
+            for (std::size_t value = 0; value < 9; value++)
+            {
+                m.a[value / 3][value % 3] = value % 4 == 0 ? P::broadcast(static_cast<F>(1.0)) : P::zero();
+            }
+
+            return m;
+        }
+
+        // Rotates the columns p and q of m : (col p, col q) = (c * col p + s * col q, c * col q - s * col p)
+        template<typename P>
+        inline void rotateColumns(mat3_lanes<P>& m, std::size_t p, std::size_t q, P c, P s)
+        {
+            for (std::size_t k = 0; k < 3; k++)
+            {
+                P mp = m.a[p][k];
+                P mq = m.a[q][k];
+
+                m.a[p][k] = simd::madd(c, mp, s * mq);
+                m.a[q][k] = simd::madd(c, mq, -(s * mp));
+            }
+        }
+
+        // Same as rotateColumns for the rows p and q
+        template<typename P>
+        inline void rotateRows(mat3_lanes<P>& m, std::size_t p, std::size_t q, P c, P s)
+        {
+            for (std::size_t k = 0; k < 3; k++)
+            {
+                P mp = m.a[k][p];
+                P mq = m.a[k][q];
+
+                m.a[k][p] = simd::madd(c, mp, s * mq);
+                m.a[k][q] = simd::madd(c, mq, -(s * mp));
+            }
+        }
+
+        // Returns the cosine and sine of the angle whose half has the direction (ch, sh), (ch, sh) being of length 1
+        template<typename P>
+        inline void doubleAngle(P ch, P sh, P& c, P& s)
+        {
+            c = ch * ch - sh * sh;
+            s = (ch + ch) * sh;
+        }
+
+        // One Jacobi rotation of the symmetric s on the axes p and q, accumulated in v, with the approximate
+        // Givens angle of McAdams et al. : tan(angle / 2) ~ s[p][q] / (2 * (s[p][p] - s[q][q])), or pi / 4
+        // when that approximation would not shrink s[p][q].
+        // An s[p][q] already below the precision of the diagonal is left as it is : the sweeps converge
+        // quadratically, and would otherwise go on squaring it down to denormals, that are very slow to compute with
+        template<Precision Policy, std::floating_point F, typename P>
+        inline void jacobiRotation(mat3_lanes<P>& s, mat3_lanes<P>& v, std::size_t p, std::size_t q)
+        {
+            // (1 + sqrt(2))^2, cos(pi / 8) and sin(pi / 8)
+            constexpr F gamma = static_cast<F>(5.828427124746190);
+            constexpr F cosPi8 = static_cast<F>(0.923879532511287);
+            constexpr F sinPi8 = static_cast<F>(0.382683432365090);
+
+            P diagonal = s.a[p][p] - s.a[q][q];
+            P ch = diagonal + diagonal;
+            P sh = s.a[q][p];
+
+            P negligible = simd::cmpLe(simd::abs(sh), P::broadcast(std::numeric_limits<F>::epsilon()) * simd::abs(ch));
+            P approximate = simd::cmpLt(P::broadcast(gamma) * sh * sh, ch * ch);
+            P w = inverseSqrtLanes<Policy, F>(simd::madd(ch, ch, sh * sh));
+
+            ch = simd::select(approximate, w * ch, P::broadcast(cosPi8));
+            sh = simd::select(approximate, w * sh, P::broadcast(sinPi8));
+
+            ch = simd::select(negligible, P::broadcast(static_cast<F>(1.0)), ch);
+            sh = simd::select(negligible, P::zero(), sh);
+
+            P c, sn;
+            doubleAngle(ch, sh, c, sn);
+
+            // s = G^T * s * G and v = v * G, G rotating the axes p and q
+            rotateRows(s, p, q, c, sn);
+            rotateColumns(s, p, q, c, sn);
+            rotateColumns(v, p, q, c, sn);
+        }
+
+        // Swaps the columns i and j of b and v when the column j of b is the longest, negating one of them so that
+        // v remains a rotation
+        template<typename P>
+        inline void sortColumns(mat3_lanes<P>& b, mat3_lanes<P>& v, P (&lengths)[3], std::size_t i, std::size_t j)
+        {
+            P swap = simd::cmpLt(lengths[i], lengths[j]);
+
+            for (std::size_t k = 0; k < 3; k++)
+            {
+                P bi = b.a[i][k];
+                P bj = b.a[j][k];
+                P vi = v.a[i][k];
+                P vj = v.a[j][k];
+
+                b.a[i][k] = simd::select(swap, bj, bi);
+                b.a[j][k] = simd::select(swap, -bi, bj);
+                v.a[i][k] = simd::select(swap, vj, vi);
+                v.a[j][k] = simd::select(swap, -vi, vj);
+            }
+
+            P li = lengths[i];
+            lengths[i] = simd::select(swap, lengths[j], li);
+            lengths[j] = simd::select(swap, li, lengths[j]);
+        }
+
+        // The Givens rotation of the rows p and q of b that zeroes b[col][q] against the pivot b[col][p], accumulated in u
+        template<Precision Policy, std::floating_point F, typename P>
+        inline void givensRotation(mat3_lanes<P>& b, mat3_lanes<P>& u, std::size_t p, std::size_t q, std::size_t col)
+        {
+            P epsilon = P::broadcast(math::epsilon<F>());
+
+            P pivot = b.a[col][p];
+            P value = b.a[col][q];
+            P rho = simd::sqrt(simd::madd(pivot, pivot, value * value));
+
+            P sh = simd::select(simd::cmpGt(rho, epsilon), value, P::zero());
+            P ch = simd::abs(pivot) + simd::max(rho, epsilon);
+
+            // tan(angle / 2) = value / (pivot + rho) cancels out for a negative pivot, where (pivot + rho) / value does not
+            P negative = simd::cmpLt(pivot, P::zero());
+            P swapped = ch;
+            ch = simd::select(negative, sh, ch);
+            sh = simd::select(negative, swapped, sh);
+
+            P w = inverseSqrtLanes<Policy, F>(simd::madd(ch, ch, sh * sh));
+
+            P c, s;
+            doubleAngle(w * ch, w * sh, c, s);
+
+            // b = G * b and u = u * G^T, so that u * b does not change
+            rotateRows(b, p, q, c, s);
+            rotateColumns(u, p, q, c, s);
+        }
+
+        // The singular value decomposition of a, lane by lane : a = u * diagonal(sigma) * v^T
+        template<Precision Policy, std::floating_point F, typename P>
+        inline void svdLanes(const mat3_lanes<P>& a, mat3_lanes<P>& u, P (&sigma)[3], mat3_lanes<P>& v)
+        {
+            // The eigenvectors of a^T * a are the right singular vectors
+            mat3_lanes<P> s;
+
+            for (std::size_t i = 0; i < 3; i++)
+            {
+                for (std::size_t j = i; j < 3; j++)
+                {
+                    s.a[i][j] = simd::madd(a.a[i][0], a.a[j][0], simd::madd(a.a[i][1], a.a[j][1], a.a[i][2] * a.a[j][2]));
+                    s.a[j][i] = s.a[i][j];
+                }
+            }
+
+            v = identityLanes<F, P>();
+
+            for (std::size_t sweep = 0; sweep < svdSweepCount<F>; sweep++)
+            {
+                jacobiRotation<Policy, F>(s, v, 0, 1);
+                jacobiRotation<Policy, F>(s, v, 0, 2);
+                jacobiRotation<Policy, F>(s, v, 1, 2);
+            }
+
+            // b = a * v, whose columns are the left singular vectors times the singular values
+            mat3_lanes<P> b;
+            P lengths[3];
+
+            for (std::size_t j = 0; j < 3; j++)
+            {
+                for (std::size_t r = 0; r < 3; r++)
+                {
+                    b.a[j][r] = simd::madd(a.a[0][r], v.a[j][0], simd::madd(a.a[1][r], v.a[j][1], a.a[2][r] * v.a[j][2]));
+                }
+
+                lengths[j] = simd::madd(b.a[j][0], b.a[j][0], simd::madd(b.a[j][1], b.a[j][1], b.a[j][2] * b.a[j][2]));
+            }
+
+            sortColumns(b, v, lengths, 0, 1);
+            sortColumns(b, v, lengths, 0, 2);
+            sortColumns(b, v, lengths, 1, 2);
+
+            // The QR decomposition of b : u is left with the rotations, and b with the singular values on its diagonal
+            u = identityLanes<F, P>();
+
+            givensRotation<Policy, F>(b, u, 0, 1, 0);
+            givensRotation<Policy, F>(b, u, 0, 2, 0);
+            givensRotation<Policy, F>(b, u, 1, 2, 1);
+
+            sigma[0] = b.a[0][0];
+            sigma[1] = b.a[1][1];
+            sigma[2] = b.a[2][2];
+        }
+
+        // rotation = u * v^T and stretch = v * diagonal(sigma) * v^T, lane by lane
+        template<typename P>
+        inline void polarLanes(const mat3_lanes<P>& u, const P (&sigma)[3], const mat3_lanes<P>& v, mat3_lanes<P>& rotation, mat3_lanes<P>& stretch)
+        {
+            for (std::size_t col = 0; col < 3; col++)
+            {
+                for (std::size_t row = 0; row < 3; row++)
+                {
+                    rotation.a[col][row] = simd::madd(u.a[0][row], v.a[0][col], simd::madd(u.a[1][row], v.a[1][col], u.a[2][row] * v.a[2][col]));
+                }
+
+                for (std::size_t row = col; row < 3; row++)
+                {
+                    stretch.a[col][row] = simd::madd(v.a[0][row] * sigma[0], v.a[0][col],
+                                          simd::madd(v.a[1][row] * sigma[1], v.a[1][col], v.a[2][row] * sigma[2] * v.a[2][col]));
+                    stretch.a[row][col] = stretch.a[col][row];
+                }
+            }
+        }
+
+        template<std::floating_point F>
+        inline mat3_lanes<simd::scalar_pack<F>> toLanes(const mat3<F>& mat)
+        {
+            mat3_lanes<simd::scalar_pack<F>> m;
+
+            for (std::size_t value = 0; value < 9; value++) m.a[value / 3][value % 3] = { mat.columns[value / 3][value % 3] };
+
+            return m;
+        }
+
+        template<std::floating_point F>
+        inline mat3<F> fromLanes(const mat3_lanes<simd::scalar_pack<F>>& m)
+        {
+            mat3<F> mat;
+
+            for (std::size_t value = 0; value < 9; value++) mat.columns[value / 3][value % 3] = m.a[value / 3][value % 3].v;
+
+            return mat;
+        }
+    }
+
+    template<Precision Policy, std::floating_point F>
+    inline void svd(const mat3<F>& mat, mat3<F>& u, vec3<F>& sigma, mat3<F>& v)
+    {
+        using P = simd::scalar_pack<F>;
+
+        detail::mat3_lanes<P> lanesU, lanesV;
+        P lanesSigma[3];
+
+        detail::svdLanes<Policy, F>(detail::toLanes(mat), lanesU, lanesSigma, lanesV);
+
+        u = detail::fromLanes(lanesU);
+        v = detail::fromLanes(lanesV);
+        sigma = vec3<F>(lanesSigma[0].v, lanesSigma[1].v, lanesSigma[2].v);
+    }
+
+    template<Precision Policy, std::floating_point F>
+    inline void polarDecomposition(const mat3<F>& mat, mat3<F>& rotation, mat3<F>& stretch)
+    {
+        using P = simd::scalar_pack<F>;
+
+        detail::mat3_lanes<P> lanesU, lanesV, lanesRotation, lanesStretch;
+        P lanesSigma[3];
+
+        detail::svdLanes<Policy, F>(detail::toLanes(mat), lanesU, lanesSigma, lanesV);
+        detail::polarLanes(lanesU, lanesSigma, lanesV, lanesRotation, lanesStretch);
+
+        rotation = detail::fromLanes(lanesRotation);
+        stretch = detail::fromLanes(lanesStretch);
+    }
+
+    template<Precision Policy, std::floating_point F>
+    inline void svd(const mat3_aosoa<F>& mats, mat3_aosoa<F>& u, vec3_soa<F>& sigma, mat3_aosoa<F>& v)
+    {
+        using P = simd::pack<F>;
+
+        u.resize(mats.size());
+        v.resize(mats.size());
+        sigma.resize(mats.size());
+
+        F* sx = sigma.x.data(); F* sy = sigma.y.data(); F* sz = sigma.z.data();
+
+        detail::forEachMat3Block<mat3_aosoa<F>::blockWidth>(mats.size(), [&](std::size_t block, std::size_t first, std::size_t laneCount)
+        {
+            detail::mat3_lanes<P> lanesU, lanesV;
+            P lanesSigma[3];
+
+            detail::svdLanes<Policy, F>(detail::loadMat3Block<P>(mats.blockValues(block)), lanesU, lanesSigma, lanesV);
+
+            detail::storeMat3Block(lanesU, u.blockValues(block));
+            detail::storeMat3Block(lanesV, v.blockValues(block));
+            detail::storeLanes(lanesSigma[0], sx + first, laneCount);
+            detail::storeLanes(lanesSigma[1], sy + first, laneCount);
+            detail::storeLanes(lanesSigma[2], sz + first, laneCount);
+
+            return std::size_t(0);
+        });
+    }
+
+    template<Precision Policy, std::floating_point F>
+    inline void polarDecomposition(const mat3_aosoa<F>& mats, mat3_aosoa<F>& rotations, mat3_aosoa<F>& stretches)
+    {
+        using P = simd::pack<F>;
+
+        rotations.resize(mats.size());
+        stretches.resize(mats.size());
+
+        detail::forEachMat3Block<mat3_aosoa<F>::blockWidth>(mats.size(), [&](std::size_t block, std::size_t, std::size_t)
+        {
+            detail::mat3_lanes<P> lanesU, lanesV, lanesRotation, lanesStretch;
+            P lanesSigma[3];
+
+            detail::svdLanes<Policy, F>(detail::loadMat3Block<P>(mats.blockValues(block)), lanesU, lanesSigma, lanesV);
+            detail::polarLanes(lanesU, lanesSigma, lanesV, lanesRotation, lanesStretch);
+
+            detail::storeMat3Block(lanesRotation, rotations.blockValues(block));
+            detail::storeMat3Block(lanesStretch, stretches.blockValues(block));
+
+            return std::size_t(0);
+        });
+    }
+}
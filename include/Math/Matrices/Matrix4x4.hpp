@@ -1,7 +1,15 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
+#include "Math\Concepts.hpp"
+#include "Math\Simd\Simd.hpp"
+#include "Math\Vectors\Vector3.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+#include "Math\Vectors\Vector4.hpp"
 
 namespace math
 {
@@ -16,37 +24,145 @@ namespace math
     struct alignas(16) mat4
     {
     public:
-        union
-        {
-            F indices[16];   // [index] access
-            F columns[4][4]; // [col][row] access
-        };
+        F columns[4][4]; // [col][row] access
         
     public: 
         // stored in column-major
-        mat4(F m00, F m01, F m02, F m03,
+        constexpr mat4(F m00, F m01, F m02, F m03,
              F m10, F m11, F m12, F m13,
              F m20, F m21, F m22, F m23,
              F m30, F m31, F m32, F m33);
 
-        mat4();
+        constexpr mat4();
 
         template<std::floating_point f>
-        mat4<f> toMat() const;
+        constexpr mat4<f> toMat() const;
 
-        static mat4 diagonal(F diagonal);
+        static constexpr mat4 diagonal(F diagonal);
 
-        static mat4 identity();
+        static constexpr mat4 identity();
         
 
-        F& at(int row, int col);
-        F at(int row, int col) const;        
+        template<Number N>
+        constexpr N determinant() const;
+
+        // Inverts the matrix, which is left untouched if it is singular : its determinant is negligible next to the
+        // product of the lengths of its columns (see detail::isNearlySingular), whatever the scale of the matrix
+        constexpr mat4& inverted();
+        constexpr mat4& transposed();
+
+        // Inverts an affine matrix (last row being 0, 0, 0, 1) : the 3x3 part is inverted on its own,
+        // and the translation becomes -inverse(3x3) * translation. Far cheaper than inverted().
+        // The matrix is left untouched if its 3x3 part is singular, tested the same way as in inverted()
+        constexpr mat4& affineInverted();
+        // Inverts a rigid matrix (a rotation and a translation, without scale) : the 3x3 part is
+        // transposed, and the translation becomes -transpose(3x3) * translation. The cheapest of all
+        constexpr mat4& rigidInverted();
+
+        template<std::floating_point f = F>
+        constexpr mat4<f> getInvertedMat() const;
+
+        template<std::floating_point f = F>
+        constexpr mat4<f> getTransposedMat() const;
+
+        template<std::floating_point f = F>
+        constexpr mat4<f> getAffineInvertedMat() const;
+
+        template<std::floating_point f = F>
+        constexpr mat4<f> getRigidInvertedMat() const;
+
+
+        constexpr F& at(int row, int col);
+        constexpr F at(int row, int col) const;        
+
+        // Returns a pointer to the 16 values, in column-major order
+        constexpr const F* valuePtr() const;
+
+        // Returns the point transformed by the matrix, with an implicit w of 1.0 (translation is applied)
+        constexpr vec3<F> transformPoint(const vec3<F>& point) const;
+        // Returns the direction transformed by the matrix, with an implicit w of 0.0 (translation is ignored)
+        constexpr vec3<F> transformDirection(const vec3<F>& direction) const;
+
+        // Bulk versions of operator* (vec4), transformPoint and transformDirection : the vectors are split across
+        // the SIMD lanes and the threads of math::thread_pool. out must hold at least as many vectors as the input
+        // (it is resized for vec3_soa), and can be the input itself.
+
+        // Writes mat * vecs[i] in out[i]
+        static void transform(const mat4& mat, std::span<const vec4<F>> vecs, std::span<vec4<F>> out);
+        // Writes mat.transformPoint(points[i]) in out[i]
+        static void transformPoints(const mat4& mat, std::span<const vec3<F>> points, std::span<vec3<F>> out);
+        // Writes mat.transformDirection(directions[i]) in out[i]
+        static void transformDirections(const mat4& mat, std::span<const vec3<F>> directions, std::span<vec3<F>> out);
+        // Writes mat.transformPoint(points[i]) in out[i]
+        static void transformPoints(const mat4& mat, const vec3_soa<F>& points, vec3_soa<F>& out);
+        // Writes mat.transformDirection(directions[i]) in out[i]
+        static void transformDirections(const mat4& mat, const vec3_soa<F>& directions, vec3_soa<F>& out);
+
+        // Linear blend skinning : the bones of the vertex v are bones[boneIndices[v * N + k]], weighted by
+        // weights[v * N + k], k going from 0 to N - 1 (4 or 8 in most meshes), and the weights of a vertex
+        // summing to 1.0. The weighted sum of the bones is applied to positions[v] as a point, and to
+        // normals[v] as a direction that is normalized afterwards.
+        // The bones of a vertex are blended in SIMD registers, each weight being broadcast and multiplied and
+        // added to the columns of its bone, then applied once. The vertices are split across the threads of
+        // math::thread_pool in chunks of contiguous vertices.
+        // out must hold at least positions.size() vectors, and can be positions itself.
+        template<std::size_t N>
+        static void skin(std::span<const mat4> bones,
+                         std::span<const std::uint16_t> boneIndices, std::span<const F> weights,
+                         std::span<const vec3<F>> positions, std::span<vec3<F>> outPositions);
+        template<std::size_t N>
+        static void skin(std::span<const mat4> bones,
+                         std::span<const std::uint16_t> boneIndices, std::span<const F> weights,
+                         std::span<const vec3<F>> positions, std::span<const vec3<F>> normals,
+                         std::span<vec3<F>> outPositions, std::span<vec3<F>> outNormals);
     };
 
+    // mat4<float> and mat4<double> are specialized in Matrix4x4Simd.inl to keep the columns
+    // in SSE/AVX registers, every other type goes through the scalar path. The specializations
+    // fall back to the scalar path during constant evaluation
+    template<std::floating_point F>
+    constexpr mat4<F> operator*(const mat4<F>& a, const mat4<F>& b);
     template<std::floating_point F>
-    inline mat4<F> operator*(const mat4<F>& a, const mat4<F>& b);
+    constexpr vec4<F> operator*(const mat4<F>& mat, const vec4<F>& vec);
+
+    namespace detail
+    {
+        // The plain scalar implementations, always available whatever the SIMD support is
+        template<std::floating_point F>
+        constexpr mat4<F> multiplyScalar(const mat4<F>& a, const mat4<F>& b);
+        template<std::floating_point F>
+        constexpr vec3<F> transformScalar(const mat4<F>& mat, const vec3<F>& vec, F w);
+        template<std::floating_point F>
+        constexpr vec4<F> transformScalar(const mat4<F>& mat, const vec4<F>& vec);
+        // Writes the inverse of mat in out and returns true, or returns false if mat is singular
+        template<std::floating_point F>
+        constexpr bool invertScalar(const mat4<F>& mat, mat4<F>& out);
+
+        // Returns true if det, the determinant of the Size x Size upper left part of mat, is too small for that part
+        // to be inverted with any precision : |det| <= numeric_limits<F>::epsilon() * the product of the lengths of
+        // its columns, which is the largest determinant they can have (Hadamard's inequality).
+        // The test is relative, so a matrix scaled by 0.01 is as invertible as the matrix itself. It is done on the
+        // squares, without square roots, in double for float so that the product of the squares cannot overflow
+        template<int Size, std::floating_point F>
+        constexpr bool isNearlySingular(const mat4<F>& mat, F det);
+        // Same test from the product of the squared lengths of the columns, already computed
+        template<std::floating_point F>
+        constexpr bool isNearlySingular(F det, std::conditional_t<(sizeof(F) < sizeof(double)), double, F> lengthsSquared);
+
+        // Specialized for float and double in Matrix4x4Simd.inl, like operator*
+        template<std::floating_point F>
+        constexpr vec3<F> transformPoint(const mat4<F>& mat, const vec3<F>& point);
+        template<std::floating_point F>
+        constexpr vec3<F> transformDirection(const mat4<F>& mat, const vec3<F>& direction);
+        // Only specialized for float
+        template<std::floating_point F>
+        constexpr bool invert(const mat4<F>& mat, mat4<F>& out);
 
-    
+        // Writes mat * in[i] in out[i] for the count vectors, on the calling thread.
+        // Only specialized for float, that transforms two vectors per AVX register
+        template<std::floating_point F>
+        inline void transformRange(const mat4<F>& mat, const vec4<F>* in, vec4<F>* out, std::size_t count);
+    }
 
 }
 
@@ -1,46 +1,53 @@
-#include <cmath>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
 
 namespace math
 {
     template<std::floating_point F>
-    inline mat4<F>::mat4(F m00, F m01, F m02, F m03,
+    constexpr mat4<F>::mat4(F m00, F m01, F m02, F m03,
                          F m10, F m11, F m12, F m13,
                          F m20, F m21, F m22, F m23,
                          F m30, F m31, F m32, F m33)
+        : columns{ { m00, m10, m20, m30 },
+                   { m01, m11, m21, m31 },
+                   { m02, m12, m22, m32 },
+                   { m03, m13, m23, m33 } }
     {
-        columns[0][0] = m00; columns[0][1] = m10; columns[0][2] = m20; columns[0][3] = m30;
-        columns[1][0] = m01; columns[1][1] = m11; columns[1][2] = m21; columns[1][3] = m31;
-        columns[2][0] = m02; columns[2][1] = m12; columns[2][2] = m22; columns[2][3] = m32;
-        columns[3][0] = m03; columns[3][1] = m13; columns[3][2] = m23; columns[3][3] = m33;
     }
 
     template<std::floating_point F>
-    inline mat4<F>::mat4()
+    constexpr mat4<F>::mat4() : columns{}
     {
-        for (int i = 0; i < 16; i++)
-        {
-            indices[i] = static_cast<F>(0.0);
-        }
     }
 
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline mat4<f> mat4<F>::toMat() const
+    constexpr mat4<f> mat4<F>::toMat() const
     {
         mat4<f> res;
 
-        for (int i = 0; i < 16; i++)
+        for (int col = 0; col < 4; col++)
         {
-            res.indices[i] = static_cast<f>(indices[i]);
+            for (int row = 0; row < 4; row++)
+            {
+                res.columns[col][row] = static_cast<f>(columns[col][row]);
+            }
         }
 
         return res;
     }
 
     template<std::floating_point F>
-    inline mat4<F> mat4<F>::diagonal(F diagonal)
+    constexpr mat4<F> mat4<F>::diagonal(F diagonal)
     {
         mat4<F> baseMat;
 
@@ -53,7 +60,7 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline mat4<F> mat4<F>::identity()
+    constexpr mat4<F> mat4<F>::identity()
     {
         mat4<F> baseMat;
 
@@ -68,29 +75,566 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline F& mat4<F>::at(int row, int col)
+    template<Number N>
+    constexpr N mat4<F>::determinant() const
+    {
+        // Laplace expansion over the 2x2 sub-determinants of the two first and two last columns
+        const F (&a)[4][4] = columns;
+
+        F s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+        F s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+        F s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+        F s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+        F s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+        F s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+        F c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+        F c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+        F c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+        F c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+        F c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+        F c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+        return static_cast<N>(s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+    }
+
+    template<std::floating_point F>
+    constexpr mat4<F>& mat4<F>::inverted()
+    {
+        mat4<F> res;
+
+        if (detail::invert(*this, res))
+        {
+            *this = res;
+        }
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr mat4<F>& mat4<F>::transposed()
+    {
+        for (int col = 0; col < 4; col++)
+        {
+            for (int row = col + 1; row < 4; row++)
+            {
+                F tmp = columns[col][row];
+                columns[col][row] = columns[row][col];
+                columns[row][col] = tmp;
+            }
+        }
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr mat4<F>& mat4<F>::affineInverted()
+    {
+        // Inverse of the 3x3 part, through its comatrix
+        F m00 = columns[1][1] * columns[2][2] - columns[2][1] * columns[1][2];
+        F m01 = columns[2][1] * columns[0][2] - columns[0][1] * columns[2][2];
+        F m02 = columns[0][1] * columns[1][2] - columns[1][1] * columns[0][2];
+
+        F det = columns[0][0] * m00 + columns[1][0] * m01 + columns[2][0] * m02;
+
+        if (detail::isNearlySingular<3>(*this, det)) return *this;
+
+        F invDet = static_cast<F>(1.0) / det;
+
+        F m10 = columns[2][0] * columns[1][2] - columns[1][0] * columns[2][2];
+        F m11 = columns[0][0] * columns[2][2] - columns[2][0] * columns[0][2];
+        F m12 = columns[1][0] * columns[0][2] - columns[0][0] * columns[1][2];
+
+        F m20 = columns[1][0] * columns[2][1] - columns[2][0] * columns[1][1];
+        F m21 = columns[2][0] * columns[0][1] - columns[0][0] * columns[2][1];
+        F m22 = columns[0][0] * columns[1][1] - columns[1][0] * columns[0][1];
+
+        // Rows of the inverted 3x3 part
+        F r00 = m00 * invDet; F r01 = m10 * invDet; F r02 = m20 * invDet;
+        F r10 = m01 * invDet; F r11 = m11 * invDet; F r12 = m21 * invDet;
+        F r20 = m02 * invDet; F r21 = m12 * invDet; F r22 = m22 * invDet;
+
+        F tx = columns[3][0];
+        F ty = columns[3][1];
+        F tz = columns[3][2];
+
+        // Built whole rather than element by element, so that it is written back with full-width stores
+        *this = mat4<F>(r00, r01, r02, -(r00 * tx + r01 * ty + r02 * tz),
+                        r10, r11, r12, -(r10 * tx + r11 * ty + r12 * tz),
+                        r20, r21, r22, -(r20 * tx + r21 * ty + r22 * tz),
+                        static_cast<F>(0.0), static_cast<F>(0.0), static_cast<F>(0.0), static_cast<F>(1.0));
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr mat4<F>& mat4<F>::rigidInverted()
+    {
+        // The rows of the transposed 3x3 part are its columns
+        const F (&c)[4][4] = columns;
+
+        F tx = c[3][0];
+        F ty = c[3][1];
+        F tz = c[3][2];
+
+        *this = mat4<F>(c[0][0], c[0][1], c[0][2], -(c[0][0] * tx + c[0][1] * ty + c[0][2] * tz),
+                        c[1][0], c[1][1], c[1][2], -(c[1][0] * tx + c[1][1] * ty + c[1][2] * tz),
+                        c[2][0], c[2][1], c[2][2], -(c[2][0] * tx + c[2][1] * ty + c[2][2] * tz),
+                        static_cast<F>(0.0), static_cast<F>(0.0), static_cast<F>(0.0), static_cast<F>(1.0));
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr mat4<f> mat4<F>::getInvertedMat() const
+    {
+        // Written straight into the result, rather than going through a copy and inverted()
+        mat4<F> mat;
+        if (!detail::invert(*this, mat)) mat = *this;
+
+        if constexpr (std::is_same_v<f, F>) return mat;
+        else return mat.template toMat<f>();
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr mat4<f> mat4<F>::getTransposedMat() const
+    {
+        mat4<F> mat = *this;
+        mat.transposed();
+
+        if constexpr (std::is_same_v<f, F>) return mat;
+        else return mat.template toMat<f>();
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr mat4<f> mat4<F>::getAffineInvertedMat() const
+    {
+        mat4<F> mat = *this;
+        mat.affineInverted();
+
+        if constexpr (std::is_same_v<f, F>) return mat;
+        else return mat.template toMat<f>();
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr mat4<f> mat4<F>::getRigidInvertedMat() const
+    {
+        mat4<F> mat = *this;
+        mat.rigidInverted();
+
+        if constexpr (std::is_same_v<f, F>) return mat;
+        else return mat.template toMat<f>();
+    }
+
+    template<std::floating_point F>
+    constexpr F& mat4<F>::at(int row, int col)
     {
         return columns[col][row];
     }
     template<std::floating_point F>
-    inline F mat4<F>::at(int row, int col) const
+    constexpr F mat4<F>::at(int row, int col) const
     {
         return columns[col][row];
     }
 
     template<std::floating_point F>
-    inline mat4<F> operator*(const mat4<F>& a, const mat4<F>& b) 
+    constexpr const F* mat4<F>::valuePtr() const
     {
-        mat4<F> res;
+        return &columns[0][0];
+    }
+
+    template<std::floating_point F>
+    constexpr vec3<F> mat4<F>::transformPoint(const vec3<F>& point) const
+    {
+        return detail::transformPoint(*this, point);
+    }
+
+    template<std::floating_point F>
+    constexpr vec3<F> mat4<F>::transformDirection(const vec3<F>& direction) const
+    {
+        return detail::transformDirection(*this, direction);
+    }
 
-        for (int col = 0; col < 4; col++) 
+    namespace detail
+    {
+        // The number of vectors below which a bulk transform is not worth splitting across threads
+        inline constexpr std::size_t transformChunkSize = 16384;
+
+        // Transforms (vx, vy, vz) by mat, lane by lane, the translation being added if Translate is true (w = 1.0)
+        template<bool Translate, typename P, std::floating_point F>
+        inline void transformLanes(const mat4<F>& mat, P& vx, P& vy, P& vz)
         {
-            res.columns[col][0] = a.columns[0][0] * b.columns[col][0] + a.columns[1][0] * b.columns[col][1] + a.columns[2][0] * b.columns[col][2] + a.columns[3][0] * b.columns[col][3];
-            res.columns[col][1] = a.columns[0][1] * b.columns[col][0] + a.columns[1][1] * b.columns[col][1] + a.columns[2][1] * b.columns[col][2] + a.columns[3][1] * b.columns[col][3];
-            res.columns[col][2] = a.columns[0][2] * b.columns[col][0] + a.columns[1][2] * b.columns[col][1] + a.columns[2][2] * b.columns[col][2] + a.columns[3][2] * b.columns[col][3];
-            res.columns[col][3] = a.columns[0][3] * b.columns[col][0] + a.columns[1][3] * b.columns[col][1] + a.columns[2][3] * b.columns[col][2] + a.columns[3][3] * b.columns[col][3];
+            const F (&c)[4][4] = mat.columns;
+
+            P rx = P::broadcast(c[0][0]) * vx;
+            P ry = P::broadcast(c[0][1]) * vx;
+            P rz = P::broadcast(c[0][2]) * vx;
+
+            rx = simd::madd(P::broadcast(c[1][0]), vy, rx);
+            ry = simd::madd(P::broadcast(c[1][1]), vy, ry);
+            rz = simd::madd(P::broadcast(c[1][2]), vy, rz);
+
+            rx = simd::madd(P::broadcast(c[2][0]), vz, rx);
+            ry = simd::madd(P::broadcast(c[2][1]), vz, ry);
+            rz = simd::madd(P::broadcast(c[2][2]), vz, rz);
+
+            if constexpr (Translate)
+            {
+                rx = rx + P::broadcast(c[3][0]);
+                ry = ry + P::broadcast(c[3][1]);
+                rz = rz + P::broadcast(c[3][2]);
+            }
+
+            vx = rx;
+            vy = ry;
+            vz = rz;
         }
 
-        return res;
+        // Array of vec3 : each vector is transformed on its own, the columns staying in the SIMD registers.
+        // Unlike quat::rotatePoints, going through blocks of SoA on the stack costs more than it saves here
+        template<bool Translate, std::floating_point F>
+        inline void transformVectors(const mat4<F>& mat, const vec3<F>* in, vec3<F>* out, std::size_t count)
+        {
+            math::parallelFor(count, transformChunkSize, [=](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    if constexpr (Translate) out[i] = transformPoint(mat, in[i]);
+                    else out[i] = transformDirection(mat, in[i]);
+                }
+            });
+        }
+
+        template<bool Translate, std::floating_point F>
+        inline void transformVectors(const mat4<F>& mat, const vec3_soa<F>& in, vec3_soa<F>& out)
+        {
+            out.resize(in.size());
+
+            const F* px = in.x.data(); const F* py = in.y.data(); const F* pz = in.z.data();
+            F* ox = out.x.data(); F* oy = out.y.data(); F* oz = out.z.data();
+
+            math::parallelFor(in.size(), transformChunkSize, [=](std::size_t begin, std::size_t end)
+            {
+                simd::forEachPack<F>(begin, end, [&](auto p, std::size_t i)
+                {
+                    using P = decltype(p);
+
+                    P vx = P::loadu(px + i);
+                    P vy = P::loadu(py + i);
+                    P vz = P::loadu(pz + i);
+
+                    transformLanes<Translate>(mat, vx, vy, vz);
+
+                    vx.storeu(ox + i);
+                    vy.storeu(oy + i);
+                    vz.storeu(oz + i);
+                });
+            });
+        }
+    }
+
+    namespace detail
+    {
+        // The number of vertices given to a thread at once by the skinning
+        inline constexpr std::size_t skinningChunkSize = 4096;
+
+        // Returns the sum of the N bones of a vertex, weighted. A matrix is 16 / pack<F>::width packs : each
+        // weight is broadcast once, then multiplied and added to every pack of the sum
+        template<std::size_t N, std::floating_point F>
+        inline mat4<F> blendBones(const mat4<F>* bones, const std::uint16_t* indices, const F* weights)
+        {
+            using P = simd::pack<F>;
+            constexpr std::size_t packCount = 16 / P::width;
+
+            P sum[packCount];
+
+            const F* c0 = &bones[indices[0]].columns[0][0];
+            P w0 = P::broadcast(weights[0]);
+
+            for (std::size_t i = 0; i < packCount; i++) sum[i] = P::loadu(c0 + i * P::width) * w0;
+
+            for (std::size_t k = 1; k < N; k++)
+            {
+                const F* c = &bones[indices[k]].columns[0][0];
+                P w = P::broadcast(weights[k]);
+
+                for (std::size_t i = 0; i < packCount; i++) sum[i] = simd::madd(P::loadu(c + i * P::width), w, sum[i]);
+            }
+
+            mat4<F> res;
+            for (std::size_t i = 0; i < packCount; i++) sum[i].storeu(&res.columns[0][0] + i * P::width);
+
+            return res;
+        }
+
+        // Skins the vertices [begin, end), normals and outNormals being only read when Normals is true.
+        // Blending the bones then transforming once costs less than transforming by every bone, and the
+        // vertices stay an array of structures : moving them to SoA blocks would need the blended bones
+        // to be scattered across the lanes, which costs more than the transforms it would speed up
+        template<std::size_t N, bool Normals, std::floating_point F>
+        inline void skinLinear(const mat4<F>* bones, const std::uint16_t* boneIndices, const F* weights,
+                               const vec3<F>* positions, const vec3<F>* normals, vec3<F>* outPositions, vec3<F>* outNormals,
+                               std::size_t begin, std::size_t end)
+        {
+            for (std::size_t v = begin; v < end; v++)
+            {
+                mat4<F> bone = blendBones<N>(bones, boneIndices + v * N, weights + v * N);
+
+                outPositions[v] = transformPoint(bone, positions[v]);
+
+                if constexpr (Normals)
+                {
+                    // The blend of rotations is not a rotation : the normals are brought back to a length of 1.0
+                    vec3<F> normal = transformDirection(bone, normals[v]);
+                    F lengthSquared = normal.template lengthSquared<F>();
+
+                    outNormals[v] = lengthSquared > static_cast<F>(0.0) ? normal * (static_cast<F>(1.0) / math::sqrt(lengthSquared)) : normal;
+                }
+            }
+        }
+    }
+
+    template<std::floating_point F>
+    inline void mat4<F>::transform(const mat4<F>& mat, std::span<const vec4<F>> vecs, std::span<vec4<F>> out)
+    {
+        const vec4<F>* in = vecs.data();
+        vec4<F>* res = out.data();
+
+        math::parallelFor(vecs.size(), detail::transformChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            detail::transformRange(mat, in + begin, res + begin, end - begin);
+        });
+    }
+
+    template<std::floating_point F>
+    inline void mat4<F>::transformPoints(const mat4<F>& mat, std::span<const vec3<F>> points, std::span<vec3<F>> out)
+    {
+        detail::transformVectors<true>(mat, points.data(), out.data(), points.size());
+    }
+
+    template<std::floating_point F>
+    inline void mat4<F>::transformDirections(const mat4<F>& mat, std::span<const vec3<F>> directions, std::span<vec3<F>> out)
+    {
+        detail::transformVectors<false>(mat, directions.data(), out.data(), directions.size());
+    }
+
+    template<std::floating_point F>
+    inline void mat4<F>::transformPoints(const mat4<F>& mat, const vec3_soa<F>& points, vec3_soa<F>& out)
+    {
+        detail::transformVectors<true>(mat, points, out);
+    }
+
+    template<std::floating_point F>
+    inline void mat4<F>::transformDirections(const mat4<F>& mat, const vec3_soa<F>& directions, vec3_soa<F>& out)
+    {
+        detail::transformVectors<false>(mat, directions, out);
+    }
+
+    template<std::floating_point F>
+    template<std::size_t N>
+    inline void mat4<F>::skin(std::span<const mat4<F>> bones,
+                              std::span<const std::uint16_t> boneIndices, std::span<const F> weights,
+                              std::span<const vec3<F>> positions, std::span<vec3<F>> outPositions)
+    {
+        const mat4<F>* b = bones.data();
+        const std::uint16_t* indices = boneIndices.data();
+        const F* w = weights.data();
+        const vec3<F>* in = positions.data();
+        vec3<F>* out = outPositions.data();
+
+        math::parallelFor(positions.size(), detail::skinningChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            detail::skinLinear<N, false>(b, indices, w, in, static_cast<const vec3<F>*>(nullptr), out, static_cast<vec3<F>*>(nullptr), begin, end);
+        });
+    }
+
+    template<std::floating_point F>
+    template<std::size_t N>
+    inline void mat4<F>::skin(std::span<const mat4<F>> bones,
+                              std::span<const std::uint16_t> boneIndices, std::span<const F> weights,
+                              std::span<const vec3<F>> positions, std::span<const vec3<F>> normals,
+                              std::span<vec3<F>> outPositions, std::span<vec3<F>> outNormals)
+    {
+        const mat4<F>* b = bones.data();
+        const std::uint16_t* indices = boneIndices.data();
+        const F* w = weights.data();
+        const vec3<F>* in = positions.data();
+        const vec3<F>* inNormals = normals.data();
+        vec3<F>* out = outPositions.data();
+        vec3<F>* outN = outNormals.data();
+
+        math::parallelFor(positions.size(), detail::skinningChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            detail::skinLinear<N, true>(b, indices, w, in, inNormals, out, outN, begin, end);
+        });
+    }
+
+    template<std::floating_point F>
+    constexpr mat4<F> operator*(const mat4<F>& a, const mat4<F>& b) 
+    {
+        return detail::multiplyScalar(a, b);
+    }
+
+    template<std::floating_point F>
+    constexpr vec4<F> operator*(const mat4<F>& mat, const vec4<F>& vec)
+    {
+        return detail::transformScalar(mat, vec);
+    }
+
+    namespace detail
+    {
+        template<std::floating_point F>
+        constexpr mat4<F> multiplyScalar(const mat4<F>& a, const mat4<F>& b) 
+        {
+            mat4<F> res;
+
+            for (int col = 0; col < 4; col++) 
+            {
+                res.columns[col][0] = a.columns[0][0] * b.columns[col][0] + a.columns[1][0] * b.columns[col][1] + a.columns[2][0] * b.columns[col][2] + a.columns[3][0] * b.columns[col][3];
+                res.columns[col][1] = a.columns[0][1] * b.columns[col][0] + a.columns[1][1] * b.columns[col][1] + a.columns[2][1] * b.columns[col][2] + a.columns[3][1] * b.columns[col][3];
+                res.columns[col][2] = a.columns[0][2] * b.columns[col][0] + a.columns[1][2] * b.columns[col][1] + a.columns[2][2] * b.columns[col][2] + a.columns[3][2] * b.columns[col][3];
+                res.columns[col][3] = a.columns[0][3] * b.columns[col][0] + a.columns[1][3] * b.columns[col][1] + a.columns[2][3] * b.columns[col][2] + a.columns[3][3] * b.columns[col][3];
+            }
+
+            return res;
+        }
+
+        template<std::floating_point F>
+        constexpr vec3<F> transformScalar(const mat4<F>& mat, const vec3<F>& vec, F w)
+        {
+            return vec3<F>(mat.columns[0][0] * vec.x + mat.columns[1][0] * vec.y + mat.columns[2][0] * vec.z + mat.columns[3][0] * w,
+                           mat.columns[0][1] * vec.x + mat.columns[1][1] * vec.y + mat.columns[2][1] * vec.z + mat.columns[3][1] * w,
+                           mat.columns[0][2] * vec.x + mat.columns[1][2] * vec.y + mat.columns[2][2] * vec.z + mat.columns[3][2] * w);
+        }
+
+        template<std::floating_point F>
+        constexpr vec4<F> transformScalar(const mat4<F>& mat, const vec4<F>& vec)
+        {
+            return vec4<F>(mat.columns[0][0] * vec.x + mat.columns[1][0] * vec.y + mat.columns[2][0] * vec.z + mat.columns[3][0] * vec.w,
+                           mat.columns[0][1] * vec.x + mat.columns[1][1] * vec.y + mat.columns[2][1] * vec.z + mat.columns[3][1] * vec.w,
+                           mat.columns[0][2] * vec.x + mat.columns[1][2] * vec.y + mat.columns[2][2] * vec.z + mat.columns[3][2] * vec.w,
+                           mat.columns[0][3] * vec.x + mat.columns[1][3] * vec.y + mat.columns[2][3] * vec.z + mat.columns[3][3] * vec.w);
+        }
+
+        template<int Size, std::floating_point F>
+        constexpr bool isNearlySingular(const mat4<F>& mat, F det)
+        {
+            using W = std::conditional_t<(sizeof(F) < sizeof(double)), double, F>;
+
+            W lengthsSquared = static_cast<W>(1.0);
+
+            for (int col = 0; col < Size; col++)
+            {
+                W lengthSquared = static_cast<W>(0.0);
+
+                for (int row = 0; row < Size; row++)
+                {
+                    W value = static_cast<W>(mat.columns[col][row]);
+                    lengthSquared += value * value;
+                }
+
+                lengthsSquared *= lengthSquared;
+            }
+
+            return isNearlySingular(det, lengthsSquared);
+        }
+
+        template<std::floating_point F>
+        constexpr bool isNearlySingular(F det, std::conditional_t<(sizeof(F) < sizeof(double)), double, F> lengthsSquared)
+        {
+            using W = decltype(lengthsSquared);
+
+            // Also true when a column is 0.0, both sides being 0.0 then
+            W d = static_cast<W>(det);
+            W tolerance = static_cast<W>(std::numeric_limits<F>::epsilon());
+
+            return d * d <= tolerance * tolerance * lengthsSquared;
+        }
+
+        template<std::floating_point F>
+        constexpr bool invertScalar(const mat4<F>& mat, mat4<F>& out)
+        {
+            // Same expansion as determinant(), the cofactors being built from the same sub-determinants.
+            // Since inverse(transpose(M)) = transpose(inverse(M)), it does not matter whether the
+            // first index is read as the row or as the column, as long as out is written the same way
+            const F (&a)[4][4] = mat.columns;
+
+            F s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+            F s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+            F s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+            F s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+            F s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+            F s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+            F c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+            F c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+            F c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+            F c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+            F c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+            F c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+            F det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+            if (isNearlySingular<4>(mat, det)) return false;
+
+            F invDet = static_cast<F>(1.0) / det;
+
+            F (&b)[4][4] = out.columns;
+
+            b[0][0] = ( a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * invDet;
+            b[0][1] = (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * invDet;
+            b[0][2] = ( a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * invDet;
+            b[0][3] = (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * invDet;
+
+            b[1][0] = (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * invDet;
+            b[1][1] = ( a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * invDet;
+            b[1][2] = (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * invDet;
+            b[1][3] = ( a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * invDet;
+
+            b[2][0] = ( a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * invDet;
+            b[2][1] = (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * invDet;
+            b[2][2] = ( a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * invDet;
+            b[2][3] = (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * invDet;
+
+            b[3][0] = (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * invDet;
+            b[3][1] = ( a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * invDet;
+            b[3][2] = (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * invDet;
+            b[3][3] = ( a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * invDet;
+
+            return true;
+        }
+
+        template<std::floating_point F>
+        constexpr bool invert(const mat4<F>& mat, mat4<F>& out)
+        {
+            return invertScalar(mat, out);
+        }
+
+        template<std::floating_point F>
+        constexpr vec3<F> transformPoint(const mat4<F>& mat, const vec3<F>& point)
+        {
+            return transformScalar(mat, point, static_cast<F>(1.0));
+        }
+
+        template<std::floating_point F>
+        constexpr vec3<F> transformDirection(const mat4<F>& mat, const vec3<F>& direction)
+        {
+            return transformScalar(mat, direction, static_cast<F>(0.0));
+        }
+
+        template<std::floating_point F>
+        inline void transformRange(const mat4<F>& mat, const vec4<F>* in, vec4<F>* out, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                out[i] = mat * in[i];
+            }
+        }
     }
 }
+
+#include "Math\Matrices\Matrix4x4Simd.inl"
\ No newline at end of file
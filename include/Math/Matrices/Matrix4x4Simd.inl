@@ -0,0 +1,478 @@
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Simd.hpp"
+
+// SSE/AVX specializations of the mat4 products, for mat4<float> and mat4<double>.
+// Every column of a mat4 is 4 contiguous values, so a column fits in one __m128 (float)
+// or one __m256d (double), and a product is just 4 broadcasts and 4 multiply-adds per column.
+// mat4<float> also gets an SSE general inverse, mat4<double> keeps the scalar one.
+// mat4 * vec4 is the same combination, vec4 being laid out like a column.
+
+#if defined(MATH_SIMD_SSE)
+
+namespace math
+{
+    namespace detail
+    {
+        #pragma region Helpers
+
+        inline __m128 madd(__m128 a, __m128 b, __m128 c)
+        {
+        #if defined(MATH_SIMD_FMA)
+            return _mm_fmadd_ps(a, b, c);
+        #else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+        #endif
+        }
+
+        inline __m128d madd(__m128d a, __m128d b, __m128d c)
+        {
+        #if defined(MATH_SIMD_FMA)
+            return _mm_fmadd_pd(a, b, c);
+        #else
+            return _mm_add_pd(_mm_mul_pd(a, b), c);
+        #endif
+        }
+
+        #if defined(MATH_SIMD_AVX)
+
+        inline __m256 madd(__m256 a, __m256 b, __m256 c)
+        {
+        #if defined(MATH_SIMD_FMA)
+            return _mm256_fmadd_ps(a, b, c);
+        #else
+            return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+        #endif
+        }
+
+        inline __m256d madd(__m256d a, __m256d b, __m256d c)
+        {
+        #if defined(MATH_SIMD_FMA)
+            return _mm256_fmadd_pd(a, b, c);
+        #else
+            return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+        #endif
+        }
+
+        #endif
+
+        #pragma endregion Helpers
+
+        #pragma region Float
+
+        // Returns c0 * x + c1 * y + c2 * z + c3 * w, c0 to c3 being the 4 columns of a matrix
+        inline __m128 combineColumns(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 x, __m128 y, __m128 z, __m128 w)
+        {
+            return madd(c3, w, madd(c2, z, madd(c1, y, _mm_mul_ps(c0, x))));
+        }
+
+        // Returns the 4 columns combined with the 4 components of v
+        inline __m128 combineColumns(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 v)
+        {
+            return combineColumns(c0, c1, c2, c3,
+                                  _mm_shuffle_ps(v, v, 0x00),
+                                  _mm_shuffle_ps(v, v, 0x55),
+                                  _mm_shuffle_ps(v, v, 0xAA),
+                                  _mm_shuffle_ps(v, v, 0xFF));
+        }
+
+        #if defined(MATH_SIMD_AVX)
+
+        // Same as above, but on two vectors at once : each 128 bits half of c0 to c3 holds a copy
+        // of the same column, and each half of v holds one of the two vectors
+        inline __m256 combineColumns(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v)
+        {
+            __m256 r = _mm256_mul_ps(c0, _mm256_shuffle_ps(v, v, 0x00));
+            r = madd(c1, _mm256_shuffle_ps(v, v, 0x55), r);
+            r = madd(c2, _mm256_shuffle_ps(v, v, 0xAA), r);
+            return madd(c3, _mm256_shuffle_ps(v, v, 0xFF), r);
+        }
+
+        #endif
+
+        inline mat4<float> multiplySimd(const mat4<float>& a, const mat4<float>& b)
+        {
+            mat4<float> res;
+
+        #if defined(MATH_SIMD_AVX)
+            // Each half of a __m256 holds a copy of one column of a, so two columns of
+            // the result are computed at once
+            __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a.columns[0][0]));
+            __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a.columns[1][0]));
+            __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a.columns[2][0]));
+            __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a.columns[3][0]));
+
+            __m256 b01 = _mm256_loadu_ps(&b.columns[0][0]);
+            __m256 b23 = _mm256_loadu_ps(&b.columns[2][0]);
+
+            _mm256_storeu_ps(&res.columns[0][0], combineColumns(a0, a1, a2, a3, b01));
+            _mm256_storeu_ps(&res.columns[2][0], combineColumns(a0, a1, a2, a3, b23));
+        #else
+            __m128 a0 = _mm_load_ps(&a.columns[0][0]);
+            __m128 a1 = _mm_load_ps(&a.columns[1][0]);
+            __m128 a2 = _mm_load_ps(&a.columns[2][0]);
+            __m128 a3 = _mm_load_ps(&a.columns[3][0]);
+
+            _mm_store_ps(&res.columns[0][0], combineColumns(a0, a1, a2, a3, _mm_load_ps(&b.columns[0][0])));
+            _mm_store_ps(&res.columns[1][0], combineColumns(a0, a1, a2, a3, _mm_load_ps(&b.columns[1][0])));
+            _mm_store_ps(&res.columns[2][0], combineColumns(a0, a1, a2, a3, _mm_load_ps(&b.columns[2][0])));
+            _mm_store_ps(&res.columns[3][0], combineColumns(a0, a1, a2, a3, _mm_load_ps(&b.columns[3][0])));
+        #endif
+
+            return res;
+        }
+
+        inline vec3<float> transformSimd(const mat4<float>& mat, const vec3<float>& vec, float w)
+        {
+            __m128 r = combineColumns(_mm_load_ps(&mat.columns[0][0]),
+                                      _mm_load_ps(&mat.columns[1][0]),
+                                      _mm_load_ps(&mat.columns[2][0]),
+                                      _mm_load_ps(&mat.columns[3][0]),
+                                      _mm_set1_ps(vec.x), _mm_set1_ps(vec.y), _mm_set1_ps(vec.z), _mm_set1_ps(w));
+
+            alignas(16) float res[4];
+            _mm_store_ps(res, r);
+
+            return vec3<float>(res[0], res[1], res[2]);
+        }
+
+        // vec4<float> is 16 bytes aligned, so it is loaded and stored as is
+        inline vec4<float> transformSimd(const mat4<float>& mat, const vec4<float>& vec)
+        {
+            vec4<float> res;
+
+            _mm_store_ps(&res.x, combineColumns(_mm_load_ps(&mat.columns[0][0]),
+                                                _mm_load_ps(&mat.columns[1][0]),
+                                                _mm_load_ps(&mat.columns[2][0]),
+                                                _mm_load_ps(&mat.columns[3][0]),
+                                                _mm_load_ps(&vec.x)));
+
+            return res;
+        }
+
+        inline void transformRangeSimd(const mat4<float>& mat, const vec4<float>* in, vec4<float>* out, std::size_t count)
+        {
+            __m128 c0 = _mm_load_ps(&mat.columns[0][0]);
+            __m128 c1 = _mm_load_ps(&mat.columns[1][0]);
+            __m128 c2 = _mm_load_ps(&mat.columns[2][0]);
+            __m128 c3 = _mm_load_ps(&mat.columns[3][0]);
+
+            std::size_t i = 0;
+
+        #if defined(MATH_SIMD_AVX)
+            // Two vectors per register, as in multiplySimd. A pair of vec4 is only 16 bytes aligned
+            __m256 w0 = _mm256_set_m128(c0, c0);
+            __m256 w1 = _mm256_set_m128(c1, c1);
+            __m256 w2 = _mm256_set_m128(c2, c2);
+            __m256 w3 = _mm256_set_m128(c3, c3);
+
+            for (; i + 2 <= count; i += 2)
+            {
+                _mm256_storeu_ps(&out[i].x, combineColumns(w0, w1, w2, w3, _mm256_loadu_ps(&in[i].x)));
+            }
+        #endif
+
+            for (; i < count; i++)
+            {
+                _mm_store_ps(&out[i].x, combineColumns(c0, c1, c2, c3, _mm_load_ps(&in[i].x)));
+            }
+        }
+
+        // Shuffles used by the block inverse : swizzle picks the lanes of one vector, and
+        // shuffle picks x and y from a, and z and w from b
+        #define MATH_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+        #define MATH_SWIZZLE(v, x, y, z, w) _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), MATH_SHUFFLE_MASK(x, y, z, w)))
+        #define MATH_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, MATH_SHUFFLE_MASK(x, y, z, w))
+
+        // Each __m128 below holds a 2x2 matrix (m00, m01, m10, m11)
+
+        // Returns a * b
+        inline __m128 mat2Mul(__m128 a, __m128 b)
+        {
+            return _mm_add_ps(_mm_mul_ps(a, MATH_SWIZZLE(b, 0, 3, 0, 3)),
+                              _mm_mul_ps(MATH_SWIZZLE(a, 1, 0, 3, 2), MATH_SWIZZLE(b, 2, 1, 2, 1)));
+        }
+
+        // Returns adjugate(a) * b
+        inline __m128 mat2AdjMul(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(MATH_SWIZZLE(a, 3, 3, 0, 0), b),
+                              _mm_mul_ps(MATH_SWIZZLE(a, 1, 1, 2, 2), MATH_SWIZZLE(b, 2, 3, 0, 1)));
+        }
+
+        // Returns a * adjugate(b)
+        inline __m128 mat2MulAdj(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(a, MATH_SWIZZLE(b, 3, 0, 3, 0)),
+                              _mm_mul_ps(MATH_SWIZZLE(a, 1, 0, 3, 2), MATH_SWIZZLE(b, 2, 1, 2, 1)));
+        }
+
+        // General inverse by 2x2 blocks : with M = (A B / C D), every block of the inverse is built
+        // from the adjugates of the blocks, and det(M) = |A||D| + |B||C| - tr(adj(A)B adj(D)C).
+        // As for invertScalar, reading the columns as rows gives the transposed inverse, stored the same way.
+        inline bool invertSimd(const mat4<float>& mat, mat4<float>& out)
+        {
+            __m128 c0 = _mm_load_ps(&mat.columns[0][0]);
+            __m128 c1 = _mm_load_ps(&mat.columns[1][0]);
+            __m128 c2 = _mm_load_ps(&mat.columns[2][0]);
+            __m128 c3 = _mm_load_ps(&mat.columns[3][0]);
+
+            __m128 a = _mm_movelh_ps(c0, c1);
+            __m128 b = _mm_movehl_ps(c1, c0);
+            __m128 c = _mm_movelh_ps(c2, c3);
+            __m128 d = _mm_movehl_ps(c3, c2);
+
+            // (|A|, |B|, |C|, |D|)
+            __m128 detSub = _mm_sub_ps(_mm_mul_ps(MATH_SHUFFLE(c0, c2, 0, 2, 0, 2), MATH_SHUFFLE(c1, c3, 1, 3, 1, 3)),
+                                       _mm_mul_ps(MATH_SHUFFLE(c0, c2, 1, 3, 1, 3), MATH_SHUFFLE(c1, c3, 0, 2, 0, 2)));
+
+            __m128 detA = MATH_SWIZZLE(detSub, 0, 0, 0, 0);
+            __m128 detB = MATH_SWIZZLE(detSub, 1, 1, 1, 1);
+            __m128 detC = MATH_SWIZZLE(detSub, 2, 2, 2, 2);
+            __m128 detD = MATH_SWIZZLE(detSub, 3, 3, 3, 3);
+
+            __m128 dc = mat2AdjMul(d, c);
+            __m128 ab = mat2AdjMul(a, b);
+
+            __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc));
+            __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, ab));
+            __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, ab));
+            __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));
+
+            __m128 tr = _mm_mul_ps(ab, MATH_SWIZZLE(dc, 0, 2, 1, 3));
+            tr = _mm_add_ps(tr, MATH_SWIZZLE(tr, 2, 3, 0, 1));
+            tr = _mm_add_ps(tr, MATH_SWIZZLE(tr, 1, 0, 3, 2));
+
+            __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+            // The squared lengths of the columns, multiplied together in double as in isNearlySingular<4>
+            __m128 l0 = _mm_mul_ps(c0, c0);
+            __m128 l1 = _mm_mul_ps(c1, c1);
+            __m128 l2 = _mm_mul_ps(c2, c2);
+            __m128 l3 = _mm_mul_ps(c3, c3);
+            _MM_TRANSPOSE4_PS(l0, l1, l2, l3);
+
+            __m128 lengths = _mm_add_ps(_mm_add_ps(l0, l1), _mm_add_ps(l2, l3));
+            __m128d lengthPairs = _mm_mul_pd(_mm_cvtps_pd(lengths), _mm_cvtps_pd(_mm_movehl_ps(lengths, lengths)));
+            __m128d lengthsSquared = _mm_mul_sd(lengthPairs, _mm_unpackhi_pd(lengthPairs, lengthPairs));
+
+            if (isNearlySingular(_mm_cvtss_f32(det), _mm_cvtsd_f64(lengthsSquared))) return false;
+
+            __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+
+            x = _mm_mul_ps(x, invDet);
+            y = _mm_mul_ps(y, invDet);
+            z = _mm_mul_ps(z, invDet);
+            w = _mm_mul_ps(w, invDet);
+
+            // The adjugate of each block and the reassembly are done by the same shuffles
+            _mm_store_ps(&out.columns[0][0], MATH_SHUFFLE(x, y, 3, 1, 3, 1));
+            _mm_store_ps(&out.columns[1][0], MATH_SHUFFLE(x, y, 2, 0, 2, 0));
+            _mm_store_ps(&out.columns[2][0], MATH_SHUFFLE(z, w, 3, 1, 3, 1));
+            _mm_store_ps(&out.columns[3][0], MATH_SHUFFLE(z, w, 2, 0, 2, 0));
+
+            return true;
+        }
+
+        #undef MATH_SHUFFLE
+        #undef MATH_SWIZZLE
+        #undef MATH_SHUFFLE_MASK
+
+        #pragma endregion Float
+
+        #pragma region Double
+
+        #if defined(MATH_SIMD_AVX)
+
+        inline __m256d combineColumns(__m256d c0, __m256d c1, __m256d c2, __m256d c3, __m256d x, __m256d y, __m256d z, __m256d w)
+        {
+            return madd(c3, w, madd(c2, z, madd(c1, y, _mm256_mul_pd(c0, x))));
+        }
+
+        inline __m256d combineColumns(__m256d c0, __m256d c1, __m256d c2, __m256d c3, const double* v)
+        {
+            return combineColumns(c0, c1, c2, c3, _mm256_broadcast_sd(&v[0]), _mm256_broadcast_sd(&v[1]), _mm256_broadcast_sd(&v[2]), _mm256_broadcast_sd(&v[3]));
+        }
+
+        inline mat4<double> multiplySimd(const mat4<double>& a, const mat4<double>& b)
+        {
+            mat4<double> res;
+
+            // mat4<double> is only 16 bytes aligned, hence the unaligned loads and stores
+            __m256d a0 = _mm256_loadu_pd(&a.columns[0][0]);
+            __m256d a1 = _mm256_loadu_pd(&a.columns[1][0]);
+            __m256d a2 = _mm256_loadu_pd(&a.columns[2][0]);
+            __m256d a3 = _mm256_loadu_pd(&a.columns[3][0]);
+
+            _mm256_storeu_pd(&res.columns[0][0], combineColumns(a0, a1, a2, a3, b.columns[0]));
+            _mm256_storeu_pd(&res.columns[1][0], combineColumns(a0, a1, a2, a3, b.columns[1]));
+            _mm256_storeu_pd(&res.columns[2][0], combineColumns(a0, a1, a2, a3, b.columns[2]));
+            _mm256_storeu_pd(&res.columns[3][0], combineColumns(a0, a1, a2, a3, b.columns[3]));
+
+            return res;
+        }
+
+        inline vec3<double> transformSimd(const mat4<double>& mat, const vec3<double>& vec, double w)
+        {
+            __m256d r = combineColumns(_mm256_loadu_pd(&mat.columns[0][0]),
+                                       _mm256_loadu_pd(&mat.columns[1][0]),
+                                       _mm256_loadu_pd(&mat.columns[2][0]),
+                                       _mm256_loadu_pd(&mat.columns[3][0]),
+                                       _mm256_set1_pd(vec.x), _mm256_set1_pd(vec.y), _mm256_set1_pd(vec.z), _mm256_set1_pd(w));
+
+            alignas(32) double res[4];
+            _mm256_store_pd(res, r);
+
+            return vec3<double>(res[0], res[1], res[2]);
+        }
+
+        // vec4<double> is 32 bytes aligned, so it is stored as is
+        inline vec4<double> transformSimd(const mat4<double>& mat, const vec4<double>& vec)
+        {
+            vec4<double> res;
+
+            _mm256_store_pd(&res.x, combineColumns(_mm256_loadu_pd(&mat.columns[0][0]),
+                                                   _mm256_loadu_pd(&mat.columns[1][0]),
+                                                   _mm256_loadu_pd(&mat.columns[2][0]),
+                                                   _mm256_loadu_pd(&mat.columns[3][0]),
+                                                   &vec.x));
+
+            return res;
+        }
+
+        #else
+
+        // Without AVX a column of doubles is split in two __m128d : rows 0-1 (lo) and rows 2-3 (hi)
+        inline void combineColumns(const mat4<double>& mat, const double* v, double* out)
+        {
+            __m128d x = _mm_set1_pd(v[0]);
+            __m128d y = _mm_set1_pd(v[1]);
+            __m128d z = _mm_set1_pd(v[2]);
+            __m128d w = _mm_set1_pd(v[3]);
+
+            __m128d lo = _mm_mul_pd(_mm_load_pd(&mat.columns[0][0]), x);
+            __m128d hi = _mm_mul_pd(_mm_load_pd(&mat.columns[0][2]), x);
+            lo = madd(_mm_load_pd(&mat.columns[1][0]), y, lo);
+            hi = madd(_mm_load_pd(&mat.columns[1][2]), y, hi);
+            lo = madd(_mm_load_pd(&mat.columns[2][0]), z, lo);
+            hi = madd(_mm_load_pd(&mat.columns[2][2]), z, hi);
+            lo = madd(_mm_load_pd(&mat.columns[3][0]), w, lo);
+            hi = madd(_mm_load_pd(&mat.columns[3][2]), w, hi);
+
+            _mm_storeu_pd(&out[0], lo);
+            _mm_storeu_pd(&out[2], hi);
+        }
+
+        inline mat4<double> multiplySimd(const mat4<double>& a, const mat4<double>& b)
+        {
+            mat4<double> res;
+
+            combineColumns(a, b.columns[0], res.columns[0]);
+            combineColumns(a, b.columns[1], res.columns[1]);
+            combineColumns(a, b.columns[2], res.columns[2]);
+            combineColumns(a, b.columns[3], res.columns[3]);
+
+            return res;
+        }
+
+        inline vec3<double> transformSimd(const mat4<double>& mat, const vec3<double>& vec, double w)
+        {
+            const double v[4] = { vec.x, vec.y, vec.z, w };
+            double res[4];
+
+            combineColumns(mat, v, res);
+
+            return vec3<double>(res[0], res[1], res[2]);
+        }
+
+        inline vec4<double> transformSimd(const mat4<double>& mat, const vec4<double>& vec)
+        {
+            vec4<double> res;
+
+            combineColumns(mat, &vec.x, &res.x);
+
+            return res;
+        }
+
+        #endif
+
+        #pragma endregion Double
+
+        #pragma region Specializations
+
+        template<>
+        constexpr bool invert<float>(const mat4<float>& mat, mat4<float>& out)
+        {
+            if (std::is_constant_evaluated()) return invertScalar(mat, out);
+            return invertSimd(mat, out);
+        }
+
+        template<>
+        constexpr vec3<float> transformPoint<float>(const mat4<float>& mat, const vec3<float>& point)
+        {
+            if (std::is_constant_evaluated()) return transformScalar(mat, point, 1.0f);
+            return transformSimd(mat, point, 1.0f);
+        }
+        template<>
+        constexpr vec3<float> transformDirection<float>(const mat4<float>& mat, const vec3<float>& direction)
+        {
+            if (std::is_constant_evaluated()) return transformScalar(mat, direction, 0.0f);
+            return transformSimd(mat, direction, 0.0f);
+        }
+
+        template<>
+        constexpr vec3<double> transformPoint<double>(const mat4<double>& mat, const vec3<double>& point)
+        {
+            if (std::is_constant_evaluated()) return transformScalar(mat, point, 1.0);
+            return transformSimd(mat, point, 1.0);
+        }
+        template<>
+        constexpr vec3<double> transformDirection<double>(const mat4<double>& mat, const vec3<double>& direction)
+        {
+            if (std::is_constant_evaluated()) return transformScalar(mat, direction, 0.0);
+            return transformSimd(mat, direction, 0.0);
+        }
+
+        template<>
+        inline void transformRange<float>(const mat4<float>& mat, const vec4<float>* in, vec4<float>* out, std::size_t count)
+        {
+            transformRangeSimd(mat, in, out, count);
+        }
+
+        #pragma endregion Specializations
+    }
+
+    template<>
+    constexpr mat4<float> operator*(const mat4<float>& a, const mat4<float>& b)
+    {
+        if (std::is_constant_evaluated()) return detail::multiplyScalar(a, b);
+        return detail::multiplySimd(a, b);
+    }
+
+    template<>
+    constexpr mat4<double> operator*(const mat4<double>& a, const mat4<double>& b)
+    {
+        if (std::is_constant_evaluated()) return detail::multiplyScalar(a, b);
+        return detail::multiplySimd(a, b);
+    }
+
+    template<>
+    constexpr vec4<float> operator*(const mat4<float>& mat, const vec4<float>& vec)
+    {
+        if (std::is_constant_evaluated()) return detail::transformScalar(mat, vec);
+        return detail::transformSimd(mat, vec);
+    }
+
+    template<>
+    constexpr vec4<double> operator*(const mat4<double>& mat, const vec4<double>& vec)
+    {
+        if (std::is_constant_evaluated()) return detail::transformScalar(mat, vec);
+        return detail::transformSimd(mat, vec);
+    }
+}
+
+#endif
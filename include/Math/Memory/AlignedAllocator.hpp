@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace math
+{
+    // The size of a cache line, and the alignment given to every bulk buffer of the library
+    inline constexpr std::size_t cacheLineSize = 64;
+
+    // A std::allocator replacement that aligns every allocation on Alignment bytes, so that
+    // std::vector<F, aligned_allocator<F>> can be read with aligned SIMD loads
+    template<typename T, std::size_t Alignment = cacheLineSize>
+    struct aligned_allocator
+    {
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+    public:
+        aligned_allocator() = default;
+
+        template<typename U>
+        aligned_allocator(const aligned_allocator<U, Alignment>&) {}
+
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* ptr, std::size_t)
+        {
+            ::operator delete(ptr, std::align_val_t(Alignment));
+        }
+    };
+
+    template<typename T, typename U, std::size_t Alignment>
+    inline bool operator==(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) { return true; }
+    template<typename T, typename U, std::size_t Alignment>
+    inline bool operator!=(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) { return false; }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "Math\Memory\AlignedAllocator.hpp"
+
+namespace math
+{
+    // A pool of blocks of the same size, for buffers that are acquired and released in any order, such as
+    // the buffers of the objects that come and go : acquire() and release() are O(1), and reset() gives every
+    // block back at once, in O(1).
+    //
+    // Every block starts on a cache line and is padded to a whole number of cache lines. A released block
+    // keeps the index of the next free one in its first bytes, so the pool needs no memory besides its blocks.
+    // As with frame_arena, the objects are never destroyed, only trivially destructible types are allowed, and
+    // the pool is not thread-safe. It is move-only, the blocks being freed by the destructor
+    template<typename T>
+    class block_pool
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "The pool never destroys its objects");
+        static_assert(alignof(T) <= cacheLineSize, "The blocks are aligned on a cache line");
+
+    public:
+        // Constructor that returns a pool without any block
+        block_pool() = default;
+
+        // Constructor that returns a pool of blockCount blocks, each holding blockSize objects
+        block_pool(std::size_t blockSize, std::size_t blockCount) :
+            objectsPerBlock(blockSize),
+            stride((std::max<std::size_t>(blockSize * sizeof(T), 1) + cacheLineSize - 1) & ~(cacheLineSize - 1)),
+            blocks(static_cast<std::uint32_t>(blockCount))
+        {
+            buffer = static_cast<std::byte*>(::operator new(stride * blocks, std::align_val_t(cacheLineSize)));
+        }
+
+        block_pool(const block_pool&) = delete;
+        block_pool& operator=(const block_pool&) = delete;
+
+        block_pool(block_pool&& other) noexcept
+        {
+            *this = std::move(other);
+        }
+
+        block_pool& operator=(block_pool&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (buffer != nullptr) ::operator delete(buffer, std::align_val_t(cacheLineSize));
+
+                buffer = std::exchange(other.buffer, nullptr);
+                objectsPerBlock = std::exchange(other.objectsPerBlock, 0);
+                stride = std::exchange(other.stride, 0);
+                blocks = std::exchange(other.blocks, 0);
+                nextUnused = std::exchange(other.nextUnused, 0);
+                freeHead = std::exchange(other.freeHead, noBlock);
+            }
+
+            return *this;
+        }
+
+        ~block_pool()
+        {
+            if (buffer != nullptr) ::operator delete(buffer, std::align_val_t(cacheLineSize));
+        }
+
+        // Returns a block of blockSize() default-initialized objects, or an empty span if every block is in use
+        std::span<T> acquire()
+        {
+            std::uint32_t block;
+
+            if (freeHead != noBlock)
+            {
+                block = freeHead;
+                std::memcpy(&freeHead, buffer + block * stride, sizeof(freeHead));
+            }
+            else if (nextUnused < blocks)
+            {
+                block = nextUnused++;
+            }
+            else
+            {
+                return {};
+            }
+
+            T* objects = reinterpret_cast<T*>(buffer + block * stride);
+            std::uninitialized_default_construct_n(objects, objectsPerBlock);
+
+            return std::span<T>(objects, objectsPerBlock);
+        }
+
+        // Gives back a block returned by acquire(), that must not be used anymore
+        void release(std::span<T> block)
+        {
+            std::byte* bytes = reinterpret_cast<std::byte*>(block.data());
+
+            std::memcpy(bytes, &freeHead, sizeof(freeHead));
+            freeHead = static_cast<std::uint32_t>((bytes - buffer) / stride);
+        }
+
+        // Gives every block back, the spans returned until now becoming invalid
+        void reset()
+        {
+            nextUnused = 0;
+            freeHead = noBlock;
+        }
+
+        std::size_t blockSize() const { return objectsPerBlock; }
+        std::size_t blockCount() const { return blocks; }
+
+    private:
+        static constexpr std::uint32_t noBlock = 0xFFFFFFFFu;
+
+        std::byte* buffer = nullptr;
+        std::size_t objectsPerBlock = 0;
+        // The distance between two blocks, in bytes
+        std::size_t stride = 0;
+        std::uint32_t blocks = 0;
+
+        // The blocks from nextUnused on have not been acquired since the last reset
+        std::uint32_t nextUnused = 0;
+        // The last released block, the head of the list of free blocks
+        std::uint32_t freeHead = noBlock;
+    };
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "Math\Memory\AlignedAllocator.hpp"
+
+namespace math
+{
+    // A linear allocator over a single buffer, for the temporary buffers of a frame : an allocation only moves
+    // an offset forward, and reset() gives the whole buffer back at once, in O(1).
+    //
+    // Every allocation starts on an address aligned on Alignment bytes (a cache line by default, or any power
+    // of 2, the bytes skipped to reach a larger one being lost until the reset) and is padded to a whole
+    // number of cache lines, so two buffers never share a line and can be written by different threads.
+    // The objects are never destroyed, so only trivially destructible types can be allocated, which every
+    // vector and matrix of the library is. The arena is not thread-safe, see per_thread_arena.
+    // It is move-only, the buffer being freed by the destructor
+    class frame_arena
+    {
+    public:
+        // Constructor that returns an arena without a buffer, every allocation failing
+        frame_arena() = default;
+
+        // Constructor that returns an arena of capacity bytes, rounded up to a cache line
+        explicit frame_arena(std::size_t capacity) :
+            buffer(static_cast<std::byte*>(::operator new(roundUp(capacity, cacheLineSize), std::align_val_t(cacheLineSize)))),
+            bufferSize(roundUp(capacity, cacheLineSize))
+        {
+        }
+
+        frame_arena(const frame_arena&) = delete;
+        frame_arena& operator=(const frame_arena&) = delete;
+
+        frame_arena(frame_arena&& other) noexcept
+        {
+            *this = std::move(other);
+        }
+
+        frame_arena& operator=(frame_arena&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+
+                buffer = std::exchange(other.buffer, nullptr);
+                bufferSize = std::exchange(other.bufferSize, 0);
+                offset = std::exchange(other.offset, 0);
+            }
+
+            return *this;
+        }
+
+        ~frame_arena()
+        {
+            release();
+        }
+
+        // Returns count default-initialized objects aligned on Alignment bytes, or an empty span if the arena
+        // does not have enough space left (or if count is 0)
+        template<typename T, std::size_t Alignment = cacheLineSize>
+        std::span<T> allocate(std::size_t count)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "The arena never destroys its objects");
+
+            std::span<T> objects = reserve<T, Alignment>(count);
+            std::uninitialized_default_construct_n(objects.data(), objects.size());
+
+            return objects;
+        }
+
+        // Same as allocate, without running the constructor of the objects, that hold whatever the buffer held :
+        // for the buffers that are about to be overwritten. T must be trivially copyable
+        template<typename T, std::size_t Alignment = cacheLineSize>
+        std::span<T> allocateUninitialized(std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "The objects must not need a constructor");
+
+            return reserve<T, Alignment>(count);
+        }
+
+        // Gives every allocation back, the spans returned until now becoming invalid
+        void reset()
+        {
+            offset = 0;
+        }
+
+        // Returns the number of bytes allocated since the last reset, padding included
+        std::size_t used() const { return offset; }
+        std::size_t capacity() const { return bufferSize; }
+
+    private:
+        template<typename T, std::size_t Alignment>
+        std::span<T> reserve(std::size_t count)
+        {
+            static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2, at least alignof(T)");
+
+            // The buffer itself is only aligned on a cache line : the address is rounded up, not the offset
+            std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer);
+            std::size_t begin = static_cast<std::size_t>(roundUp(base + offset, Alignment) - base);
+
+            if (count == 0 || begin > bufferSize || count > (bufferSize - begin) / sizeof(T)) return {};
+
+            // Never past bufferSize, which is a whole number of cache lines
+            offset = roundUp(begin + count * sizeof(T), cacheLineSize);
+
+            return std::span<T>(reinterpret_cast<T*>(buffer + begin), count);
+        }
+
+        static constexpr std::size_t roundUp(std::size_t value, std::size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        void release()
+        {
+            if (buffer != nullptr) ::operator delete(buffer, std::align_val_t(cacheLineSize));
+
+            buffer = nullptr;
+            bufferSize = 0;
+            offset = 0;
+        }
+
+    private:
+        std::byte* buffer = nullptr;
+        std::size_t bufferSize = 0;
+        std::size_t offset = 0;
+    };
+
+    // One frame_arena per thread, so that the workers of math::thread_pool (or of any job system) allocate
+    // without ever waiting for each other. local() returns the arena of the calling thread, created with
+    // capacity bytes the first time the thread asks for it : only that first call takes a lock.
+    // reset() resets every arena, and must only be called while no thread allocates, such as between frames
+    class per_thread_arena
+    {
+    public:
+        explicit per_thread_arena(std::size_t capacity) :
+            arenaCapacity(capacity), id(nextId.fetch_add(1, std::memory_order_relaxed))
+        {
+        }
+
+        per_thread_arena(const per_thread_arena&) = delete;
+        per_thread_arena& operator=(const per_thread_arena&) = delete;
+
+        frame_arena& local()
+        {
+            // The arena the calling thread used last, which is the only lookup for a thread that
+            // works with a single per_thread_arena
+            thread_local std::uint64_t cachedId = 0;
+            thread_local frame_arena* cachedArena = nullptr;
+
+            if (cachedId != id)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                std::unique_ptr<frame_arena>& arena = arenas[std::this_thread::get_id()];
+
+                if (!arena) arena = std::make_unique<frame_arena>(arenaCapacity);
+
+                cachedId = id;
+                cachedArena = arena.get();
+            }
+
+            return *cachedArena;
+        }
+
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            for (auto& [thread, arena] : arenas) arena->reset();
+        }
+
+    private:
+        // Never 0, so that a thread that has not used any per_thread_arena yet misses its cache
+        static inline std::atomic<std::uint64_t> nextId = 1;
+
+        std::size_t arenaCapacity;
+        std::uint64_t id;
+
+        std::mutex mutex;
+        std::unordered_map<std::thread::id, std::unique_ptr<frame_arena>> arenas;
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#if defined(_WIN32)
+    #if !defined(WIN32_LEAN_AND_MEAN)
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace math
+{
+    // A read-only view of a whole file, mapped in memory : the pages are only read from the disk when
+    // they are touched, and are shared with every other process mapping the same file.
+    // It is move-only, the file being unmapped by the destructor
+    class mapped_file
+    {
+    public:
+        // Constructor that returns an empty mapping
+        mapped_file() = default;
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept
+        {
+            *this = std::move(other);
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+
+                bytes = std::exchange(other.bytes, nullptr);
+                byteCount = std::exchange(other.byteCount, 0);
+            }
+
+            return *this;
+        }
+
+        ~mapped_file()
+        {
+            close();
+        }
+
+        // Maps the file at path, and returns false if it could not be opened or is empty
+        bool open(const char* path)
+        {
+            close();
+
+        #if defined(_WIN32)
+            HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return false;
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+            {
+                CloseHandle(file);
+                return false;
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file);
+            if (mapping == nullptr) return false;
+
+            // The view keeps the mapping alive once its handle is closed
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (view == nullptr) return false;
+
+            bytes = static_cast<const std::byte*>(view);
+            byteCount = static_cast<std::size_t>(size.QuadPart);
+        #else
+            int file = ::open(path, O_RDONLY);
+            if (file < 0) return false;
+
+            struct stat info;
+            if (fstat(file, &info) != 0 || info.st_size == 0)
+            {
+                ::close(file);
+                return false;
+            }
+
+            // The mapping stays valid once the file is closed
+            void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            ::close(file);
+            if (view == MAP_FAILED) return false;
+
+            bytes = static_cast<const std::byte*>(view);
+            byteCount = static_cast<std::size_t>(info.st_size);
+        #endif
+
+            return true;
+        }
+
+        void close()
+        {
+            if (bytes == nullptr) return;
+
+        #if defined(_WIN32)
+            UnmapViewOfFile(bytes);
+        #else
+            munmap(const_cast<std::byte*>(bytes), byteCount);
+        #endif
+
+            bytes = nullptr;
+            byteCount = 0;
+        }
+
+        bool isOpen() const
+        {
+            return bytes != nullptr;
+        }
+
+        std::span<const std::byte> data() const
+        {
+            return std::span<const std::byte>(bytes, byteCount);
+        }
+
+    private:
+        const std::byte* bytes = nullptr;
+        std::size_t byteCount = 0;
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+
+#include "Math\Precision.hpp"
+#include "Math\Quaternions\Quaternion.hpp"
+#include "Math\Quaternions\QuaternionSoA.hpp"
+#include "Math\Vectors\Vector3.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+
+namespace math
+{
+    // A struct used to store the state of many rigid bodies as a structure of arrays, for the integration
+    // step of a physics tick : the position and velocity of each body, its orientation and its angular
+    // velocity. The velocities and accelerations are all given in world space, the angular acceleration
+    // of a body being its inverse world inertia times its torque.
+    //
+    // The static integrators load a whole SIMD pack of bodies (8 for float and 4 for double with AVX) and
+    // advance every component at once, reading and writing each array a single time. The bodies are split
+    // across the threads of math::thread_pool. The orientations are normalized as they are integrated,
+    // Policy being the precision of the inverse square root.
+    template<std::floating_point F>
+    struct rigid_body_soa
+    {
+    public:
+        vec3_soa<F> positions;
+        vec3_soa<F> velocities;
+        quat_soa<F> orientations;
+        vec3_soa<F> angularVelocities;
+
+    public:
+        // Constructor that returns an empty rigid_body_soa
+        rigid_body_soa();
+        // Constructor that returns count bodies at rest at (0.0, 0.0, 0.0), with the identity orientation
+        explicit rigid_body_soa(std::size_t count);
+
+        std::size_t size() const;
+        bool empty() const;
+
+        void resize(std::size_t count);
+        void reserve(std::size_t count);
+        void clear();
+
+        void pushBack(const vec3<F>& position, const quat<F>& orientation,
+                      const vec3<F>& velocity = vec3<F>::zero(), const vec3<F>& angularVelocity = vec3<F>::zero());
+
+        // Advances every body by dt, semi-implicit Euler : the velocities are updated from the accelerations
+        // first, then the positions and orientations move with the new velocities.
+        // The accelerations hold one value per body
+        template<Precision Policy = precise>
+        static void integrateEuler(rigid_body_soa& bodies, const vec3_soa<F>& linearAccelerations, const vec3_soa<F>& angularAccelerations, F dt);
+        // Same as integrateEuler, every body having the same linear acceleration (such as gravity), and
+        // keeping its angular velocity
+        template<Precision Policy = precise>
+        static void integrateEuler(rigid_body_soa& bodies, const vec3<F>& acceleration, F dt);
+
+        // Velocity Verlet, split around the evaluation of the forces :
+        //   beginVerletStep(bodies, a(t), dt)      v += a(t) * dt / 2, then the positions and orientations move by dt
+        //   ... computes a(t + dt) from the new positions and orientations ...
+        //   endVerletStep(bodies, a(t + dt), dt)   v += a(t + dt) * dt / 2
+        // which moves the positions by v * dt + a * dt^2 / 2, and is second order where Euler is first order
+        template<Precision Policy = precise>
+        static void beginVerletStep(rigid_body_soa& bodies, const vec3_soa<F>& linearAccelerations, const vec3_soa<F>& angularAccelerations, F dt);
+        template<Precision Policy = precise>
+        static void beginVerletStep(rigid_body_soa& bodies, const vec3<F>& acceleration, F dt);
+
+        static void endVerletStep(rigid_body_soa& bodies, const vec3_soa<F>& linearAccelerations, const vec3_soa<F>& angularAccelerations, F dt);
+        static void endVerletStep(rigid_body_soa& bodies, const vec3<F>& acceleration, F dt);
+    };
+
+    namespace detail
+    {
+        // The number of bodies a thread integrates at least
+        inline constexpr std::size_t integrationChunkSize = 4096;
+    }
+}
+
+#include "Math\Physics\RigidBodySoA.inl"
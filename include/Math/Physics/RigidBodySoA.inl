@@ -0,0 +1,236 @@
+#include <concepts>
+#include <cstddef>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+
+    #pragma region Container
+
+    template<std::floating_point F>
+    inline rigid_body_soa<F>::rigid_body_soa()
+    {
+    }
+
+    template<std::floating_point F>
+    inline rigid_body_soa<F>::rigid_body_soa(std::size_t count)
+    {
+        resize(count);
+    }
+
+    template<std::floating_point F>
+    inline std::size_t rigid_body_soa<F>::size() const
+    {
+        return positions.size();
+    }
+
+    template<std::floating_point F>
+    inline bool rigid_body_soa<F>::empty() const
+    {
+        return positions.empty();
+    }
+
+    template<std::floating_point F>
+    inline void rigid_body_soa<F>::resize(std::size_t count)
+    {
+        positions.resize(count);
+        velocities.resize(count);
+        orientations.resize(count);
+        angularVelocities.resize(count);
+    }
+
+    template<std::floating_point F>
+    inline void rigid_body_soa<F>::reserve(std::size_t count)
+    {
+        positions.reserve(count);
+        velocities.reserve(count);
+        orientations.reserve(count);
+        angularVelocities.reserve(count);
+    }
+
+    template<std::floating_point F>
+    inline void rigid_body_soa<F>::clear()
+    {
+        positions.clear();
+        velocities.clear();
+        orientations.clear();
+        angularVelocities.clear();
+    }
+
+    template<std::floating_point F>
+    inline void rigid_body_soa<F>::pushBack(const vec3<F>& position, const quat<F>& orientation, const vec3<F>& velocity, const vec3<F>& angularVelocity)
+    {
+        positions.pushBack(position);
+        velocities.pushBack(velocity);
+        orientations.pushBack(orientation);
+        angularVelocities.pushBack(angularVelocity);
+    }
+
+    #pragma endregion Container
+
+    #pragma region Integration
+
+    namespace detail
+    {
+        // Turns (qw, qx, qy, qz) by the angular velocity (wx, wy, wz) during a step, lane by lane :
+        // q += step / 2 * (0, w) * q, then q is normalized, so that the error of the first order
+        // update never builds up from one step to the next
+        template<Precision Policy, std::floating_point F, typename P>
+        inline void integrateOrientationLanes(P wx, P wy, P wz, P halfStep, P& qw, P& qx, P& qy, P& qz)
+        {
+            P dw = -simd::madd(wx, qx, simd::madd(wy, qy, wz * qz));
+            P dx = simd::madd(wx, qw, wy * qz - wz * qy);
+            P dy = simd::madd(wy, qw, wz * qx - wx * qz);
+            P dz = simd::madd(wz, qw, wx * qy - wy * qx);
+
+            qw = simd::madd(dw, halfStep, qw);
+            qx = simd::madd(dx, halfStep, qx);
+            qy = simd::madd(dy, halfStep, qy);
+            qz = simd::madd(dz, halfStep, qz);
+
+            normalizeLanes<Policy, F>(qw, qx, qy, qz);
+        }
+
+        // The step shared by every integrator : the velocities are kicked by the accelerations times kick,
+        // then, if Drift, the positions and orientations move with the new velocities during drift.
+        // With Uniform, every body has the linear acceleration `acceleration` and no angular acceleration,
+        // otherwise they are read from linearAccelerations and angularAccelerations
+        template<bool Uniform, bool Drift, Precision Policy, std::floating_point F>
+        inline void advanceBodies(rigid_body_soa<F>& bodies, const vec3<F>& acceleration,
+                                  const vec3_soa<F>* linearAccelerations, const vec3_soa<F>* angularAccelerations, F kick, F drift)
+        {
+            F* px = bodies.positions.x.data(); F* py = bodies.positions.y.data(); F* pz = bodies.positions.z.data();
+            F* vx = bodies.velocities.x.data(); F* vy = bodies.velocities.y.data(); F* vz = bodies.velocities.z.data();
+            F* ow = bodies.orientations.w.data(); F* ox = bodies.orientations.x.data();
+            F* oy = bodies.orientations.y.data(); F* oz = bodies.orientations.z.data();
+            F* wx = bodies.angularVelocities.x.data(); F* wy = bodies.angularVelocities.y.data(); F* wz = bodies.angularVelocities.z.data();
+
+            const F* ax = nullptr; const F* ay = nullptr; const F* az = nullptr;
+            const F* bx = nullptr; const F* by = nullptr; const F* bz = nullptr;
+
+            if constexpr (!Uniform)
+            {
+                ax = linearAccelerations->x.data(); ay = linearAccelerations->y.data(); az = linearAccelerations->z.data();
+                bx = angularAccelerations->x.data(); by = angularAccelerations->y.data(); bz = angularAccelerations->z.data();
+            }
+
+            vec3<F> a = acceleration;
+
+            math::parallelFor(bodies.size(), integrationChunkSize, [=](std::size_t begin, std::size_t end)
+            {
+                simd::forEachPack<F>(begin, end, [=](auto p, std::size_t i)
+                {
+                    using P = decltype(p);
+
+                    P k = P::broadcast(kick);
+
+                    P velX = P::loadu(vx + i);
+                    P velY = P::loadu(vy + i);
+                    P velZ = P::loadu(vz + i);
+
+                    if constexpr (Uniform)
+                    {
+                        velX = simd::madd(P::broadcast(a.x), k, velX);
+                        velY = simd::madd(P::broadcast(a.y), k, velY);
+                        velZ = simd::madd(P::broadcast(a.z), k, velZ);
+                    }
+                    else
+                    {
+                        velX = simd::madd(P::loadu(ax + i), k, velX);
+                        velY = simd::madd(P::loadu(ay + i), k, velY);
+                        velZ = simd::madd(P::loadu(az + i), k, velZ);
+                    }
+
+                    velX.storeu(vx + i);
+                    velY.storeu(vy + i);
+                    velZ.storeu(vz + i);
+
+                    // The angular velocities only change with an angular acceleration, and are only read to turn the bodies
+                    if constexpr (!Uniform || Drift)
+                    {
+                        P angX = P::loadu(wx + i);
+                        P angY = P::loadu(wy + i);
+                        P angZ = P::loadu(wz + i);
+
+                        if constexpr (!Uniform)
+                        {
+                            angX = simd::madd(P::loadu(bx + i), k, angX);
+                            angY = simd::madd(P::loadu(by + i), k, angY);
+                            angZ = simd::madd(P::loadu(bz + i), k, angZ);
+
+                            angX.storeu(wx + i);
+                            angY.storeu(wy + i);
+                            angZ.storeu(wz + i);
+                        }
+
+                        if constexpr (Drift)
+                        {
+                            P d = P::broadcast(drift);
+
+                            simd::madd(velX, d, P::loadu(px + i)).storeu(px + i);
+                            simd::madd(velY, d, P::loadu(py + i)).storeu(py + i);
+                            simd::madd(velZ, d, P::loadu(pz + i)).storeu(pz + i);
+
+                            P qw = P::loadu(ow + i);
+                            P qx = P::loadu(ox + i);
+                            P qy = P::loadu(oy + i);
+                            P qz = P::loadu(oz + i);
+
+                            integrateOrientationLanes<Policy, F>(angX, angY, angZ, P::broadcast(static_cast<F>(0.5) * drift), qw, qx, qy, qz);
+
+                            qw.storeu(ow + i);
+                            qx.storeu(ox + i);
+                            qy.storeu(oy + i);
+                            qz.storeu(oz + i);
+                        }
+                    }
+                });
+            });
+        }
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline void rigid_body_soa<F>::integrateEuler(rigid_body_soa<F>& bodies, const vec3_soa<F>& linearAccelerations, const vec3_soa<F>& angularAccelerations, F dt)
+    {
+        detail::advanceBodies<false, true, Policy, F>(bodies, vec3<F>::zero(), &linearAccelerations, &angularAccelerations, dt, dt);
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline void rigid_body_soa<F>::integrateEuler(rigid_body_soa<F>& bodies, const vec3<F>& acceleration, F dt)
+    {
+        detail::advanceBodies<true, true, Policy, F>(bodies, acceleration, nullptr, nullptr, dt, dt);
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline void rigid_body_soa<F>::beginVerletStep(rigid_body_soa<F>& bodies, const vec3_soa<F>& linearAccelerations, const vec3_soa<F>& angularAccelerations, F dt)
+    {
+        detail::advanceBodies<false, true, Policy, F>(bodies, vec3<F>::zero(), &linearAccelerations, &angularAccelerations, static_cast<F>(0.5) * dt, dt);
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline void rigid_body_soa<F>::beginVerletStep(rigid_body_soa<F>& bodies, const vec3<F>& acceleration, F dt)
+    {
+        detail::advanceBodies<true, true, Policy, F>(bodies, acceleration, nullptr, nullptr, static_cast<F>(0.5) * dt, dt);
+    }
+
+    template<std::floating_point F>
+    inline void rigid_body_soa<F>::endVerletStep(rigid_body_soa<F>& bodies, const vec3_soa<F>& linearAccelerations, const vec3_soa<F>& angularAccelerations, F dt)
+    {
+        detail::advanceBodies<false, false, precise, F>(bodies, vec3<F>::zero(), &linearAccelerations, &angularAccelerations, static_cast<F>(0.5) * dt, static_cast<F>(0.0));
+    }
+
+    template<std::floating_point F>
+    inline void rigid_body_soa<F>::endVerletStep(rigid_body_soa<F>& bodies, const vec3<F>& acceleration, F dt)
+    {
+        detail::advanceBodies<true, false, precise, F>(bodies, acceleration, nullptr, nullptr, static_cast<F>(0.5) * dt, static_cast<F>(0.0));
+    }
+
+    #pragma endregion Integration
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Simd.hpp"
+
+namespace math
+{
+    // Fast approximations of the functions of MathInternal.hpp, for the bulk work that can trade
+    // a few ULP for speed. They are selected through the math::fast precision policy below.
+    //
+    // - rsqrt : for float, the SSE estimate (12 bits) refined by one Newton step, about 2 ULP.
+    //   double keeps 1.0 / sqrt, no estimate instruction being worth it there.
+    // - sin and cos : reduction to [-pi/2, pi/2] then a degree 11 minimax polynomial, under 3e-11
+    //   of absolute error on the reduced range. The angles already in [-pi/2, pi/2] are not touched by
+    //   the reduction, so in float sin stays within about 2 ULP there, small angles included, and cos
+    //   within about 2 ULP on [-pi, pi]. Past that, the reduction rounds the angle to the precision of pi :
+    //   in float the absolute error stays under 2e-7 up to a thousand radians, but the small results near
+    //   the multiples of pi lose their relative precision. The reduction loses more past a few thousand
+    //   radians, and is wrong past 2^(digits - 2) turns (about 2.6e7 radians for float).
+    // - acos and asin : the polynomial of Abramowitz and Stegun (4.4.46), under 2e-8 of absolute error.
+    // - atan and atan2 : reduction to [0, 1] then a degree 15 minimax polynomial, under 7e-8 of absolute error.
+    //
+    // Unlike their precise versions, acos and asin clamp their argument to [-1, 1] instead of
+    // returning NaN. Everything stays constexpr.
+    namespace approx
+    {
+        namespace detail
+        {
+            // Rounds to the nearest integer, halfway cases to even, for |value| under 2^(digits - 2) :
+            // adding 1.5 * 2^(digits - 1) pushes the fractional bits out of the mantissa. Unlike a cast
+            // through an integer, it stays in the floating point registers and lets loops vectorize
+            template<std::floating_point F>
+            constexpr F roundToInt(F value)
+            {
+                constexpr F magic = static_cast<F>(1.5) * static_cast<F>(1ull << (std::numeric_limits<F>::digits - 2)) * static_cast<F>(2.0);
+
+                return (value + magic) - magic;
+            }
+
+            // Returns value - k * 2 pi, in [-pi, pi].
+            // 2 pi is split in a part with few bits, whose product with k is exact, and the rest,
+            // so that the reduction keeps its precision for large angles
+            template<std::floating_point F>
+            constexpr F reduceTwoPi(F value)
+            {
+                constexpr F twoPiHi = static_cast<F>(6.28125);
+                constexpr F twoPiLo = static_cast<F>(0.0019353071795864769);
+
+                F k = roundToInt(value * (static_cast<F>(1.0) / math::twoPi<F>()));
+
+                return (value - k * twoPiHi) - k * twoPiLo;
+            }
+
+            // pi and pi/2 split in a part with few bits and the rest, as 2 pi in reduceTwoPi : for x close to the
+            // high part, hi - x is exact, and only the low part is rounded, so that the small results of
+            // pi - x and pi/2 - x keep their precision
+            template<std::floating_point F>
+            inline constexpr F piHi = static_cast<F>(3.140625);
+            template<std::floating_point F>
+            inline constexpr F piLo = static_cast<F>(0.00096765358979323846);
+            template<std::floating_point F>
+            inline constexpr F halfPiHi = static_cast<F>(1.5703125);
+            template<std::floating_point F>
+            inline constexpr F halfPiLo = static_cast<F>(0.00048382679489661923);
+
+            // sin(pi - x) = sin(x) and sin(-pi - x) = sin(x), which bring x from [-pi, pi] to [-pi/2, pi/2].
+            // Only the angles past pi/2 are folded, the other ones being returned as they are, so that small
+            // angles keep every bit. The choice is a select rather than a branch, the angles of a batch having
+            // no reason to be sorted. x can be slightly past pi after the reduction, the fold then giving a
+            // small angle of the opposite sign, as it should
+            template<std::floating_point F>
+            constexpr F foldHalfPi(F x)
+            {
+                constexpr F halfPi = math::pi<F>() / static_cast<F>(2.0);
+
+                return math::abs(x) > halfPi ? (math::copysign(piHi<F>, x) - x) + math::copysign(piLo<F>, x) : x;
+            }
+
+            // sin(x) for x in [-pi/2, pi/2]
+            template<std::floating_point F>
+            constexpr F sinReduced(F x)
+            {
+                F x2 = x * x;
+
+                F p = static_cast<F>(-2.3868066073500553e-08);
+                p = p * x2 + static_cast<F>(2.7523953386294598e-06);
+                p = p * x2 + static_cast<F>(-0.00019840832430367882);
+                p = p * x2 + static_cast<F>(0.0083333307169626333);
+                p = p * x2 + static_cast<F>(-0.16666666608709216);
+                p = p * x2 + static_cast<F>(0.99999999997878664);
+
+                return p * x;
+            }
+
+            // atan(x) for x in [0, 1]
+            template<std::floating_point F>
+            constexpr F atanReduced(F x)
+            {
+                F x2 = x * x;
+
+                F p = static_cast<F>(-0.0045836798423690497);
+                p = p * x2 + static_cast<F>(0.023865486976315908);
+                p = p * x2 + static_cast<F>(-0.058948859311715382);
+                p = p * x2 + static_cast<F>(0.098771790371619317);
+                p = p * x2 + static_cast<F>(-0.14006286099709123);
+                p = p * x2 + static_cast<F>(0.19967480175814289);
+                p = p * x2 + static_cast<F>(-0.33331846709889595);
+                p = p * x2 + static_cast<F>(0.99999988572629839);
+
+                return p * x;
+            }
+        }
+
+        // Returns 1.0 / sqrt(value), value being greater than 0.0
+        template<std::floating_point F>
+        constexpr F rsqrt(F value)
+        {
+            if constexpr (std::is_same_v<F, float>)
+            {
+                float estimate;
+
+            #if defined(MATH_SIMD_SSE)
+                if (!std::is_constant_evaluated())
+                {
+                    estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+
+                    return estimate * (1.5f - 0.5f * value * estimate * estimate);
+                }
+            #endif
+
+                // Without the SSE estimate, the bit level one (3.4% of error) needs three Newton steps
+                estimate = std::bit_cast<float>(0x5f375a86u - (std::bit_cast<std::uint32_t>(value) >> 1));
+                estimate = estimate * (1.5f - 0.5f * value * estimate * estimate);
+                estimate = estimate * (1.5f - 0.5f * value * estimate * estimate);
+
+                return estimate * (1.5f - 0.5f * value * estimate * estimate);
+            }
+            else
+            {
+                return static_cast<F>(1.0) / math::sqrt(value);
+            }
+        }
+
+        template<std::floating_point F>
+        constexpr F sqrt(F value)
+        {
+            if (value <= static_cast<F>(0.0)) return math::sqrt(value);
+
+            return value * rsqrt(value);
+        }
+
+        template<std::floating_point F>
+        constexpr F sin(F value)
+        {
+            return detail::sinReduced(detail::foldHalfPi(detail::reduceTwoPi(value)));
+        }
+
+        template<std::floating_point F>
+        constexpr F cos(F value)
+        {
+            // cos(x) = cos(|x|) = sin(pi/2 - |x|), pi/2 - |x| being in [-pi/2, pi/2] once x is reduced
+            return detail::sinReduced((detail::halfPiHi<F> - math::abs(detail::reduceTwoPi(value))) + detail::halfPiLo<F>);
+        }
+
+        template<std::floating_point F>
+        constexpr F acos(F value)
+        {
+            F x = math::abs(math::clamp(value, static_cast<F>(-1.0), static_cast<F>(1.0)));
+
+            F p = static_cast<F>(-0.0012624911);
+            p = p * x + static_cast<F>(0.0066700901);
+            p = p * x + static_cast<F>(-0.0170881256);
+            p = p * x + static_cast<F>(0.0308918810);
+            p = p * x + static_cast<F>(-0.0501743046);
+            p = p * x + static_cast<F>(0.0889789874);
+            p = p * x + static_cast<F>(-0.2145988016);
+            p = p * x + static_cast<F>(1.5707963050);
+
+            F res = math::sqrt(static_cast<F>(1.0) - x) * p;
+
+            // acos(-x) = pi - acos(x)
+            return value < static_cast<F>(0.0) ? math::pi<F>() - res : res;
+        }
+
+        template<std::floating_point F>
+        constexpr F asin(F value)
+        {
+            return math::pi<F>() / static_cast<F>(2.0) - acos(value);
+        }
+
+        template<std::floating_point F>
+        constexpr F atan(F value)
+        {
+            F x = math::abs(value);
+
+            // atan(x) = pi/2 - atan(1 / x)
+            F res = x > static_cast<F>(1.0)
+                ? math::pi<F>() / static_cast<F>(2.0) - detail::atanReduced(static_cast<F>(1.0) / x)
+                : detail::atanReduced(x);
+
+            return value < static_cast<F>(0.0) ? -res : res;
+        }
+
+        template<std::floating_point F>
+        constexpr F atan2(F y, F x)
+        {
+            F ax = math::abs(x);
+            F ay = math::abs(y);
+
+            F hi = ax > ay ? ax : ay;
+            F lo = ax > ay ? ay : ax;
+
+            if (hi == static_cast<F>(0.0)) return static_cast<F>(0.0);
+
+            F res = detail::atanReduced(lo / hi);
+
+            if (ay > ax) res = math::pi<F>() / static_cast<F>(2.0) - res;
+            if (x < static_cast<F>(0.0)) res = math::pi<F>() - res;
+
+            return y < static_cast<F>(0.0) ? -res : res;
+        }
+    }
+
+    // The precision policies, given as a template parameter to the functions that can trade
+    // precision for speed (normalizing, building rotations from angles...).
+    // precise is always the default, and goes through the functions of MathInternal.hpp.
+    struct precise
+    {
+        template<std::floating_point F> static constexpr F sqrt(F value) { return math::sqrt(value); }
+        template<std::floating_point F> static constexpr F rsqrt(F value) { return static_cast<F>(1.0) / math::sqrt(value); }
+        template<std::floating_point F> static constexpr F sin(F value) { return math::sin(value); }
+        template<std::floating_point F> static constexpr F cos(F value) { return math::cos(value); }
+        template<std::floating_point F> static constexpr F asin(F value) { return math::asin(value); }
+        template<std::floating_point F> static constexpr F acos(F value) { return math::acos(value); }
+        template<std::floating_point F> static constexpr F atan2(F y, F x) { return math::atan2(y, x); }
+    };
+
+    // Goes through the approximations of math::approx
+    struct fast
+    {
+        template<std::floating_point F> static constexpr F sqrt(F value) { return approx::sqrt(value); }
+        template<std::floating_point F> static constexpr F rsqrt(F value) { return approx::rsqrt(value); }
+        template<std::floating_point F> static constexpr F sin(F value) { return approx::sin(value); }
+        template<std::floating_point F> static constexpr F cos(F value) { return approx::cos(value); }
+        template<std::floating_point F> static constexpr F asin(F value) { return approx::asin(value); }
+        template<std::floating_point F> static constexpr F acos(F value) { return approx::acos(value); }
+        template<std::floating_point F> static constexpr F atan2(F y, F x) { return approx::atan2(y, x); }
+    };
+
+    // The concept Precision encapsulates the two precision policies, math::precise and math::fast
+    template<typename P>
+    concept Precision = std::same_as<P, precise> || std::same_as<P, fast>;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Math\Concepts.hpp"
+#include "Math\Precision.hpp"
+#include "Math\Quaternions\Quaternion.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    struct vec3;
+
+    template<std::floating_point F>
+    struct mat4;
+
+    // A struct used to represent a rigid transform (a rotation followed by a translation) as a dual quaternion
+    // real + e * dual, real being the rotation and dual being 0.5 * (0, translation) * real.
+    //
+    // It takes 8 values where a mat4 takes 16, and blending unit dual quaternions then normalizing the
+    // result gives a rigid transform again, which keeps the volume of the skinned meshes around the joints
+    template<std::floating_point F>
+    struct dualquat
+    {
+    public:
+        quat<F> real, dual;
+
+    public:
+        constexpr dualquat(const quat<F>& r, const quat<F>& d);
+        // Constructor that returns the transform rotating by rotation (a unit quaternion), then translating by translation
+        constexpr dualquat(const quat<F>& rotation, const vec3<F>& translation);
+
+        static constexpr dualquat identity();
+
+        constexpr const quat<F>& getRotation() const;
+        constexpr vec3<F> getTranslation() const;
+
+        // Divides both parts by the length of real, P being the precision of the inverse square root.
+        // Once blended, a unit dual quaternion only needs this to be a rigid transform again
+        template<Precision P = precise>
+        constexpr dualquat& normalized();
+
+        template<std::floating_point type = F>
+        constexpr dualquat<type> getUnitDualQuat() const;
+
+        // Conjugates both parts, which inverts a unit dual quaternion
+        constexpr dualquat& conjugated();
+
+        template<std::floating_point type = F>
+        constexpr dualquat<type> getConjugatedDualQuat() const;
+
+        // Returns the point rotated then translated by dq (a unit dual quaternion)
+        static constexpr vec3<F> transformPoint(const vec3<F>& point, const dualquat& dq);
+        // Returns the direction rotated by dq (a unit dual quaternion), the translation being ignored
+        static constexpr vec3<F> transformDirection(const vec3<F>& direction, const dualquat& dq);
+
+        // Dual quaternion linear blending : the bones of the vertex v are bones[boneIndices[v * N + k]],
+        // weighted by weights[v * N + k], k going from 0 to N - 1, and the weights of a vertex summing to 1.0.
+        // The blended transform of each vertex is normalized, then applied to positions[v] (and to
+        // normals[v] without its translation). A vertex whose weights are all 0.0 is left where it is.
+        // The vertices are split across the SIMD lanes and the threads of math::thread_pool, out must hold at
+        // least positions.size() vectors, and can be positions itself.
+        template<std::size_t N>
+        static void skin(std::span<const dualquat> bones,
+                         std::span<const std::uint16_t> boneIndices, std::span<const F> weights,
+                         std::span<const vec3<F>> positions, std::span<vec3<F>> outPositions);
+        template<std::size_t N>
+        static void skin(std::span<const dualquat> bones,
+                         std::span<const std::uint16_t> boneIndices, std::span<const F> weights,
+                         std::span<const vec3<F>> positions, std::span<const vec3<F>> normals,
+                         std::span<vec3<F>> outPositions, std::span<vec3<F>> outNormals);
+
+        constexpr mat4<F> toMat4() const;
+
+        constexpr dualquat& operator+=(const dualquat& other);
+        constexpr dualquat& operator*=(F scalar);
+    };
+
+    // Returns the transform applying b, then a
+    template<std::floating_point F>
+    constexpr dualquat<F> operator*(const dualquat<F>& a, const dualquat<F>& b);
+    template<std::floating_point F>
+    constexpr dualquat<F> operator+(const dualquat<F>& a, const dualquat<F>& b);
+    template<std::floating_point F>
+    constexpr dualquat<F> operator*(const dualquat<F>& dq, F scalar);
+    template<std::floating_point F>
+    constexpr dualquat<F> operator*(F scalar, const dualquat<F>& dq);
+}
+
+#include "Math\Quaternions\DualQuaternion.inl"
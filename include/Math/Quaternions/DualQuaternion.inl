@@ -0,0 +1,362 @@
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Math\Memory\AlignedAllocator.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    constexpr dualquat<F>::dualquat(const quat<F>& r, const quat<F>& d) : real(r), dual(d)
+    {
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F>::dualquat(const quat<F>& rotation, const vec3<F>& translation) : real(rotation), dual(quat<F>::identity())
+    {
+        F f05 = static_cast<F>(0.5);
+
+        // 0.5 * (0, t) * r
+        dual = quat<F>(static_cast<F>(0.0), translation.x * f05, translation.y * f05, translation.z * f05) * rotation;
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F> dualquat<F>::identity()
+    {
+        F f0 = static_cast<F>(0.0);
+
+        return dualquat<F>(quat<F>::identity(), quat<F>(f0, f0, f0, f0));
+    }
+
+    template<std::floating_point F>
+    constexpr const quat<F>& dualquat<F>::getRotation() const
+    {
+        return real;
+    }
+
+    template<std::floating_point F>
+    constexpr vec3<F> dualquat<F>::getTranslation() const
+    {
+        // 2 * dual * conjugate(real), whose w is 0.0
+        quat<F> t = dual * real.template getConjugatedQuat<F>();
+        F f2 = static_cast<F>(2.0);
+
+        return vec3<F>(t.x * f2, t.y * f2, t.z * f2);
+    }
+
+    template<std::floating_point F>
+    template<Precision P>
+    constexpr dualquat<F>& dualquat<F>::normalized()
+    {
+        F l = real.template lengthSquared<F>();
+
+        if (l > math::epsilon<F>() * math::epsilon<F>())
+        {
+            F invLen = P::rsqrt(l);
+
+            real.w *= invLen; real.x *= invLen; real.y *= invLen; real.z *= invLen;
+            dual.w *= invLen; dual.x *= invLen; dual.y *= invLen; dual.z *= invLen;
+        }
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point type>
+    constexpr dualquat<type> dualquat<F>::getUnitDualQuat() const
+    {
+        dualquat copy = *this;
+        copy.normalized();
+
+        return dualquat<type>(copy.real.template WXYZ<type>(), copy.dual.template WXYZ<type>());
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F>& dualquat<F>::conjugated()
+    {
+        real.conjugated();
+        dual.conjugated();
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point type>
+    constexpr dualquat<type> dualquat<F>::getConjugatedDualQuat() const
+    {
+        return dualquat<type>(real.template getConjugatedQuat<type>(), dual.template getConjugatedQuat<type>());
+    }
+
+    namespace detail
+    {
+        // The number of vertices given to a thread at once by the dual quaternion skinning
+        inline constexpr std::size_t dualQuatSkinningChunkSize = 4096;
+
+        // Adds the translation of the unit dual quaternion (rw, rx, ry, rz) + e * (dw, dx, dy, dz) to (vx, vy, vz),
+        // lane by lane : the vector part of 2 * dual * conjugate(real), being 2 * (rw * d - dw * r + r x d)
+        template<typename P>
+        constexpr void translateLanes(P rw, P rx, P ry, P rz, P dw, P dx, P dy, P dz, P& vx, P& vy, P& vz)
+        {
+            P tx = rw * dx - dw * rx + (ry * dz - rz * dy);
+            P ty = rw * dy - dw * ry + (rz * dx - rx * dz);
+            P tz = rw * dz - dw * rz + (rx * dy - ry * dx);
+
+            vx = vx + (tx + tx);
+            vy = vy + (ty + ty);
+            vz = vz + (tz + tz);
+        }
+
+        // The blended dual quaternions of a block of vertices, one array per component
+        template<std::floating_point F>
+        struct dualquat_block
+        {
+            alignas(cacheLineSize) F rw[soaBlockSize];
+            alignas(cacheLineSize) F rx[soaBlockSize];
+            alignas(cacheLineSize) F ry[soaBlockSize];
+            alignas(cacheLineSize) F rz[soaBlockSize];
+            alignas(cacheLineSize) F dw[soaBlockSize];
+            alignas(cacheLineSize) F dx[soaBlockSize];
+            alignas(cacheLineSize) F dy[soaBlockSize];
+            alignas(cacheLineSize) F dz[soaBlockSize];
+        };
+
+        // Blends the bones of the vertices [first, first + count) into block. The gathers of the bones are
+        // scalar, the bones of neighbouring vertices having no reason to be next to each other
+        template<std::size_t N, std::floating_point F>
+        inline void blendDualQuats(const dualquat<F>* bones, const std::uint16_t* boneIndices, const F* weights,
+                                   std::size_t first, std::size_t count, dualquat_block<F>& block)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                const std::uint16_t* indices = boneIndices + (first + i) * N;
+                const F* w = weights + (first + i) * N;
+
+                const dualquat<F>& b0 = bones[indices[0]];
+
+                F rw = b0.real.w * w[0], rx = b0.real.x * w[0], ry = b0.real.y * w[0], rz = b0.real.z * w[0];
+                F dw = b0.dual.w * w[0], dx = b0.dual.x * w[0], dy = b0.dual.y * w[0], dz = b0.dual.z * w[0];
+
+                for (std::size_t k = 1; k < N; k++)
+                {
+                    const dualquat<F>& b = bones[indices[k]];
+
+                    // q and -q are the same rotation : the bones in the other hemisphere than the first one are
+                    // flipped, so that the blend takes the shortest path
+                    F dot = b.real.w * b0.real.w + b.real.x * b0.real.x + b.real.y * b0.real.y + b.real.z * b0.real.z;
+                    F wk = dot < static_cast<F>(0.0) ? -w[k] : w[k];
+
+                    rw += b.real.w * wk; rx += b.real.x * wk; ry += b.real.y * wk; rz += b.real.z * wk;
+                    dw += b.dual.w * wk; dx += b.dual.x * wk; dy += b.dual.y * wk; dz += b.dual.z * wk;
+                }
+
+                block.rw[i] = rw; block.rx[i] = rx; block.ry[i] = ry; block.rz[i] = rz;
+                block.dw[i] = dw; block.dx[i] = dx; block.dy[i] = dy; block.dz[i] = dz;
+            }
+        }
+
+        // Skins the vertices [begin, end), normals and outNormals being nullptr when there are no normals
+        template<std::size_t N, std::floating_point F>
+        inline void skinDualQuat(const dualquat<F>* bones, const std::uint16_t* boneIndices, const F* weights,
+                                 const vec3<F>* positions, const vec3<F>* normals, vec3<F>* outPositions, vec3<F>* outNormals,
+                                 std::size_t begin, std::size_t end)
+        {
+            dualquat_block<F> block;
+
+            alignas(cacheLineSize) F nx[soaBlockSize];
+            alignas(cacheLineSize) F ny[soaBlockSize];
+            alignas(cacheLineSize) F nz[soaBlockSize];
+
+            forEachSoaBlock(positions, outPositions, begin, end, [&](std::size_t first, std::size_t count, F* x, F* y, F* z)
+            {
+                blendDualQuats<N>(bones, boneIndices, weights, first, count, block);
+
+                if (normals)
+                {
+                    for (std::size_t i = 0; i < count; i++)
+                    {
+                        nx[i] = normals[first + i].x;
+                        ny[i] = normals[first + i].y;
+                        nz[i] = normals[first + i].z;
+                    }
+                }
+
+                simd::forEachPack<F>(0, count, [&](auto p, std::size_t i)
+                {
+                    using P = decltype(p);
+
+                    P rw = P::load(block.rw + i), rx = P::load(block.rx + i), ry = P::load(block.ry + i), rz = P::load(block.rz + i);
+                    P dw = P::load(block.dw + i), dx = P::load(block.dx + i), dy = P::load(block.dy + i), dz = P::load(block.dz + i);
+
+                    P l = rw * rw + rx * rx + ry * ry + rz * rz;
+
+                    // Vertices whose weights sum to 0.0 blend a real part of length 0.0, multiplied by 1.0 instead of 1.0 / 0.0
+                    P one = P::broadcast(static_cast<F>(1.0));
+                    P invLen = one / simd::sqrt(simd::select(simd::cmpGt(l, P::zero()), l, one));
+
+                    rw = rw * invLen; rx = rx * invLen; ry = ry * invLen; rz = rz * invLen;
+                    dw = dw * invLen; dx = dx * invLen; dy = dy * invLen; dz = dz * invLen;
+
+                    P vx = P::load(x + i);
+                    P vy = P::load(y + i);
+                    P vz = P::load(z + i);
+
+                    rotateLanes(rw, rx, ry, rz, vx, vy, vz);
+                    translateLanes(rw, rx, ry, rz, dw, dx, dy, dz, vx, vy, vz);
+
+                    vx.store(x + i);
+                    vy.store(y + i);
+                    vz.store(z + i);
+
+                    if (normals)
+                    {
+                        P wx = P::load(nx + i);
+                        P wy = P::load(ny + i);
+                        P wz = P::load(nz + i);
+
+                        rotateLanes(rw, rx, ry, rz, wx, wy, wz);
+
+                        wx.store(nx + i);
+                        wy.store(ny + i);
+                        wz.store(nz + i);
+                    }
+                });
+
+                if (normals)
+                {
+                    for (std::size_t i = 0; i < count; i++)
+                    {
+                        outNormals[first + i].x = nx[i];
+                        outNormals[first + i].y = ny[i];
+                        outNormals[first + i].z = nz[i];
+                    }
+                }
+            });
+        }
+    }
+
+    template<std::floating_point F>
+    constexpr vec3<F> dualquat<F>::transformPoint(const vec3<F>& point, const dualquat<F>& dq)
+    {
+        using P = simd::scalar_pack<F>;
+
+        P vx = { point.x };
+        P vy = { point.y };
+        P vz = { point.z };
+
+        detail::rotateLanes<P>({ dq.real.w }, { dq.real.x }, { dq.real.y }, { dq.real.z }, vx, vy, vz);
+        detail::translateLanes<P>({ dq.real.w }, { dq.real.x }, { dq.real.y }, { dq.real.z },
+                                  { dq.dual.w }, { dq.dual.x }, { dq.dual.y }, { dq.dual.z }, vx, vy, vz);
+
+        return vec3<F>(vx.v, vy.v, vz.v);
+    }
+
+    template<std::floating_point F>
+    constexpr vec3<F> dualquat<F>::transformDirection(const vec3<F>& direction, const dualquat<F>& dq)
+    {
+        return quat<F>::rotatePointViaQuat(direction, dq.real);
+    }
+
+    template<std::floating_point F>
+    template<std::size_t N>
+    inline void dualquat<F>::skin(std::span<const dualquat<F>> bones,
+                                  std::span<const std::uint16_t> boneIndices, std::span<const F> weights,
+                                  std::span<const vec3<F>> positions, std::span<vec3<F>> outPositions)
+    {
+        const dualquat<F>* b = bones.data();
+        const std::uint16_t* indices = boneIndices.data();
+        const F* w = weights.data();
+        const vec3<F>* in = positions.data();
+        vec3<F>* out = outPositions.data();
+
+        math::parallelFor(positions.size(), detail::dualQuatSkinningChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            detail::skinDualQuat<N>(b, indices, w, in, static_cast<const vec3<F>*>(nullptr), out, static_cast<vec3<F>*>(nullptr), begin, end);
+        });
+    }
+
+    template<std::floating_point F>
+    template<std::size_t N>
+    inline void dualquat<F>::skin(std::span<const dualquat<F>> bones,
+                                  std::span<const std::uint16_t> boneIndices, std::span<const F> weights,
+                                  std::span<const vec3<F>> positions, std::span<const vec3<F>> normals,
+                                  std::span<vec3<F>> outPositions, std::span<vec3<F>> outNormals)
+    {
+        const dualquat<F>* b = bones.data();
+        const std::uint16_t* indices = boneIndices.data();
+        const F* w = weights.data();
+        const vec3<F>* in = positions.data();
+        const vec3<F>* inNormals = normals.data();
+        vec3<F>* out = outPositions.data();
+        vec3<F>* outN = outNormals.data();
+
+        math::parallelFor(positions.size(), detail::dualQuatSkinningChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            detail::skinDualQuat<N>(b, indices, w, in, inNormals, out, outN, begin, end);
+        });
+    }
+
+    template<std::floating_point F>
+    constexpr mat4<F> dualquat<F>::toMat4() const
+    {
+        mat4<F> res = real.toMat4();
+        vec3<F> t = getTranslation();
+
+        res.columns[3][0] = t.x;
+        res.columns[3][1] = t.y;
+        res.columns[3][2] = t.z;
+
+        return res;
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F>& dualquat<F>::operator+=(const dualquat<F>& other)
+    {
+        real.w += other.real.w; real.x += other.real.x; real.y += other.real.y; real.z += other.real.z;
+        dual.w += other.dual.w; dual.x += other.dual.x; dual.y += other.dual.y; dual.z += other.dual.z;
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F>& dualquat<F>::operator*=(F scalar)
+    {
+        real.w *= scalar; real.x *= scalar; real.y *= scalar; real.z *= scalar;
+        dual.w *= scalar; dual.x *= scalar; dual.y *= scalar; dual.z *= scalar;
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F> operator*(const dualquat<F>& a, const dualquat<F>& b)
+    {
+        // (ar + e * ad) * (br + e * bd) = ar * br + e * (ar * bd + ad * br), e * e being 0
+        quat<F> d1 = a.real * b.dual;
+        quat<F> d2 = a.dual * b.real;
+
+        return dualquat<F>(a.real * b.real, quat<F>(d1.w + d2.w, d1.x + d2.x, d1.y + d2.y, d1.z + d2.z));
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F> operator+(const dualquat<F>& a, const dualquat<F>& b)
+    {
+        dualquat<F> res = a;
+        return res += b;
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F> operator*(const dualquat<F>& dq, F scalar)
+    {
+        dualquat<F> res = dq;
+        return res *= scalar;
+    }
+
+    template<std::floating_point F>
+    constexpr dualquat<F> operator*(F scalar, const dualquat<F>& dq)
+    {
+        dualquat<F> res = dq;
+        return res *= scalar;
+    }
+}
@@ -2,9 +2,12 @@
 
 #include <cmath>
 #include <concepts>
+#include <span>
 
 #include "Math\MathInternal.hpp"
 #include "Math\Concepts.hpp"
+#include "Math\Precision.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
 
 namespace math
 {
@@ -18,71 +21,91 @@ namespace math
     struct alignas(16) quat  
     {
     public:
-        union 
-        {
-            struct { F w, x, y, z; };
-            F data[4];
-        };
+        F w, x, y, z;
 
     public:
-        quat(F qw, const vec3<F>& xyz);
-        quat(F qw, F qx, F qy, F qz);
+        constexpr quat(F qw, const vec3<F>& xyz);
+        constexpr quat(F qw, F qx, F qy, F qz);
 
-        static quat<F> identity();
+        static constexpr quat<F> identity();
         
         template<std::floating_point type>
-        vec3<type> XYZ() const;
+        constexpr vec3<type> XYZ() const;
         template<std::floating_point type>
-        vec3<type> ZYX() const;
+        constexpr vec3<type> ZYX() const;
         template<std::floating_point type>
-        quat<type> WXYZ() const;
+        constexpr quat<type> WXYZ() const;
 
-        F* valuePtr() const;
+        constexpr const F* valuePtr() const;
 
-        quat& normalized();
+        // Normalizes the quaternion, P being the precision of the inverse square root
+        template<Precision P = precise>
+        constexpr quat& normalized();
 
         template<std::floating_point type>
-        quat<type> getUnitQuat() const;
+        constexpr quat<type> getUnitQuat() const;
 
-        quat& conjugated();
+        constexpr quat& conjugated();
 
         template<std::floating_point type>
-        quat<type> getConjugatedQuat() const;
+        constexpr quat<type> getConjugatedQuat() const;
 
         template<Number N>
-        N length() const;
+        constexpr N length() const;
         template<Number N>
-        N lengthSquared() const;
+        constexpr N lengthSquared() const;
 
         template<Number N>
-        static N length(const quat& quat);
+        static constexpr N length(const quat& quat);
         template<Number N>
-        static N lengthSquared(const quat& quat);
-
-        static quat fromAxisAngle(const vec3<F> axis, F angle);
-
-        static quat lookAt(const vec3<F>& eye, const vec3<F>& target, const vec3<F>& up);
-
-        static quat fromEuler(const vec3<F>& rotation);
-
-        template<std::floating_point type>
-        static vec3<type> rotatePointViaQuat(const vec3<F>& point, const quat<F>& rot)
-        {
-            
-            quat qPoint = quat(static_cast<F>(0.0), point.XYZ());
-            
-            vec3 rotated = (rot * qPoint * rot.getConjugatedQuat<type>()).XYZ();
-
-            return rotated;
-        }
-
-        vec3<F> toEuler() const;
-
-        mat4<F> toMat4() const;
+        static constexpr N lengthSquared(const quat& quat);
+
+        // The angles are in degrees, P being the precision of sin and cos
+        template<Precision P = precise>
+        static constexpr quat fromAxisAngle(const vec3<F> axis, F angle);
+
+        static constexpr quat lookAt(const vec3<F>& eye, const vec3<F>& target, const vec3<F>& up);
+
+        template<Precision P = precise>
+        static constexpr quat fromEuler(const vec3<F>& rotation);
+
+        // Returns the point rotated by rot (a unit quaternion), using the cross product form
+        // p' = p + w * t + rot.xyz x t, with t = 2 * (rot.xyz x p), instead of rot * p * rot^-1
+        template<std::floating_point type = F>
+        static constexpr vec3<type> rotatePointViaQuat(const vec3<F>& point, const quat<F>& rot);
+
+        // Bulk versions of rotatePointViaQuat : the points are split across the SIMD lanes and the threads
+        // of math::thread_pool. out must hold at least points.size() vectors (it is resized for vec3_soa),
+        // and can be points itself.
+
+        // Rotates every point by rot
+        static void rotatePoints(const quat& rot, std::span<const vec3<F>> points, std::span<vec3<F>> out);
+        // Rotates points[i] by rots[i]
+        static void rotatePoints(std::span<const quat> rots, std::span<const vec3<F>> points, std::span<vec3<F>> out);
+        // Rotates every point by rot
+        static void rotatePoints(const quat& rot, const vec3_soa<F>& points, vec3_soa<F>& out);
+        // Rotates points[i] by rots[i]
+        static void rotatePoints(std::span<const quat> rots, const vec3_soa<F>& points, vec3_soa<F>& out);
+
+        // Returns the interpolation of start and end (unit quaternions) along the shortest path, t being
+        // clamped between 0.0 and 1.0.
+        // nlerp interpolates the components then normalizes, P being the precision of the inverse square root :
+        // it is cheaper than slerp, but its angular speed is not constant.
+        // slerp keeps the angular speed constant, P being the precision of acos and sin
+        template<Precision P = precise>
+        static constexpr quat nlerp(const quat& start, const quat& end, F t);
+        template<Precision P = precise>
+        static constexpr quat slerp(const quat& start, const quat& end, F t);
+
+        // Returns the angles in degrees, P being the precision of asin and atan2
+        template<Precision P = precise>
+        constexpr vec3<F> toEuler() const;
+
+        constexpr mat4<F> toMat4() const;
     };
 
     template<std::floating_point F>
-    inline quat<F> operator*(const quat<F>& a, const quat<F>& b);
+    constexpr quat<F> operator*(const quat<F>& a, const quat<F>& b);
 }
 
 #include "Math\Quaternions\Quaternion.inl"
\ No newline at end of file
@@ -1,28 +1,24 @@
 #include <concepts>
-#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
 
 namespace math
 {
     template<std::floating_point F>
-    inline quat<F>::quat(F qw, const vec3<F>& xyz)
+    constexpr quat<F>::quat(F qw, const vec3<F>& xyz) : w(qw), x(xyz.x), y(xyz.y), z(xyz.z)
     {
-        w = qw;
-        x = xyz.x;
-        y = xyz.y;
-        z = xyz.z;
     }
 
     template<std::floating_point F>
-    inline quat<F>::quat(F qw, F qx, F qy, F qz)
+    constexpr quat<F>::quat(F qw, F qx, F qy, F qz) : w(qw), x(qx), y(qy), z(qz)
     {
-        w = qw;
-        x = qx;
-        y = qy;
-        z = qz;
     }
 
     template<std::floating_point F>
-    inline quat<F> quat<F>::identity()
+    constexpr quat<F> quat<F>::identity()
     {
         F f0 = static_cast<F>(0.0);
 
@@ -31,39 +27,40 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<f> quat<F>::XYZ() const
+    constexpr vec3<f> quat<F>::XYZ() const
     {
         return vec3<f>(static_cast<f>(x), static_cast<f>(y), static_cast<f>(z));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<f> quat<F>::ZYX() const
+    constexpr vec3<f> quat<F>::ZYX() const
     {
         return vec3<f>(static_cast<f>(z), static_cast<f>(y), static_cast<f>(x));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline quat<f> quat<F>::WXYZ() const
+    constexpr quat<f> quat<F>::WXYZ() const
     {
         return quat<f>(static_cast<f>(w), static_cast<f>(x), static_cast<f>(y), static_cast<f>(z));
     }
 
     template<std::floating_point F>
-    inline F* quat<F>::valuePtr() const
+    constexpr const F* quat<F>::valuePtr() const
     {
-        return &data[0];
+        return &w;
     }
 
     template<std::floating_point F>
-    inline quat<F>& quat<F>::normalized()
+    template<Precision P>
+    constexpr quat<F>& quat<F>::normalized()
     {
-        F l = this->length<F>();
+        F l = this->lengthSquared<F>();
 
-        if (std::abs(l) > math::epsilon<F>()) 
+        if (l > math::epsilon<F>() * math::epsilon<F>()) 
         {
-            F invLen = static_cast<F>(1.0) / l;
+            F invLen = P::rsqrt(l);
     
             w *= invLen;
             x *= invLen;
@@ -76,7 +73,7 @@ namespace math
  
     template<std::floating_point F>
     template<std::floating_point f>
-    inline quat<f> quat<F>::getUnitQuat() const
+    constexpr quat<f> quat<F>::getUnitQuat() const
     {
         quat copy = *this;
 
@@ -91,7 +88,7 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline quat<F>& quat<F>::conjugated()
+    constexpr quat<F>& quat<F>::conjugated()
     {
         x *= static_cast<F>(-1.0);
         y *= static_cast<F>(-1.0);
@@ -102,7 +99,7 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline quat<f> quat<F>::getConjugatedQuat() const
+    constexpr quat<f> quat<F>::getConjugatedQuat() const
     {
         quat copy = *this;
 
@@ -118,48 +115,53 @@ namespace math
 
     template<std::floating_point F>
     template<Number N>
-    inline N quat<F>::length() const 
+    constexpr N quat<F>::length() const 
     {
-        return static_cast<N>(std::sqrt( (w * w) + (x * x) + (y * y) + (z * z) ));
+        return static_cast<N>(math::sqrt( (w * w) + (x * x) + (y * y) + (z * z) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N quat<F>::length(const quat<F>& quat)  
+    constexpr N quat<F>::length(const quat<F>& quat)  
     {
-        return static_cast<N>(std::sqrt( (quat.w * quat.w) + (quat.x * quat.x) + (quat.y * quat.y) + (quat.z * quat.z) ));
+        return static_cast<N>(math::sqrt( (quat.w * quat.w) + (quat.x * quat.x) + (quat.y * quat.y) + (quat.z * quat.z) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N quat<F>::lengthSquared() const 
+    constexpr N quat<F>::lengthSquared() const 
     {
         return static_cast<N>( (w * w) + (x * x) + (y * y) + (z * z) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N quat<F>::lengthSquared(const quat<F>& quat)  
+    constexpr N quat<F>::lengthSquared(const quat<F>& quat)  
     {
         return static_cast<N>( (quat.w * quat.w) + (quat.x * quat.x) + (quat.y * quat.y) + (quat.z * quat.z) );
     }
 
     template<std::floating_point F>
-    inline quat<F> quat<F>::fromAxisAngle(const vec3<F> axis, F angle)
+    template<Precision P>
+    constexpr quat<F> quat<F>::fromAxisAngle(const vec3<F> axis, F angle)
     {
-        vec3<F> rotAxis = axis.getUnitVector();
+        vec3<F> rotAxis = axis;
+        rotAxis.template normalized<P>();
+
         F theta = (angle * math::degToRad<F>()) / static_cast<F>(2.0);
 
-        F w = static_cast<F>(std::cos(theta));
-        F x = rotAxis.x * static_cast<F>(std::sin(theta));
-        F y = rotAxis.y * static_cast<F>(std::sin(theta));
-        F z = rotAxis.z * static_cast<F>(std::sin(theta));
+        F sinTheta = P::sin(theta);
+
+        F w = P::cos(theta);
+        F x = rotAxis.x * sinTheta;
+        F y = rotAxis.y * sinTheta;
+        F z = rotAxis.z * sinTheta;
 
         return quat(w, x, y, z);
     }
 
     template<std::floating_point F>
-    inline quat<F> quat<F>::lookAt(const vec3<F>& eye, const vec3<F>& target, const vec3<F>& up)
+    constexpr quat<F> quat<F>::lookAt(const vec3<F>& eye, const vec3<F>& target, const vec3<F>& up)
     {
         // 1. Calculer la direction vers laquelle on veut regarder
         vec3<F> forward = (target - eye).getUnitVector();
@@ -168,15 +170,15 @@ namespace math
         vec3<F> localForward = vec3<F>(0, 0, 1);
 
         // 3. Trouver le produit scalaire (cosinus de l'angle)
-        F dot = vec3<F>::dotProduct(localForward, forward);
+        F dot = vec3<F>::template dotProduct<F>(localForward, forward);
 
         // Cas particuliers : si les vecteurs sont opposés
-        if (std::abs(dot + static_cast<F>(1.0)) < math::epsilon<F>()) 
+        if (math::abs(dot + static_cast<F>(1.0)) < math::epsilon<F>()) 
         {
             return quat<F>(0, up.x, up.y, up.z); // Rotation de 180° autour de l'axe Up
         }
         // Si les vecteurs sont déjà alignés
-        if (std::abs(dot - static_cast<F>(1.0)) < math::epsilon<F>()) 
+        if (math::abs(dot - static_cast<F>(1.0)) < math::epsilon<F>()) 
         {
             return quat<F>::identity();
         }
@@ -187,7 +189,7 @@ namespace math
         // 5. Formule directe pour le quaternion de rotation entre deux vecteurs
         // q.w = sqrt(length(v1)^2 * length(v2)^2) + dot(v1, v2)
         // q.xyz = cross(v1, v2)
-        F s = std::sqrt((static_cast<F>(1.0) + dot) * static_cast<F>(2.0));
+        F s = math::sqrt((static_cast<F>(1.0) + dot) * static_cast<F>(2.0));
         F invS = static_cast<F>(1.0) / s;
 
         return quat<F>(
@@ -200,16 +202,17 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline quat<F> quat<F>::fromEuler(const vec3<F>& rotation)
+    template<Precision P>
+    constexpr quat<F> quat<F>::fromEuler(const vec3<F>& rotation)
     {
         // Conversion en radians et calcul des demi-angles
         F x = (rotation.x * math::degToRad<F>()) * static_cast<F>(0.5);
         F y = (rotation.y * math::degToRad<F>()) * static_cast<F>(0.5);
         F z = (rotation.z * math::degToRad<F>()) * static_cast<F>(0.5);
 
-        F cx = std::cos(x); F sx = std::sin(x);
-        F cy = std::cos(y); F sy = std::sin(y);
-        F cz = std::cos(z); F sz = std::sin(z);
+        F cx = P::cos(x); F sx = P::sin(x);
+        F cy = P::cos(y); F sy = P::sin(y);
+        F cz = P::cos(z); F sz = P::sin(z);
 
         // Formule pour l'ordre YXZ
         return quat<F>(
@@ -220,24 +223,265 @@ namespace math
         );
     }
 
+    namespace detail
+    {
+        // The number of points given to a thread at once by the bulk rotations
+        inline constexpr std::size_t rotationChunkSize = 16384;
+
+        // Rotates (vx, vy, vz) by (qw, qx, qy, qz), lane by lane, in the cross product form
+        template<typename P>
+        constexpr void rotateLanes(P qw, P qx, P qy, P qz, P& vx, P& vy, P& vz)
+        {
+            P tx = qy * vz - qz * vy;
+            P ty = qz * vx - qx * vz;
+            P tz = qx * vy - qy * vx;
+
+            tx = tx + tx;
+            ty = ty + ty;
+            tz = tz + tz;
+
+            vx = simd::madd(qw, tx, vx) + (qy * tz - qz * ty);
+            vy = simd::madd(qw, ty, vy) + (qz * tx - qx * tz);
+            vz = simd::madd(qw, tz, vz) + (qx * ty - qy * tx);
+        }
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point type>
+    constexpr vec3<type> quat<F>::rotatePointViaQuat(const vec3<F>& point, const quat<F>& rot)
+    {
+        simd::scalar_pack<F> vx = { point.x };
+        simd::scalar_pack<F> vy = { point.y };
+        simd::scalar_pack<F> vz = { point.z };
+
+        detail::rotateLanes<simd::scalar_pack<F>>({ rot.w }, { rot.x }, { rot.y }, { rot.z }, vx, vy, vz);
+
+        return vec3<type>(static_cast<type>(vx.v), static_cast<type>(vy.v), static_cast<type>(vz.v));
+    }
+
+    template<std::floating_point F>
+    inline void quat<F>::rotatePoints(const quat<F>& rot, std::span<const vec3<F>> points, std::span<vec3<F>> out)
+    {
+        const vec3<F>* in = points.data();
+        vec3<F>* res = out.data();
+
+        math::parallelFor(points.size(), detail::rotationChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            detail::forEachSoaBlock(in, res, begin, end, [&](std::size_t, std::size_t count, F* x, F* y, F* z)
+            {
+                simd::forEachPack<F>(0, count, [=](auto p, std::size_t i)
+                {
+                    using P = decltype(p);
+
+                    P vx = P::load(x + i);
+                    P vy = P::load(y + i);
+                    P vz = P::load(z + i);
+
+                    detail::rotateLanes(P::broadcast(rot.w), P::broadcast(rot.x), P::broadcast(rot.y), P::broadcast(rot.z), vx, vy, vz);
+
+                    vx.store(x + i);
+                    vy.store(y + i);
+                    vz.store(z + i);
+                });
+            });
+        });
+    }
+
+    template<std::floating_point F>
+    inline void quat<F>::rotatePoints(std::span<const quat<F>> rots, std::span<const vec3<F>> points, std::span<vec3<F>> out)
+    {
+        const quat<F>* q = rots.data();
+        const vec3<F>* in = points.data();
+        vec3<F>* res = out.data();
+
+        math::parallelFor(points.size(), detail::rotationChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            alignas(cacheLineSize) F qw[detail::soaBlockSize];
+            alignas(cacheLineSize) F qx[detail::soaBlockSize];
+            alignas(cacheLineSize) F qy[detail::soaBlockSize];
+            alignas(cacheLineSize) F qz[detail::soaBlockSize];
+
+            detail::forEachSoaBlock(in, res, begin, end, [&](std::size_t first, std::size_t count, F* x, F* y, F* z)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    qw[i] = q[first + i].w;
+                    qx[i] = q[first + i].x;
+                    qy[i] = q[first + i].y;
+                    qz[i] = q[first + i].z;
+                }
+
+                simd::forEachPack<F>(0, count, [&](auto p, std::size_t i)
+                {
+                    using P = decltype(p);
+
+                    P vx = P::load(x + i);
+                    P vy = P::load(y + i);
+                    P vz = P::load(z + i);
+
+                    detail::rotateLanes(P::load(qw + i), P::load(qx + i), P::load(qy + i), P::load(qz + i), vx, vy, vz);
+
+                    vx.store(x + i);
+                    vy.store(y + i);
+                    vz.store(z + i);
+                });
+            });
+        });
+    }
+
+    template<std::floating_point F>
+    inline void quat<F>::rotatePoints(const quat<F>& rot, const vec3_soa<F>& points, vec3_soa<F>& out)
+    {
+        out.resize(points.size());
+
+        const F* px = points.x.data(); const F* py = points.y.data(); const F* pz = points.z.data();
+        F* ox = out.x.data(); F* oy = out.y.data(); F* oz = out.z.data();
+
+        math::parallelFor(points.size(), detail::rotationChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            simd::forEachPack<F>(begin, end, [=](auto p, std::size_t i)
+            {
+                using P = decltype(p);
+
+                P vx = P::loadu(px + i);
+                P vy = P::loadu(py + i);
+                P vz = P::loadu(pz + i);
+
+                detail::rotateLanes(P::broadcast(rot.w), P::broadcast(rot.x), P::broadcast(rot.y), P::broadcast(rot.z), vx, vy, vz);
+
+                vx.storeu(ox + i);
+                vy.storeu(oy + i);
+                vz.storeu(oz + i);
+            });
+        });
+    }
+
+    template<std::floating_point F>
+    inline void quat<F>::rotatePoints(std::span<const quat<F>> rots, const vec3_soa<F>& points, vec3_soa<F>& out)
+    {
+        out.resize(points.size());
+
+        const quat<F>* q = rots.data();
+        const F* px = points.x.data(); const F* py = points.y.data(); const F* pz = points.z.data();
+        F* ox = out.x.data(); F* oy = out.y.data(); F* oz = out.z.data();
+
+        math::parallelFor(points.size(), detail::rotationChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            simd::forEachPack<F>(begin, end, [=](auto p, std::size_t i)
+            {
+                using P = decltype(p);
+
+                // The rotations are an array of structures : gather their components lane by lane
+                alignas(cacheLineSize) F qw[P::width];
+                alignas(cacheLineSize) F qx[P::width];
+                alignas(cacheLineSize) F qy[P::width];
+                alignas(cacheLineSize) F qz[P::width];
+
+                for (std::size_t l = 0; l < P::width; l++)
+                {
+                    qw[l] = q[i + l].w;
+                    qx[l] = q[i + l].x;
+                    qy[l] = q[i + l].y;
+                    qz[l] = q[i + l].z;
+                }
+
+                P vx = P::loadu(px + i);
+                P vy = P::loadu(py + i);
+                P vz = P::loadu(pz + i);
+
+                detail::rotateLanes(P::load(qw), P::load(qx), P::load(qy), P::load(qz), vx, vy, vz);
+
+                vx.storeu(ox + i);
+                vy.storeu(oy + i);
+                vz.storeu(oz + i);
+            });
+        });
+    }
+
+    namespace detail
+    {
+        // Writes the weights of start and end in the slerp of two unit quaternions whose dot product is dot,
+        // the weight of end being negated when dot is negative, so that the interpolation takes the shortest path
+        template<Precision P, std::floating_point F>
+        constexpr void slerpWeights(F dot, F t, F& startWeight, F& endWeight)
+        {
+            F sign = dot < static_cast<F>(0.0) ? static_cast<F>(-1.0) : static_cast<F>(1.0);
+            dot = math::abs(dot);
+
+            // sin(theta) goes to 0.0 with theta : close quaternions fall back to the linear weights
+            if (dot > static_cast<F>(0.9995))
+            {
+                startWeight = static_cast<F>(1.0) - t;
+                endWeight = t * sign;
+                return;
+            }
+
+            F theta = P::acos(dot);
+            F inverseSin = static_cast<F>(1.0) / P::sin(theta);
+
+            startWeight = P::sin((static_cast<F>(1.0) - t) * theta) * inverseSin;
+            endWeight = P::sin(t * theta) * inverseSin * sign;
+        }
+    }
+
+    template<std::floating_point F>
+    template<Precision P>
+    constexpr quat<F> quat<F>::nlerp(const quat<F>& start, const quat<F>& end, F t)
+    {
+        t = clamp01(t);
+
+        F dot = start.w * end.w + start.x * end.x + start.y * end.y + start.z * end.z;
+        F startWeight = static_cast<F>(1.0) - t;
+        F endWeight = dot < static_cast<F>(0.0) ? -t : t;
+
+        quat res = quat(start.w * startWeight + end.w * endWeight,
+                        start.x * startWeight + end.x * endWeight,
+                        start.y * startWeight + end.y * endWeight,
+                        start.z * startWeight + end.z * endWeight);
+
+        return res.template normalized<P>();
+    }
+
+    template<std::floating_point F>
+    template<Precision P>
+    constexpr quat<F> quat<F>::slerp(const quat<F>& start, const quat<F>& end, F t)
+    {
+        t = clamp01(t);
+
+        F dot = start.w * end.w + start.x * end.x + start.y * end.y + start.z * end.z;
+        F startWeight = static_cast<F>(0.0);
+        F endWeight = static_cast<F>(0.0);
+
+        detail::slerpWeights<P>(dot, t, startWeight, endWeight);
+
+        quat res = quat(start.w * startWeight + end.w * endWeight,
+                        start.x * startWeight + end.x * endWeight,
+                        start.y * startWeight + end.y * endWeight,
+                        start.z * startWeight + end.z * endWeight);
+
+        // Only the linear fallback drifts away from a length of 1.0
+        return res.template normalized<P>();
+    }
+
     template<std::floating_point F>
-    inline vec3<F> quat<F>::toEuler() const
+    template<Precision P>
+    constexpr vec3<F> quat<F>::toEuler() const
     {
         vec3<F> angles;
 
         F sinX = static_cast<F>(2.0) * (w * x - y * z);
         
-        if (std::abs(sinX) >= static_cast<F>(0.99999)) 
+        if (math::abs(sinX) >= static_cast<F>(0.99999)) 
         {
-            angles.x = std::copysign(math::pi<F>() / static_cast<F>(2.0), sinX);
-            angles.y = static_cast<F>(2.0) * std::atan2(y, w);
+            angles.x = math::copysign(math::pi<F>() / static_cast<F>(2.0), sinX);
+            angles.y = static_cast<F>(2.0) * P::atan2(y, w);
             angles.z = static_cast<F>(0.0);
         } 
         else 
         {
-            angles.x = std::asin(sinX);
-            angles.y = std::atan2(static_cast<F>(2.0) * (w * y + z * x), static_cast<F>(1.0) - static_cast<F>(2.0) * (x * x + y * y));
-            angles.z = std::atan2(static_cast<F>(2.0) * (w * z + x * y), static_cast<F>(1.0) - static_cast<F>(2.0) * (z * z + x * x));
+            angles.x = P::asin(sinX);
+            angles.y = P::atan2(static_cast<F>(2.0) * (w * y + z * x), static_cast<F>(1.0) - static_cast<F>(2.0) * (x * x + y * y));
+            angles.z = P::atan2(static_cast<F>(2.0) * (w * z + x * y), static_cast<F>(1.0) - static_cast<F>(2.0) * (z * z + x * x));
         }
 
         angles.x *= math::radToDeg<F>();
@@ -248,7 +492,7 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline quat<F> operator*(const quat<F> &a, const quat<F> &b)
+    constexpr quat<F> operator*(const quat<F> &a, const quat<F> &b)
     {
         return quat<F>
         (
@@ -260,7 +504,7 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline mat4<F> quat<F>::toMat4() const 
+    constexpr mat4<F> quat<F>::toMat4() const 
     {
         F xx = x * x;
         F yy = y * y;
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Math\Memory\AlignedAllocator.hpp"
+#include "Math\Precision.hpp"
+#include "Math\Quaternions\Quaternion.hpp"
+
+namespace math
+{
+    // A struct used to store many quat as a structure of arrays : all the w are contiguous, then all
+    // the x, the y and the z, each array being aligned on a cache line, as vec3_soa does for vec3.
+    template<std::floating_point F>
+    struct quat_soa
+    {
+    public:
+        using array = std::vector<F, aligned_allocator<F>>;
+
+        array w;
+        array x;
+        array y;
+        array z;
+
+    public:
+        // Constructor that returns an empty quat_soa
+        quat_soa();
+        // Constructor that returns a quat_soa of count identity quaternions
+        explicit quat_soa(std::size_t count);
+        // Constructor that returns a quat_soa holding a copy of every quaternion of quats
+        explicit quat_soa(std::span<const quat<F>> quats);
+
+        std::size_t size() const;
+        bool empty() const;
+
+        // The quaternions added are identity quaternions
+        void resize(std::size_t count);
+        void reserve(std::size_t count);
+        void clear();
+
+        void pushBack(const quat<F>& quat);
+
+        // Returns a copy of the quaternion at index i
+        quat<F> get(std::size_t i) const;
+        // Replaces the quaternion at index i
+        void set(std::size_t i, const quat<F>& quat);
+
+        // Normalizes every quaternion, the quaternions of length 0.0 being left untouched.
+        // With math::fast, float goes through the SIMD inverse square root estimate
+        template<Precision P = precise>
+        quat_soa& normalized();
+    };
+
+    namespace detail
+    {
+        // Normalizes (qw, qx, qy, qz), lane by lane, the lanes of length 0.0 being left untouched
+        template<Precision Policy, std::floating_point F, typename P>
+        inline void normalizeLanes(P& qw, P& qx, P& qy, P& qz);
+    }
+}
+
+#include "Math\Quaternions\QuaternionSoA.inl"
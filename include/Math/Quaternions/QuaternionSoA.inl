@@ -0,0 +1,154 @@
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include "Math\Simd\Pack.hpp"
+
+namespace math
+{
+
+    #pragma region Constructors
+
+    template<std::floating_point F>
+    inline quat_soa<F>::quat_soa()
+    {
+    }
+
+    template<std::floating_point F>
+    inline quat_soa<F>::quat_soa(std::size_t count)
+    {
+        resize(count);
+    }
+
+    template<std::floating_point F>
+    inline quat_soa<F>::quat_soa(std::span<const quat<F>> quats)
+    {
+        resize(quats.size());
+
+        for (std::size_t i = 0; i < quats.size(); i++) set(i, quats[i]);
+    }
+
+    #pragma endregion Constructors
+
+    #pragma region Container
+
+    template<std::floating_point F>
+    inline std::size_t quat_soa<F>::size() const
+    {
+        return w.size();
+    }
+
+    template<std::floating_point F>
+    inline bool quat_soa<F>::empty() const
+    {
+        return w.empty();
+    }
+
+    template<std::floating_point F>
+    inline void quat_soa<F>::resize(std::size_t count)
+    {
+        w.resize(count, static_cast<F>(1.0));
+        x.resize(count, static_cast<F>(0.0));
+        y.resize(count, static_cast<F>(0.0));
+        z.resize(count, static_cast<F>(0.0));
+    }
+
+    template<std::floating_point F>
+    inline void quat_soa<F>::reserve(std::size_t count)
+    {
+        w.reserve(count);
+        x.reserve(count);
+        y.reserve(count);
+        z.reserve(count);
+    }
+
+    template<std::floating_point F>
+    inline void quat_soa<F>::clear()
+    {
+        w.clear();
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    template<std::floating_point F>
+    inline void quat_soa<F>::pushBack(const quat<F>& quat)
+    {
+        w.push_back(quat.w);
+        x.push_back(quat.x);
+        y.push_back(quat.y);
+        z.push_back(quat.z);
+    }
+
+    template<std::floating_point F>
+    inline quat<F> quat_soa<F>::get(std::size_t i) const
+    {
+        return quat<F>(w[i], x[i], y[i], z[i]);
+    }
+
+    template<std::floating_point F>
+    inline void quat_soa<F>::set(std::size_t i, const quat<F>& quat)
+    {
+        w[i] = quat.w;
+        x[i] = quat.x;
+        y[i] = quat.y;
+        z[i] = quat.z;
+    }
+
+    #pragma endregion Container
+
+    #pragma region Normalizing
+
+    namespace detail
+    {
+        template<Precision Policy, std::floating_point F, typename P>
+        inline void normalizeLanes(P& qw, P& qx, P& qy, P& qz)
+        {
+            P l = simd::madd(qw, qw, simd::madd(qx, qx, simd::madd(qy, qy, qz * qz)));
+
+            // Lanes of length 0.0 are multiplied by 1.0 instead of 1.0 / 0.0
+            P one = P::broadcast(static_cast<F>(1.0));
+            P safeLength = simd::select(simd::cmpGt(l, P::zero()), l, one);
+
+            P inverseLength;
+            if constexpr (std::same_as<Policy, fast>) inverseLength = simd::rsqrtFast(safeLength);
+            else inverseLength = one / simd::sqrt(safeLength);
+
+            qw = qw * inverseLength;
+            qx = qx * inverseLength;
+            qy = qy * inverseLength;
+            qz = qz * inverseLength;
+        }
+    }
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline quat_soa<F>& quat_soa<F>::normalized()
+    {
+        F* pw = w.data();
+        F* px = x.data();
+        F* py = y.data();
+        F* pz = z.data();
+
+        simd::forEachPack<F>(0, size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P qw = P::loadu(pw + i);
+            P qx = P::loadu(px + i);
+            P qy = P::loadu(py + i);
+            P qz = P::loadu(pz + i);
+
+            detail::normalizeLanes<Policy, F>(qw, qx, qy, qz);
+
+            qw.storeu(pw + i);
+            qx.storeu(px + i);
+            qy.storeu(py + i);
+            qz.storeu(pz + i);
+        });
+
+        return *this;
+    }
+
+    #pragma endregion Normalizing
+}
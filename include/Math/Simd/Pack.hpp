@@ -0,0 +1,491 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "Math\Precision.hpp"
+#include "Math\Simd\Simd.hpp"
+
+namespace math
+{
+    namespace simd
+    {
+        // A pack is a SIMD register holding `width` values of the same floating point type, that the
+        // bulk kernels of the library are written against, so that a kernel is written only once
+        // for float and double, and for AVX, SSE and plain scalar code.
+        //
+        // scalar_pack<F> is the 1 wide fallback, used for long double, for the tail of the arrays
+        // and when no SIMD instruction set is available.
+        // pack<F> is the widest pack available for F.
+        //
+        // A comparison returns a mask of the same pack type, each lane having all its bits set or cleared.
+
+        #pragma region ScalarPack
+
+        template<std::floating_point F>
+        struct scalar_pack
+        {
+            static constexpr std::size_t width = 1;
+
+            F v;
+
+            static constexpr scalar_pack load(const F* ptr) { return { *ptr }; }
+            static constexpr scalar_pack loadu(const F* ptr) { return { *ptr }; }
+            static constexpr scalar_pack broadcast(F value) { return { value }; }
+            static constexpr scalar_pack zero() { return { static_cast<F>(0.0) }; }
+
+            constexpr void store(F* ptr) const { *ptr = v; }
+            constexpr void storeu(F* ptr) const { *ptr = v; }
+            constexpr void stream(F* ptr) const { *ptr = v; }
+
+            constexpr F lane(std::size_t) const { return v; }
+        };
+
+        namespace detail
+        {
+            template<std::floating_point F>
+            struct mask_bits;
+            template<>
+            struct mask_bits<float> { using type = std::uint32_t; };
+            template<>
+            struct mask_bits<double> { using type = std::uint64_t; };
+
+            // long double has no integer of the same size, its masks are stored as 1.0 or 0.0
+            template<std::floating_point F>
+            constexpr F makeMask(bool value)
+            {
+                if constexpr (std::is_same_v<F, long double>)
+                {
+                    return value ? static_cast<F>(1.0) : static_cast<F>(0.0);
+                }
+                else
+                {
+                    using U = typename mask_bits<F>::type;
+                    return std::bit_cast<F>(value ? ~U(0) : U(0));
+                }
+            }
+
+            template<std::floating_point F>
+            constexpr bool isMaskSet(F mask)
+            {
+                if constexpr (std::is_same_v<F, long double>)
+                {
+                    return mask != static_cast<F>(0.0);
+                }
+                else
+                {
+                    using U = typename mask_bits<F>::type;
+                    return std::bit_cast<U>(mask) != U(0);
+                }
+            }
+        }
+
+        template<std::floating_point F>
+        constexpr scalar_pack<F> operator+(scalar_pack<F> a, scalar_pack<F> b) { return { a.v + b.v }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> operator-(scalar_pack<F> a, scalar_pack<F> b) { return { a.v - b.v }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> operator*(scalar_pack<F> a, scalar_pack<F> b) { return { a.v * b.v }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> operator/(scalar_pack<F> a, scalar_pack<F> b) { return { a.v / b.v }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> operator-(scalar_pack<F> a) { return { -a.v }; }
+
+        template<std::floating_point F>
+        inline scalar_pack<F> sqrt(scalar_pack<F> a) { return { static_cast<F>(std::sqrt(a.v)) }; }
+        template<std::floating_point F>
+        inline scalar_pack<F> abs(scalar_pack<F> a) { return { static_cast<F>(std::abs(a.v)) }; }
+        // Returns an approximation of 1.0 / sqrt(a), with the precision of math::approx::rsqrt
+        template<std::floating_point F>
+        inline scalar_pack<F> rsqrtFast(scalar_pack<F> a) { return { approx::rsqrt(a.v) }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> min(scalar_pack<F> a, scalar_pack<F> b) { return { a.v < b.v ? a.v : b.v }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> max(scalar_pack<F> a, scalar_pack<F> b) { return { a.v > b.v ? a.v : b.v }; }
+        // Returns a * b + c
+        template<std::floating_point F>
+        constexpr scalar_pack<F> madd(scalar_pack<F> a, scalar_pack<F> b, scalar_pack<F> c) { return { a.v * b.v + c.v }; }
+
+        template<std::floating_point F>
+        constexpr scalar_pack<F> cmpLt(scalar_pack<F> a, scalar_pack<F> b) { return { detail::makeMask<F>(a.v < b.v) }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> cmpLe(scalar_pack<F> a, scalar_pack<F> b) { return { detail::makeMask<F>(a.v <= b.v) }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> cmpGt(scalar_pack<F> a, scalar_pack<F> b) { return { detail::makeMask<F>(a.v > b.v) }; }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> cmpGe(scalar_pack<F> a, scalar_pack<F> b) { return { detail::makeMask<F>(a.v >= b.v) }; }
+
+        template<std::floating_point F>
+        constexpr scalar_pack<F> maskAnd(scalar_pack<F> a, scalar_pack<F> b)
+        {
+            return { detail::makeMask<F>(detail::isMaskSet(a.v) && detail::isMaskSet(b.v)) };
+        }
+        template<std::floating_point F>
+        constexpr scalar_pack<F> maskOr(scalar_pack<F> a, scalar_pack<F> b)
+        {
+            return { detail::makeMask<F>(detail::isMaskSet(a.v) || detail::isMaskSet(b.v)) };
+        }
+
+        // Returns, for each lane, ifTrue if the mask is set, and ifFalse otherwise
+        template<std::floating_point F>
+        constexpr scalar_pack<F> select(scalar_pack<F> mask, scalar_pack<F> ifTrue, scalar_pack<F> ifFalse)
+        {
+            return { detail::isMaskSet(mask.v) ? ifTrue.v : ifFalse.v };
+        }
+
+        // Returns one bit per lane, set if the mask of that lane is set
+        template<std::floating_point F>
+        constexpr unsigned moveMask(scalar_pack<F> mask) { return detail::isMaskSet(mask.v) ? 1u : 0u; }
+
+        // Transposes the width x width matrix whose rows are the packs of rows : the lane j of rows[i]
+        // becomes the lane i of rows[j]
+        template<std::floating_point F>
+        constexpr void transpose(scalar_pack<F> (&)[1]) {}
+
+        #pragma endregion ScalarPack
+
+    #if defined(MATH_SIMD_AVX)
+
+        #pragma region AvxPacks
+
+        struct avx_float_pack
+        {
+            static constexpr std::size_t width = 8;
+
+            __m256 v;
+
+            static avx_float_pack load(const float* ptr) { return { _mm256_load_ps(ptr) }; }
+            static avx_float_pack loadu(const float* ptr) { return { _mm256_loadu_ps(ptr) }; }
+            static avx_float_pack broadcast(float value) { return { _mm256_set1_ps(value) }; }
+            static avx_float_pack zero() { return { _mm256_setzero_ps() }; }
+
+            void store(float* ptr) const { _mm256_store_ps(ptr, v); }
+            void storeu(float* ptr) const { _mm256_storeu_ps(ptr, v); }
+            // Non-temporal store, that goes around the caches : ptr must be aligned on 32 bytes
+            void stream(float* ptr) const { _mm256_stream_ps(ptr, v); }
+
+            float lane(std::size_t i) const { alignas(32) float tmp[8]; _mm256_store_ps(tmp, v); return tmp[i]; }
+        };
+
+        inline avx_float_pack operator+(avx_float_pack a, avx_float_pack b) { return { _mm256_add_ps(a.v, b.v) }; }
+        inline avx_float_pack operator-(avx_float_pack a, avx_float_pack b) { return { _mm256_sub_ps(a.v, b.v) }; }
+        inline avx_float_pack operator*(avx_float_pack a, avx_float_pack b) { return { _mm256_mul_ps(a.v, b.v) }; }
+        inline avx_float_pack operator/(avx_float_pack a, avx_float_pack b) { return { _mm256_div_ps(a.v, b.v) }; }
+        inline avx_float_pack operator-(avx_float_pack a) { return { _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)) }; }
+
+        inline avx_float_pack sqrt(avx_float_pack a) { return { _mm256_sqrt_ps(a.v) }; }
+        inline avx_float_pack abs(avx_float_pack a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+        inline avx_float_pack rsqrtFast(avx_float_pack a)
+        {
+            // The 12 bits estimate, refined by one Newton step
+            __m256 e = _mm256_rsqrt_ps(a.v);
+            __m256 halfA = _mm256_mul_ps(_mm256_set1_ps(0.5f), a.v);
+
+            return { _mm256_mul_ps(e, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(halfA, _mm256_mul_ps(e, e)))) };
+        }
+        inline avx_float_pack min(avx_float_pack a, avx_float_pack b) { return { _mm256_min_ps(a.v, b.v) }; }
+        inline avx_float_pack max(avx_float_pack a, avx_float_pack b) { return { _mm256_max_ps(a.v, b.v) }; }
+        inline avx_float_pack madd(avx_float_pack a, avx_float_pack b, avx_float_pack c)
+        {
+        #if defined(MATH_SIMD_FMA)
+            return { _mm256_fmadd_ps(a.v, b.v, c.v) };
+        #else
+            return { _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v) };
+        #endif
+        }
+
+        inline avx_float_pack cmpLt(avx_float_pack a, avx_float_pack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+        inline avx_float_pack cmpLe(avx_float_pack a, avx_float_pack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+        inline avx_float_pack cmpGt(avx_float_pack a, avx_float_pack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+        inline avx_float_pack cmpGe(avx_float_pack a, avx_float_pack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+
+        inline avx_float_pack maskAnd(avx_float_pack a, avx_float_pack b) { return { _mm256_and_ps(a.v, b.v) }; }
+        inline avx_float_pack maskOr(avx_float_pack a, avx_float_pack b) { return { _mm256_or_ps(a.v, b.v) }; }
+
+        inline avx_float_pack select(avx_float_pack mask, avx_float_pack ifTrue, avx_float_pack ifFalse)
+        {
+            return { _mm256_blendv_ps(ifFalse.v, ifTrue.v, mask.v) };
+        }
+
+        inline unsigned moveMask(avx_float_pack mask) { return static_cast<unsigned>(_mm256_movemask_ps(mask.v)); }
+
+        inline void transpose(avx_float_pack (&rows)[8])
+        {
+            // Interleaves the pairs of rows, then the pairs of pairs within each 128 bits half, then swaps the halves
+            __m256 t0 = _mm256_unpacklo_ps(rows[0].v, rows[1].v);
+            __m256 t1 = _mm256_unpackhi_ps(rows[0].v, rows[1].v);
+            __m256 t2 = _mm256_unpacklo_ps(rows[2].v, rows[3].v);
+            __m256 t3 = _mm256_unpackhi_ps(rows[2].v, rows[3].v);
+            __m256 t4 = _mm256_unpacklo_ps(rows[4].v, rows[5].v);
+            __m256 t5 = _mm256_unpackhi_ps(rows[4].v, rows[5].v);
+            __m256 t6 = _mm256_unpacklo_ps(rows[6].v, rows[7].v);
+            __m256 t7 = _mm256_unpackhi_ps(rows[6].v, rows[7].v);
+
+            __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+            rows[0].v = _mm256_permute2f128_ps(s0, s4, 0x20);
+            rows[1].v = _mm256_permute2f128_ps(s1, s5, 0x20);
+            rows[2].v = _mm256_permute2f128_ps(s2, s6, 0x20);
+            rows[3].v = _mm256_permute2f128_ps(s3, s7, 0x20);
+            rows[4].v = _mm256_permute2f128_ps(s0, s4, 0x31);
+            rows[5].v = _mm256_permute2f128_ps(s1, s5, 0x31);
+            rows[6].v = _mm256_permute2f128_ps(s2, s6, 0x31);
+            rows[7].v = _mm256_permute2f128_ps(s3, s7, 0x31);
+        }
+
+
+        struct avx_double_pack
+        {
+            static constexpr std::size_t width = 4;
+
+            __m256d v;
+
+            static avx_double_pack load(const double* ptr) { return { _mm256_load_pd(ptr) }; }
+            static avx_double_pack loadu(const double* ptr) { return { _mm256_loadu_pd(ptr) }; }
+            static avx_double_pack broadcast(double value) { return { _mm256_set1_pd(value) }; }
+            static avx_double_pack zero() { return { _mm256_setzero_pd() }; }
+
+            void store(double* ptr) const { _mm256_store_pd(ptr, v); }
+            void storeu(double* ptr) const { _mm256_storeu_pd(ptr, v); }
+            // Non-temporal store, that goes around the caches : ptr must be aligned on 32 bytes
+            void stream(double* ptr) const { _mm256_stream_pd(ptr, v); }
+
+            double lane(std::size_t i) const { alignas(32) double tmp[4]; _mm256_store_pd(tmp, v); return tmp[i]; }
+        };
+
+        inline avx_double_pack operator+(avx_double_pack a, avx_double_pack b) { return { _mm256_add_pd(a.v, b.v) }; }
+        inline avx_double_pack operator-(avx_double_pack a, avx_double_pack b) { return { _mm256_sub_pd(a.v, b.v) }; }
+        inline avx_double_pack operator*(avx_double_pack a, avx_double_pack b) { return { _mm256_mul_pd(a.v, b.v) }; }
+        inline avx_double_pack operator/(avx_double_pack a, avx_double_pack b) { return { _mm256_div_pd(a.v, b.v) }; }
+        inline avx_double_pack operator-(avx_double_pack a) { return { _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0)) }; }
+
+        inline avx_double_pack sqrt(avx_double_pack a) { return { _mm256_sqrt_pd(a.v) }; }
+        inline avx_double_pack abs(avx_double_pack a) { return { _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v) }; }
+        inline avx_double_pack rsqrtFast(avx_double_pack a) { return { _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(a.v)) }; }
+        inline avx_double_pack min(avx_double_pack a, avx_double_pack b) { return { _mm256_min_pd(a.v, b.v) }; }
+        inline avx_double_pack max(avx_double_pack a, avx_double_pack b) { return { _mm256_max_pd(a.v, b.v) }; }
+        inline avx_double_pack madd(avx_double_pack a, avx_double_pack b, avx_double_pack c)
+        {
+        #if defined(MATH_SIMD_FMA)
+            return { _mm256_fmadd_pd(a.v, b.v, c.v) };
+        #else
+            return { _mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v) };
+        #endif
+        }
+
+        inline avx_double_pack cmpLt(avx_double_pack a, avx_double_pack b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+        inline avx_double_pack cmpLe(avx_double_pack a, avx_double_pack b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; }
+        inline avx_double_pack cmpGt(avx_double_pack a, avx_double_pack b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+        inline avx_double_pack cmpGe(avx_double_pack a, avx_double_pack b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ) }; }
+
+        inline avx_double_pack maskAnd(avx_double_pack a, avx_double_pack b) { return { _mm256_and_pd(a.v, b.v) }; }
+        inline avx_double_pack maskOr(avx_double_pack a, avx_double_pack b) { return { _mm256_or_pd(a.v, b.v) }; }
+
+        inline avx_double_pack select(avx_double_pack mask, avx_double_pack ifTrue, avx_double_pack ifFalse)
+        {
+            return { _mm256_blendv_pd(ifFalse.v, ifTrue.v, mask.v) };
+        }
+
+        inline unsigned moveMask(avx_double_pack mask) { return static_cast<unsigned>(_mm256_movemask_pd(mask.v)); }
+
+        inline void transpose(avx_double_pack (&rows)[4])
+        {
+            __m256d t0 = _mm256_unpacklo_pd(rows[0].v, rows[1].v);
+            __m256d t1 = _mm256_unpackhi_pd(rows[0].v, rows[1].v);
+            __m256d t2 = _mm256_unpacklo_pd(rows[2].v, rows[3].v);
+            __m256d t3 = _mm256_unpackhi_pd(rows[2].v, rows[3].v);
+
+            rows[0].v = _mm256_permute2f128_pd(t0, t2, 0x20);
+            rows[1].v = _mm256_permute2f128_pd(t1, t3, 0x20);
+            rows[2].v = _mm256_permute2f128_pd(t0, t2, 0x31);
+            rows[3].v = _mm256_permute2f128_pd(t1, t3, 0x31);
+        }
+
+        #pragma endregion AvxPacks
+
+    #elif defined(MATH_SIMD_SSE)
+
+        #pragma region SsePacks
+
+        struct sse_float_pack
+        {
+            static constexpr std::size_t width = 4;
+
+            __m128 v;
+
+            static sse_float_pack load(const float* ptr) { return { _mm_load_ps(ptr) }; }
+            static sse_float_pack loadu(const float* ptr) { return { _mm_loadu_ps(ptr) }; }
+            static sse_float_pack broadcast(float value) { return { _mm_set1_ps(value) }; }
+            static sse_float_pack zero() { return { _mm_setzero_ps() }; }
+
+            void store(float* ptr) const { _mm_store_ps(ptr, v); }
+            void storeu(float* ptr) const { _mm_storeu_ps(ptr, v); }
+            // Non-temporal store, that goes around the caches : ptr must be aligned on 16 bytes
+            void stream(float* ptr) const { _mm_stream_ps(ptr, v); }
+
+            float lane(std::size_t i) const { alignas(16) float tmp[4]; _mm_store_ps(tmp, v); return tmp[i]; }
+        };
+
+        inline sse_float_pack operator+(sse_float_pack a, sse_float_pack b) { return { _mm_add_ps(a.v, b.v) }; }
+        inline sse_float_pack operator-(sse_float_pack a, sse_float_pack b) { return { _mm_sub_ps(a.v, b.v) }; }
+        inline sse_float_pack operator*(sse_float_pack a, sse_float_pack b) { return { _mm_mul_ps(a.v, b.v) }; }
+        inline sse_float_pack operator/(sse_float_pack a, sse_float_pack b) { return { _mm_div_ps(a.v, b.v) }; }
+        inline sse_float_pack operator-(sse_float_pack a) { return { _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)) }; }
+
+        inline sse_float_pack sqrt(sse_float_pack a) { return { _mm_sqrt_ps(a.v) }; }
+        inline sse_float_pack abs(sse_float_pack a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+        inline sse_float_pack rsqrtFast(sse_float_pack a)
+        {
+            __m128 e = _mm_rsqrt_ps(a.v);
+            __m128 halfA = _mm_mul_ps(_mm_set1_ps(0.5f), a.v);
+
+            return { _mm_mul_ps(e, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfA, _mm_mul_ps(e, e)))) };
+        }
+        inline sse_float_pack min(sse_float_pack a, sse_float_pack b) { return { _mm_min_ps(a.v, b.v) }; }
+        inline sse_float_pack max(sse_float_pack a, sse_float_pack b) { return { _mm_max_ps(a.v, b.v) }; }
+        inline sse_float_pack madd(sse_float_pack a, sse_float_pack b, sse_float_pack c) { return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) }; }
+
+        inline sse_float_pack cmpLt(sse_float_pack a, sse_float_pack b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+        inline sse_float_pack cmpLe(sse_float_pack a, sse_float_pack b) { return { _mm_cmple_ps(a.v, b.v) }; }
+        inline sse_float_pack cmpGt(sse_float_pack a, sse_float_pack b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+        inline sse_float_pack cmpGe(sse_float_pack a, sse_float_pack b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+
+        inline sse_float_pack maskAnd(sse_float_pack a, sse_float_pack b) { return { _mm_and_ps(a.v, b.v) }; }
+        inline sse_float_pack maskOr(sse_float_pack a, sse_float_pack b) { return { _mm_or_ps(a.v, b.v) }; }
+
+        inline sse_float_pack select(sse_float_pack mask, sse_float_pack ifTrue, sse_float_pack ifFalse)
+        {
+            return { _mm_or_ps(_mm_and_ps(mask.v, ifTrue.v), _mm_andnot_ps(mask.v, ifFalse.v)) };
+        }
+
+        inline unsigned moveMask(sse_float_pack mask) { return static_cast<unsigned>(_mm_movemask_ps(mask.v)); }
+
+        inline void transpose(sse_float_pack (&rows)[4])
+        {
+            _MM_TRANSPOSE4_PS(rows[0].v, rows[1].v, rows[2].v, rows[3].v);
+        }
+
+
+        struct sse_double_pack
+        {
+            static constexpr std::size_t width = 2;
+
+            __m128d v;
+
+            static sse_double_pack load(const double* ptr) { return { _mm_load_pd(ptr) }; }
+            static sse_double_pack loadu(const double* ptr) { return { _mm_loadu_pd(ptr) }; }
+            static sse_double_pack broadcast(double value) { return { _mm_set1_pd(value) }; }
+            static sse_double_pack zero() { return { _mm_setzero_pd() }; }
+
+            void store(double* ptr) const { _mm_store_pd(ptr, v); }
+            void storeu(double* ptr) const { _mm_storeu_pd(ptr, v); }
+            // Non-temporal store, that goes around the caches : ptr must be aligned on 16 bytes
+            void stream(double* ptr) const { _mm_stream_pd(ptr, v); }
+
+            double lane(std::size_t i) const { alignas(16) double tmp[2]; _mm_store_pd(tmp, v); return tmp[i]; }
+        };
+
+        inline sse_double_pack operator+(sse_double_pack a, sse_double_pack b) { return { _mm_add_pd(a.v, b.v) }; }
+        inline sse_double_pack operator-(sse_double_pack a, sse_double_pack b) { return { _mm_sub_pd(a.v, b.v) }; }
+        inline sse_double_pack operator*(sse_double_pack a, sse_double_pack b) { return { _mm_mul_pd(a.v, b.v) }; }
+        inline sse_double_pack operator/(sse_double_pack a, sse_double_pack b) { return { _mm_div_pd(a.v, b.v) }; }
+        inline sse_double_pack operator-(sse_double_pack a) { return { _mm_xor_pd(a.v, _mm_set1_pd(-0.0)) }; }
+
+        inline sse_double_pack sqrt(sse_double_pack a) { return { _mm_sqrt_pd(a.v) }; }
+        inline sse_double_pack abs(sse_double_pack a) { return { _mm_andnot_pd(_mm_set1_pd(-0.0), a.v) }; }
+        inline sse_double_pack rsqrtFast(sse_double_pack a) { return { _mm_div_pd(_mm_set1_pd(1.0), _mm_sqrt_pd(a.v)) }; }
+        inline sse_double_pack min(sse_double_pack a, sse_double_pack b) { return { _mm_min_pd(a.v, b.v) }; }
+        inline sse_double_pack max(sse_double_pack a, sse_double_pack b) { return { _mm_max_pd(a.v, b.v) }; }
+        inline sse_double_pack madd(sse_double_pack a, sse_double_pack b, sse_double_pack c) { return { _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v) }; }
+
+        inline sse_double_pack cmpLt(sse_double_pack a, sse_double_pack b) { return { _mm_cmplt_pd(a.v, b.v) }; }
+        inline sse_double_pack cmpLe(sse_double_pack a, sse_double_pack b) { return { _mm_cmple_pd(a.v, b.v) }; }
+        inline sse_double_pack cmpGt(sse_double_pack a, sse_double_pack b) { return { _mm_cmpgt_pd(a.v, b.v) }; }
+        inline sse_double_pack cmpGe(sse_double_pack a, sse_double_pack b) { return { _mm_cmpge_pd(a.v, b.v) }; }
+
+        inline sse_double_pack maskAnd(sse_double_pack a, sse_double_pack b) { return { _mm_and_pd(a.v, b.v) }; }
+        inline sse_double_pack maskOr(sse_double_pack a, sse_double_pack b) { return { _mm_or_pd(a.v, b.v) }; }
+
+        inline sse_double_pack select(sse_double_pack mask, sse_double_pack ifTrue, sse_double_pack ifFalse)
+        {
+            return { _mm_or_pd(_mm_and_pd(mask.v, ifTrue.v), _mm_andnot_pd(mask.v, ifFalse.v)) };
+        }
+
+        inline unsigned moveMask(sse_double_pack mask) { return static_cast<unsigned>(_mm_movemask_pd(mask.v)); }
+
+        inline void transpose(sse_double_pack (&rows)[2])
+        {
+            __m128d t = _mm_unpacklo_pd(rows[0].v, rows[1].v);
+            rows[1].v = _mm_unpackhi_pd(rows[0].v, rows[1].v);
+            rows[0].v = t;
+        }
+
+        #pragma endregion SsePacks
+
+    #endif
+
+        #pragma region PackSelection
+
+        namespace detail
+        {
+            template<std::floating_point F>
+            struct native_pack { using type = scalar_pack<F>; };
+
+        #if defined(MATH_SIMD_AVX)
+            template<>
+            struct native_pack<float> { using type = avx_float_pack; };
+            template<>
+            struct native_pack<double> { using type = avx_double_pack; };
+        #elif defined(MATH_SIMD_SSE)
+            template<>
+            struct native_pack<float> { using type = sse_float_pack; };
+            template<>
+            struct native_pack<double> { using type = sse_double_pack; };
+        #endif
+        }
+
+        template<std::floating_point F>
+        using pack = typename detail::native_pack<F>::type;
+
+        // Orders the streaming stores of the calling thread before its next stores, so that the values
+        // written with stream() are visible to the threads that synchronize with it afterwards
+        inline void streamFence()
+        {
+        #if defined(MATH_SIMD_SSE)
+            _mm_sfence();
+        #endif
+        }
+
+        // Calls kernel(P{}, i) for every index i of [begin, end) that starts a full pack<F>, then
+        // kernel(scalar_pack<F>{}, i) for the remaining indices, the kernel being a generic lambda
+        // that reads the pack type from its first parameter
+        template<std::floating_point F, typename Kernel>
+        inline void forEachPack(std::size_t begin, std::size_t end, Kernel&& kernel)
+        {
+            using P = pack<F>;
+
+            std::size_t i = begin;
+
+            for (; i + P::width <= end; i += P::width)
+            {
+                kernel(P{}, i);
+            }
+            for (; i < end; i++)
+            {
+                kernel(scalar_pack<F>{}, i);
+            }
+        }
+
+        #pragma endregion PackSelection
+    }
+}
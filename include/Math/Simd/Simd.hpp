@@ -0,0 +1,30 @@
+#pragma once
+
+// Detects which SIMD instruction sets the compiler is allowed to emit, and exposes them
+// as MATH_SIMD_* macros. Define MATH_NO_SIMD before including any math header to force
+// every type back onto its scalar path.
+
+#if !defined(MATH_NO_SIMD)
+
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define MATH_SIMD_SSE 1
+    #endif
+
+    #if defined(__AVX__)
+        #define MATH_SIMD_AVX 1
+    #endif
+
+    #if defined(__AVX2__)
+        #define MATH_SIMD_AVX2 1
+    #endif
+
+    // MSVC has no __FMA__ macro, but every CPU with AVX2 also has FMA3
+    #if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+        #define MATH_SIMD_FMA 1
+    #endif
+
+#endif
+
+#if defined(MATH_SIMD_SSE)
+    #include <immintrin.h>
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace math
+{
+    // A pool of worker threads, created once and reused by every bulk kernel of the library, so
+    // that splitting a kernel across the cores does not cost a thread creation per call.
+    //
+    // The calling thread always takes part in the work, and helps running the queued tasks while
+    // it waits, so a parallelFor can safely be called from inside another one.
+    class thread_pool
+    {
+    public:
+        // Returns the pool shared by the whole library, with one worker per hardware thread but one
+        static thread_pool& instance();
+
+        // Creates a pool of workerCount threads (0 runs everything on the calling thread)
+        explicit thread_pool(std::size_t workerCount);
+        ~thread_pool();
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        // Returns the number of threads that can run a task at the same time, the caller included
+        std::size_t concurrency() const;
+
+        // Calls fn(begin, end) on consecutive sub-ranges of [0, count) from every thread of the pool,
+        // each sub-range holding at least minChunk indices (but the last one), and returns once the
+        // whole range has been processed.
+        // If fn throws, the sub-ranges not started yet are skipped, and the first exception is rethrown
+        // on the calling thread once every thread has stopped using fn
+        template<typename Fn>
+        void parallelFor(std::size_t count, std::size_t minChunk, Fn&& fn);
+
+    private:
+        void workerLoop();
+        bool runOneTask();
+
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        bool stopping = false;
+    };
+
+    // Shortcut for thread_pool::instance().parallelFor(count, minChunk, fn)
+    template<typename Fn>
+    inline void parallelFor(std::size_t count, std::size_t minChunk, Fn&& fn)
+    {
+        thread_pool::instance().parallelFor(count, minChunk, std::forward<Fn>(fn));
+    }
+}
+
+#include "Math\Threading\ThreadPool.inl"
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace math
+{
+    inline thread_pool& thread_pool::instance()
+    {
+        static thread_pool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+        return pool;
+    }
+
+    inline thread_pool::thread_pool(std::size_t workerCount)
+    {
+        workers.reserve(workerCount);
+
+        for (std::size_t i = 0; i < workerCount; i++)
+        {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    inline thread_pool::~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        wakeUp.notify_all();
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    inline std::size_t thread_pool::concurrency() const
+    {
+        return workers.size() + 1;
+    }
+
+    inline void thread_pool::workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+                if (tasks.empty()) return;
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+    inline bool thread_pool::runOneTask()
+    {
+        std::function<void()> task;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (tasks.empty()) return false;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+
+        return true;
+    }
+
+    template<typename Fn>
+    inline void thread_pool::parallelFor(std::size_t count, std::size_t minChunk, Fn&& fn)
+    {
+        if (count == 0) return;
+
+        minChunk = std::max<std::size_t>(minChunk, 1);
+
+        // A few chunks per thread, so that a thread that is late (or busy elsewhere) does not hold everyone
+        std::size_t chunkCount = std::min((count + minChunk - 1) / minChunk, concurrency() * 4);
+
+        if (chunkCount <= 1 || workers.empty())
+        {
+            fn(static_cast<std::size_t>(0), count);
+            return;
+        }
+
+        std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        std::atomic<std::size_t> nextChunk = 0;
+        std::atomic<std::size_t> pendingHelpers = 0;
+
+        // The first exception thrown by fn, on any thread, written by the thread that sets failed
+        std::atomic<bool> failed = false;
+        std::exception_ptr error;
+
+        // Never throws : an exception must not leave a helper without decrementing pendingHelpers,
+        // nor the caller without waiting for the helpers
+        auto work = [&]()
+        {
+            try
+            {
+                std::size_t chunk;
+
+                while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount)
+                {
+                    std::size_t begin = chunk * chunkSize;
+                    fn(begin, std::min(begin + chunkSize, count));
+                }
+            }
+            catch (...)
+            {
+                if (!failed.exchange(true, std::memory_order_relaxed)) error = std::current_exception();
+
+                // The chunks not started yet are skipped
+                nextChunk.store(chunkCount, std::memory_order_relaxed);
+            }
+        };
+
+        std::size_t helperCount = std::min(workers.size(), chunkCount - 1);
+        pendingHelpers.store(helperCount, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            for (std::size_t i = 0; i < helperCount; i++)
+            {
+                tasks.emplace_back([&]()
+                {
+                    work();
+                    pendingHelpers.fetch_sub(1, std::memory_order_release);
+                });
+            }
+        }
+
+        wakeUp.notify_all();
+
+        work();
+
+        // The helpers still reference this stack frame : wait for all of them, running queued
+        // tasks meanwhile so that nested calls cannot starve the pool
+        while (pendingHelpers.load(std::memory_order_acquire) != 0)
+        {
+            if (!runOneTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // The release of pendingHelpers made the error written by a helper visible
+        if (error) std::rethrow_exception(error);
+    }
+}
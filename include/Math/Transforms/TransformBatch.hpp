@@ -0,0 +1,49 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "Math\Precision.hpp"
+#include "Math\Matrices\Matrix4x4.hpp"
+#include "Math\Quaternions\QuaternionSoA.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
+
+namespace math
+{
+    // Bulk conversions between the positions, rotations and scales of many instances, stored as
+    // structures of arrays, and their T * R * S matrices.
+    //
+    // A block of pack<F>::width instances is computed lane by lane, with the closed form of
+    // quat::toMat4 scaled by column, then transposed into whole matrices. The instances are split
+    // across the threads of math::thread_pool.
+
+    // Writes T * R * S in out[i] for every instance i, the rotations being unit quaternions and the
+    // three arrays having the same size. out must hold at least positions.size() matrices.
+    // When the matrices written are larger than detail::streamingStoreBytes, and out is aligned on a
+    // SIMD register (as with aligned_allocator), they are written with non-temporal stores : they go
+    // straight to memory instead of evicting the caches, and are not read from memory before being written
+    template<std::floating_point F>
+    void composeTransforms(const vec3_soa<F>& positions, const quat_soa<F>& rotations, const vec3_soa<F>& scales, std::type_identity_t<std::span<mat4<F>>> out);
+
+    // Splits every matrix of mats into a position, a rotation and a scale, the inverse of composeTransforms.
+    // The outputs are resized if needed. The scale of each axis is the length of its column, a matrix that
+    // mirrors space getting a negative x scale, and the rotation is the one of the normalized columns.
+    // A matrix with an axis of scale 0.0 has no exact rotation : it still gets a unit quaternion.
+    // Policy is the precision of the square roots
+    template<Precision Policy = precise, std::floating_point F>
+    void decomposeTransforms(std::type_identity_t<std::span<const mat4<F>>> mats, vec3_soa<F>& positions, quat_soa<F>& rotations, vec3_soa<F>& scales);
+
+    namespace detail
+    {
+        // The number of instances a thread processes at least
+        inline constexpr std::size_t transformBatchChunkSize = 4096;
+
+        // The size of output below which composeTransforms stores normally : the matrices then fit in the
+        // caches, where the pass that reads them next finds them
+        inline constexpr std::size_t streamingStoreBytes = std::size_t(1) << 20;
+    }
+}
+
+#include "Math\Transforms\TransformBatch.inl"
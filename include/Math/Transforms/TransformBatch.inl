@@ -0,0 +1,259 @@
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "Math\Simd\Pack.hpp"
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    namespace detail
+    {
+        // Writes the 16 values of the matrices of a block, values[col * 4 + row] holding that value for every
+        // matrix of the block, to the matrices out[0], out[1]... : each group of P::width values is transposed,
+        // so that each pack holds a run of values of one matrix. The matrices are then written one after the
+        // other, so that the streaming stores fill each cache line at once
+        template<bool Stream, std::floating_point F, typename P>
+        inline void storeMat4Block(P (&values)[16], mat4<F>* out)
+        {
+            constexpr std::size_t groupCount = 16 / P::width;
+
+            P groups[groupCount][P::width];
+
+            for (std::size_t group = 0; group < groupCount; group++)
+            {
+                for (std::size_t lane = 0; lane < P::width; lane++) groups[group][lane] = values[group * P::width + lane];
+
+                simd::transpose(groups[group]);
+            }
+
+            for (std::size_t lane = 0; lane < P::width; lane++)
+            {
+                for (std::size_t group = 0; group < groupCount; group++)
+                {
+                    F* dst = &out[lane].columns[0][0] + group * P::width;
+
+                    if constexpr (Stream) groups[group][lane].stream(dst);
+                    else groups[group][lane].storeu(dst);
+                }
+            }
+        }
+
+        // The inverse of storeMat4Block
+        template<std::floating_point F, typename P>
+        inline void loadMat4Block(const mat4<F>* in, P (&values)[16])
+        {
+            for (std::size_t group = 0; group < 16; group += P::width)
+            {
+                P lanes[P::width];
+                for (std::size_t lane = 0; lane < P::width; lane++) lanes[lane] = P::loadu(&in[lane].columns[0][0] + group);
+
+                simd::transpose(lanes);
+
+                for (std::size_t lane = 0; lane < P::width; lane++) values[group + lane] = lanes[lane];
+            }
+        }
+
+        template<bool Stream, std::floating_point F>
+        inline void composeTransformRange(const vec3_soa<F>& positions, const quat_soa<F>& rotations, const vec3_soa<F>& scales,
+                                          mat4<F>* out, std::size_t begin, std::size_t end)
+        {
+            const F* px = positions.x.data(); const F* py = positions.y.data(); const F* pz = positions.z.data();
+            const F* qw = rotations.w.data(); const F* qx = rotations.x.data();
+            const F* qy = rotations.y.data(); const F* qz = rotations.z.data();
+            const F* sx = scales.x.data(); const F* sy = scales.y.data(); const F* sz = scales.z.data();
+
+            simd::forEachPack<F>(begin, end, [=](auto p, std::size_t i)
+            {
+                using P = decltype(p);
+
+                P w = P::loadu(qw + i);
+                P x = P::loadu(qx + i);
+                P y = P::loadu(qy + i);
+                P z = P::loadu(qz + i);
+
+                // Same closed form as scaledRotation, the factor 2.0 being folded in x2, y2 and z2
+                P two = P::broadcast(static_cast<F>(2.0));
+                P one = P::broadcast(static_cast<F>(1.0));
+
+                P x2 = x * two;
+                P y2 = y * two;
+                P z2 = z * two;
+
+                P xx = x * x2; P yy = y * y2; P zz = z * z2;
+                P xy = x * y2; P xz = x * z2; P yz = y * z2;
+                P wx = w * x2; P wy = w * y2; P wz = w * z2;
+
+                P scaleX = P::loadu(sx + i);
+                P scaleY = P::loadu(sy + i);
+                P scaleZ = P::loadu(sz + i);
+
+                P values[16];
+
+                values[0]  = (one - (yy + zz)) * scaleX;
+                values[1]  = (xy + wz) * scaleX;
+                values[2]  = (xz - wy) * scaleX;
+                values[3]  = P::zero();
+
+                values[4]  = (xy - wz) * scaleY;
+                values[5]  = (one - (xx + zz)) * scaleY;
+                values[6]  = (yz + wx) * scaleY;
+                values[7]  = P::zero();
+
+                values[8]  = (xz + wy) * scaleZ;
+                values[9]  = (yz - wx) * scaleZ;
+                values[10] = (one - (xx + yy)) * scaleZ;
+                values[11] = P::zero();
+
+                values[12] = P::loadu(px + i);
+                values[13] = P::loadu(py + i);
+                values[14] = P::loadu(pz + i);
+                values[15] = one;
+
+                storeMat4Block<Stream, F>(values, out + i);
+            });
+
+            if constexpr (Stream) simd::streamFence();
+        }
+
+        // Writes in (qw, qx, qy, qz) the rotation of the orthonormal matrix r (r[col][row]), lane by lane, after
+        // Shepperd : the quaternion is built from its largest component, chosen between w and the 3 others by
+        // masks, whose square is t / 4, the other ones being found from the sums and differences of the
+        // opposite values of r. Every component being a multiple of the same factor, the quaternion is
+        // normalized at the end instead of dividing by that factor
+        template<Precision Policy, std::floating_point F, typename P>
+        inline void rotationLanes(const P (&r)[3][3], P& qw, P& qx, P& qy, P& qz)
+        {
+            P zero = P::zero();
+            P one = P::broadcast(static_cast<F>(1.0));
+            P minusOne = P::broadcast(static_cast<F>(-1.0));
+
+            P d0 = r[0][0];
+            P d1 = r[1][1];
+            P d2 = r[2][2];
+
+            // w is the largest when the trace is positive, x, y or z when its diagonal value is the largest
+            P notW = simd::cmpLe(d0 + d1 + d2, zero);
+            P isX = simd::maskAnd(notW, simd::maskAnd(simd::cmpGe(d0, d1), simd::cmpGe(d0, d2)));
+            P isY = simd::maskAnd(notW, simd::maskAnd(simd::cmpGt(d1, d0), simd::cmpGe(d1, d2)));
+            P isZ = simd::maskAnd(notW, simd::maskAnd(simd::cmpGt(d2, d0), simd::cmpGt(d2, d1)));
+
+            P signX = simd::select(simd::maskOr(isY, isZ), minusOne, one);
+            P signY = simd::select(simd::maskOr(isX, isZ), minusOne, one);
+            P signZ = simd::select(simd::maskOr(isX, isY), minusOne, one);
+
+            P t = simd::madd(signX, d0, simd::madd(signY, d1, simd::madd(signZ, d2, one)));
+
+            P a = r[1][2] - r[2][1];
+            P b = r[2][0] - r[0][2];
+            P c = r[0][1] - r[1][0];
+            P xy = r[0][1] + r[1][0];
+            P xz = r[2][0] + r[0][2];
+            P yz = r[1][2] + r[2][1];
+
+            qw = simd::select(isX, a, simd::select(isY, b, simd::select(isZ, c, t)));
+            qx = simd::select(isX, t, simd::select(isY, xy, simd::select(isZ, xz, a)));
+            qy = simd::select(isX, xy, simd::select(isY, t, simd::select(isZ, yz, b)));
+            qz = simd::select(isX, xz, simd::select(isY, yz, simd::select(isZ, t, c)));
+
+            normalizeLanes<Policy, F>(qw, qx, qy, qz);
+        }
+    }
+
+    template<std::floating_point F>
+    inline void composeTransforms(const vec3_soa<F>& positions, const quat_soa<F>& rotations, const vec3_soa<F>& scales, std::type_identity_t<std::span<mat4<F>>> out)
+    {
+        std::size_t count = positions.size();
+        mat4<F>* res = out.data();
+
+        // Each matrix is a whole number of packs, so they are all aligned when the first one is
+        bool aligned = reinterpret_cast<std::uintptr_t>(res) % (simd::pack<F>::width * sizeof(F)) == 0;
+        bool stream = aligned && count * sizeof(mat4<F>) >= detail::streamingStoreBytes;
+
+        math::parallelFor(count, detail::transformBatchChunkSize, [&, res, stream](std::size_t begin, std::size_t end)
+        {
+            if (stream) detail::composeTransformRange<true>(positions, rotations, scales, res, begin, end);
+            else detail::composeTransformRange<false>(positions, rotations, scales, res, begin, end);
+        });
+    }
+
+    template<Precision Policy, std::floating_point F>
+    inline void decomposeTransforms(std::type_identity_t<std::span<const mat4<F>>> mats, vec3_soa<F>& positions, quat_soa<F>& rotations, vec3_soa<F>& scales)
+    {
+        positions.resize(mats.size());
+        rotations.resize(mats.size());
+        scales.resize(mats.size());
+
+        const mat4<F>* in = mats.data();
+        F* px = positions.x.data(); F* py = positions.y.data(); F* pz = positions.z.data();
+        F* qw = rotations.w.data(); F* qx = rotations.x.data();
+        F* qy = rotations.y.data(); F* qz = rotations.z.data();
+        F* sx = scales.x.data(); F* sy = scales.y.data(); F* sz = scales.z.data();
+
+        math::parallelFor(mats.size(), detail::transformBatchChunkSize, [=](std::size_t begin, std::size_t end)
+        {
+            simd::forEachPack<F>(begin, end, [=](auto p, std::size_t i)
+            {
+                using P = decltype(p);
+
+                P values[16];
+                detail::loadMat4Block<F>(in + i, values);
+
+                values[12].storeu(px + i);
+                values[13].storeu(py + i);
+                values[14].storeu(pz + i);
+
+                P r[3][3];
+                P scale[3];
+
+                P zero = P::zero();
+                P one = P::broadcast(static_cast<F>(1.0));
+
+                // det(columns) = col0 . (col1 x col2), negative for a mirroring matrix
+                P crossX = values[5] * values[10] - values[6] * values[9];
+                P crossY = values[6] * values[8] - values[4] * values[10];
+                P crossZ = values[4] * values[9] - values[5] * values[8];
+                P det = simd::madd(values[0], crossX, simd::madd(values[1], crossY, values[2] * crossZ));
+                P sign = simd::select(simd::cmpLt(det, zero), P::broadcast(static_cast<F>(-1.0)), one);
+
+                for (std::size_t col = 0; col < 3; col++)
+                {
+                    const P* column = values + col * 4;
+
+                    P lengthSquared = simd::madd(column[0], column[0], simd::madd(column[1], column[1], column[2] * column[2]));
+
+                    // Columns of length 0.0 are multiplied by 1.0 instead of 1.0 / 0.0
+                    P nonZero = simd::cmpGt(lengthSquared, zero);
+                    P safeLengthSquared = simd::select(nonZero, lengthSquared, one);
+
+                    P inverseLength;
+                    if constexpr (std::same_as<Policy, fast>) inverseLength = simd::rsqrtFast(safeLengthSquared);
+                    else inverseLength = one / simd::sqrt(safeLengthSquared);
+
+                    scale[col] = simd::select(nonZero, lengthSquared * inverseLength, zero);
+                    if (col == 0)
+                    {
+                        scale[col] = scale[col] * sign;
+                        inverseLength = inverseLength * sign;
+                    }
+
+                    for (std::size_t row = 0; row < 3; row++) r[col][row] = column[row] * inverseLength;
+                }
+
+                scale[0].storeu(sx + i);
+                scale[1].storeu(sy + i);
+                scale[2].storeu(sz + i);
+
+                P w, x, y, z;
+                detail::rotationLanes<Policy, F>(r, w, x, y, z);
+
+                w.storeu(qw + i);
+                x.storeu(qx + i);
+                y.storeu(qy + i);
+                z.storeu(qz + i);
+            });
+        });
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Math\Matrices\Matrix4x4.hpp"
+#include "Math\Quaternions\Quaternion.hpp"
+#include "Math\Vectors\Vector3.hpp"
+
+namespace math
+{
+    // A hierarchy of transforms, each node holding a local position, rotation and scale relative to
+    // its parent, and the world matrix built from them : world = parent world * T * R * S.
+    //
+    // Every component is stored in its own contiguous array, in the order the nodes were added, and a
+    // parent is always added before its children. Changing a node only flags it as dirty : update()
+    // then recomputes the world matrices of the dirty nodes and of their descendants, and nothing else.
+    // A scene where nothing moved costs nothing to update, and one where a few nodes moved only
+    // costs the subtrees of those nodes.
+    template<std::floating_point F>
+    class transform_hierarchy
+    {
+    public:
+        using index = std::uint32_t;
+
+        // The parent of the roots
+        static constexpr index noParent = ~index(0);
+
+    public:
+        // Constructor that returns an empty hierarchy
+        transform_hierarchy();
+
+        std::size_t size() const;
+        bool empty() const;
+
+        void reserve(std::size_t count);
+        void clear();
+
+        // Adds a node under parent (noParent for a root, or a node already in the hierarchy) and returns
+        // its index, which is greater than the index of its parent. The node is dirty until the next update()
+        index addNode(index parent,
+                      const vec3<F>& position = vec3<F>::zero(),
+                      const quat<F>& rotation = quat<F>::identity(),
+                      const vec3<F>& scale = vec3<F>::one());
+
+        index parent(index node) const;
+
+        const vec3<F>& position(index node) const;
+        const quat<F>& rotation(index node) const;
+        const vec3<F>& scale(index node) const;
+
+        // The setters flag the node as dirty, its world matrix and the ones of its descendants
+        // being recomputed by the next update()
+        void setPosition(index node, const vec3<F>& position);
+        void setRotation(index node, const quat<F>& rotation);
+        void setScale(index node, const vec3<F>& scale);
+        void setLocal(index node, const vec3<F>& position, const quat<F>& rotation, const vec3<F>& scale);
+
+        // Returns true if a node changed since the last update()
+        bool needsUpdate() const;
+
+        // Recomputes the world matrix of every dirty node and of its descendants.
+        // When there is enough work, the independent subtrees are split across the threads of
+        // math::thread_pool. Each matrix is computed the same way whatever thread runs it, so the
+        // results do not depend on the number of threads
+        void update();
+
+        // Returns the world matrix of node, as of the last update()
+        const mat4<F>& world(index node) const;
+        // Returns the world matrices of every node, as of the last update()
+        std::span<const mat4<F>> worlds() const;
+
+    private:
+        // A range [first, last] of nodes, first being dirty and every descendant of a dirty node
+        // of the range being in the range too. Two such ranges can be updated independently
+        struct node_range
+        {
+            index first;
+            index last;
+        };
+
+        void markDirty(index node);
+        void updateNode(index node);
+        // Recomputes the world matrices of the dirty nodes of range and of their descendants
+        void updateRange(node_range range);
+        // Appends to ranges the ranges of the subtrees of heads (sorted), the overlapping ones being merged
+        void mergeRanges(std::span<const index> heads, std::vector<node_range>& ranges) const;
+        // Splits the ranges too large for one thread, then updates all of them across the thread pool
+        void updateParallel(std::size_t nodeCount);
+
+    private:
+        std::vector<index> parents;
+        // The greatest index found in the subtree of each node : the descendants of a node are all
+        // in [node, lastDescendants[node]], along with the nodes of other subtrees added in between
+        std::vector<index> lastDescendants;
+
+        std::vector<vec3<F>> positions;
+        std::vector<quat<F>> rotations;
+        std::vector<vec3<F>> scales;
+
+        std::vector<mat4<F>> worldMatrices;
+
+        // 1 for the nodes changed since the last update, and the list of those nodes
+        std::vector<std::uint8_t> dirtyFlags;
+        std::vector<index> dirtyNodes;
+
+        // Scratch buffers of update(), kept to avoid allocating every frame
+        std::vector<node_range> dirtyRanges;
+        std::vector<node_range> splitRanges;
+        std::vector<node_range> taskRanges;
+        std::vector<std::size_t> taskOffsets;
+        std::vector<index> heads;
+    };
+
+    namespace detail
+    {
+        // The number of nodes below which a part of the hierarchy is not worth splitting across threads
+        inline constexpr std::size_t hierarchyChunkSize = 4096;
+
+        // Returns T * R * S, without building the three matrices
+        template<std::floating_point F>
+        constexpr mat4<F> composeTRS(const vec3<F>& position, const quat<F>& rotation, const vec3<F>& scale);
+        // Returns parent * T * R * S, without building T * R * S first
+        template<std::floating_point F>
+        constexpr mat4<F> composeTRS(const mat4<F>& parent, const vec3<F>& position, const quat<F>& rotation, const vec3<F>& scale);
+    }
+}
+
+#include "Math\Transforms\TransformHierarchy.inl"
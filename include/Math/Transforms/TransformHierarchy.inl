@@ -0,0 +1,374 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "Math\Threading\ThreadPool.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    inline transform_hierarchy<F>::transform_hierarchy()
+    {
+    }
+
+    template<std::floating_point F>
+    inline std::size_t transform_hierarchy<F>::size() const
+    {
+        return parents.size();
+    }
+
+    template<std::floating_point F>
+    inline bool transform_hierarchy<F>::empty() const
+    {
+        return parents.empty();
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::reserve(std::size_t count)
+    {
+        parents.reserve(count);
+        lastDescendants.reserve(count);
+        positions.reserve(count);
+        rotations.reserve(count);
+        scales.reserve(count);
+        worldMatrices.reserve(count);
+        dirtyFlags.reserve(count);
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::clear()
+    {
+        parents.clear();
+        lastDescendants.clear();
+        positions.clear();
+        rotations.clear();
+        scales.clear();
+        worldMatrices.clear();
+        dirtyFlags.clear();
+        dirtyNodes.clear();
+    }
+
+    template<std::floating_point F>
+    inline typename transform_hierarchy<F>::index transform_hierarchy<F>::addNode(index parent, const vec3<F>& position, const quat<F>& rotation, const vec3<F>& scale)
+    {
+        index node = static_cast<index>(size());
+
+        parents.push_back(parent);
+        lastDescendants.push_back(node);
+        positions.push_back(position);
+        rotations.push_back(rotation);
+        scales.push_back(scale);
+        worldMatrices.push_back(mat4<F>::identity());
+        dirtyFlags.push_back(0);
+
+        // The new node has the greatest index, so it is the last descendant of every ancestor
+        for (index p = parent; p != noParent; p = parents[p])
+        {
+            lastDescendants[p] = node;
+        }
+
+        markDirty(node);
+
+        return node;
+    }
+
+    template<std::floating_point F>
+    inline typename transform_hierarchy<F>::index transform_hierarchy<F>::parent(index node) const
+    {
+        return parents[node];
+    }
+
+    template<std::floating_point F>
+    inline const vec3<F>& transform_hierarchy<F>::position(index node) const
+    {
+        return positions[node];
+    }
+
+    template<std::floating_point F>
+    inline const quat<F>& transform_hierarchy<F>::rotation(index node) const
+    {
+        return rotations[node];
+    }
+
+    template<std::floating_point F>
+    inline const vec3<F>& transform_hierarchy<F>::scale(index node) const
+    {
+        return scales[node];
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::setPosition(index node, const vec3<F>& position)
+    {
+        positions[node] = position;
+        markDirty(node);
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::setRotation(index node, const quat<F>& rotation)
+    {
+        rotations[node] = rotation;
+        markDirty(node);
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::setScale(index node, const vec3<F>& scale)
+    {
+        scales[node] = scale;
+        markDirty(node);
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::setLocal(index node, const vec3<F>& position, const quat<F>& rotation, const vec3<F>& scale)
+    {
+        positions[node] = position;
+        rotations[node] = rotation;
+        scales[node] = scale;
+        markDirty(node);
+    }
+
+    template<std::floating_point F>
+    inline bool transform_hierarchy<F>::needsUpdate() const
+    {
+        return !dirtyNodes.empty();
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::update()
+    {
+        if (dirtyNodes.empty()) return;
+
+        std::sort(dirtyNodes.begin(), dirtyNodes.end());
+
+        dirtyRanges.clear();
+        mergeRanges(std::span<const index>(dirtyNodes), dirtyRanges);
+        dirtyNodes.clear();
+
+        std::size_t nodeCount = 0;
+
+        for (const node_range& range : dirtyRanges)
+        {
+            nodeCount += range.last - range.first + 1;
+        }
+
+        if (nodeCount < 2 * detail::hierarchyChunkSize || thread_pool::instance().concurrency() == 1)
+        {
+            for (const node_range& range : dirtyRanges)
+            {
+                updateRange(range);
+            }
+        }
+        else
+        {
+            updateParallel(nodeCount);
+        }
+
+        // The flags tell the children that their parent changed, they are only cleared once every range is done
+        for (const node_range& range : dirtyRanges)
+        {
+            std::fill(dirtyFlags.begin() + range.first, dirtyFlags.begin() + range.last + 1, static_cast<std::uint8_t>(0));
+        }
+    }
+
+    template<std::floating_point F>
+    inline const mat4<F>& transform_hierarchy<F>::world(index node) const
+    {
+        return worldMatrices[node];
+    }
+
+    template<std::floating_point F>
+    inline std::span<const mat4<F>> transform_hierarchy<F>::worlds() const
+    {
+        return std::span<const mat4<F>>(worldMatrices);
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::markDirty(index node)
+    {
+        if (dirtyFlags[node]) return;
+
+        dirtyFlags[node] = 1;
+        dirtyNodes.push_back(node);
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::updateNode(index node)
+    {
+        index p = parents[node];
+
+        worldMatrices[node] = p == noParent
+            ? detail::composeTRS(positions[node], rotations[node], scales[node])
+            : detail::composeTRS(worldMatrices[p], positions[node], rotations[node], scales[node]);
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::updateRange(node_range range)
+    {
+        // The parents come first, so a node is reached once its parent is up to date, and the dirty
+        // flag of the parent tells whether it changed. A parent outside of the range never changed
+        for (index node = range.first; node <= range.last; node++)
+        {
+            index p = parents[node];
+
+            if (!dirtyFlags[node] && (p == noParent || !dirtyFlags[p])) continue;
+
+            dirtyFlags[node] = 1;
+            updateNode(node);
+        }
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::mergeRanges(std::span<const index> sortedHeads, std::vector<node_range>& ranges) const
+    {
+        std::size_t i = 0;
+
+        while (i < sortedHeads.size())
+        {
+            node_range range = { sortedHeads[i], lastDescendants[sortedHeads[i]] };
+
+            for (i++; i < sortedHeads.size() && sortedHeads[i] <= range.last; i++)
+            {
+                range.last = std::max(range.last, lastDescendants[sortedHeads[i]]);
+            }
+
+            ranges.push_back(range);
+        }
+    }
+
+    template<std::floating_point F>
+    inline void transform_hierarchy<F>::updateParallel(std::size_t nodeCount)
+    {
+        std::size_t grain = std::max(nodeCount / (thread_pool::instance().concurrency() * 8), detail::hierarchyChunkSize);
+
+        taskRanges.clear();
+        splitRanges.assign(dirtyRanges.begin(), dirtyRanges.end());
+
+        // A range too large for one thread is split below its first node : once that node is up to date,
+        // the subtrees of the nodes whose parent changed (its children, and the children of the nodes
+        // split before it that were merged in the range) and of the dirty nodes are independent
+        while (!splitRanges.empty())
+        {
+            node_range range = splitRanges.back();
+            splitRanges.pop_back();
+
+            if (range.last - range.first + 1 <= grain)
+            {
+                taskRanges.push_back(range);
+                continue;
+            }
+
+            dirtyFlags[range.first] = 1;
+            updateNode(range.first);
+
+            heads.clear();
+
+            for (index node = range.first + 1; node <= range.last; node++)
+            {
+                index p = parents[node];
+
+                if (dirtyFlags[node] || (p != noParent && dirtyFlags[p])) heads.push_back(node);
+            }
+
+            std::size_t splitCount = splitRanges.size();
+            mergeRanges(std::span<const index>(heads), splitRanges);
+
+            // A single range left (a chain, or children added in between other subtrees) would be
+            // split again one node at a time : it goes to one thread as is
+            if (splitRanges.size() == splitCount + 1)
+            {
+                taskRanges.push_back(splitRanges.back());
+                splitRanges.pop_back();
+            }
+        }
+
+        // The ranges are spread by their number of nodes : the range starting at offset o goes to
+        // the chunk of the parallelFor that holds o
+        taskOffsets.resize(taskRanges.size() + 1);
+        taskOffsets[0] = 0;
+
+        for (std::size_t i = 0; i < taskRanges.size(); i++)
+        {
+            taskOffsets[i + 1] = taskOffsets[i] + (taskRanges[i].last - taskRanges[i].first + 1);
+        }
+
+        const std::size_t* offsets = taskOffsets.data();
+        std::size_t taskCount = taskRanges.size();
+
+        math::parallelFor(taskOffsets[taskCount], detail::hierarchyChunkSize, [this, offsets, taskCount](std::size_t begin, std::size_t end)
+        {
+            std::size_t task = static_cast<std::size_t>(std::lower_bound(offsets, offsets + taskCount, begin) - offsets);
+
+            for (; task < taskCount && offsets[task] < end; task++)
+            {
+                updateRange(taskRanges[task]);
+            }
+        });
+    }
+
+    namespace detail
+    {
+        // Writes the columns of the rotation matrix of quat::toMat4 in m, each one multiplied by its scale factor
+        template<std::floating_point F>
+        constexpr void scaledRotation(const quat<F>& rotation, const vec3<F>& scale, F (&m)[3][3])
+        {
+            F xx = rotation.x * rotation.x;
+            F yy = rotation.y * rotation.y;
+            F zz = rotation.z * rotation.z;
+            F xy = rotation.x * rotation.y;
+            F xz = rotation.x * rotation.z;
+            F yz = rotation.y * rotation.z;
+            F wx = rotation.w * rotation.x;
+            F wy = rotation.w * rotation.y;
+            F wz = rotation.w * rotation.z;
+
+            F f1 = static_cast<F>(1.0);
+            F f2 = static_cast<F>(2.0);
+
+            m[0][0] = (f1 - f2 * (yy + zz)) * scale.x; m[0][1] = f2 * (xy + wz) * scale.x;        m[0][2] = f2 * (xz - wy) * scale.x;
+            m[1][0] = f2 * (xy - wz) * scale.y;        m[1][1] = (f1 - f2 * (xx + zz)) * scale.y; m[1][2] = f2 * (yz + wx) * scale.y;
+            m[2][0] = f2 * (xz + wy) * scale.z;        m[2][1] = f2 * (yz - wx) * scale.z;        m[2][2] = (f1 - f2 * (xx + yy)) * scale.z;
+        }
+
+        template<std::floating_point F>
+        constexpr mat4<F> composeTRS(const vec3<F>& position, const quat<F>& rotation, const vec3<F>& scale)
+        {
+            F m[3][3] = {};
+            scaledRotation(rotation, scale, m);
+
+            F f0 = static_cast<F>(0.0);
+
+            return mat4<F>(m[0][0], m[1][0], m[2][0], position.x,
+                           m[0][1], m[1][1], m[2][1], position.y,
+                           m[0][2], m[1][2], m[2][2], position.z,
+                           f0     , f0     , f0     , static_cast<F>(1.0));
+        }
+
+        template<std::floating_point F>
+        constexpr mat4<F> composeTRS(const mat4<F>& parent, const vec3<F>& position, const quat<F>& rotation, const vec3<F>& scale)
+        {
+            F m[3][3] = {};
+            scaledRotation(rotation, scale, m);
+
+            const F (&p)[4][4] = parent.columns;
+            mat4<F> res;
+
+            // The last row of T * R * S is (0, 0, 0, 1), which leaves 3 products per value instead of 4.
+            // Each column is 4 independent rows, that the compiler turns into one SIMD operation
+            for (int col = 0; col < 3; col++)
+            {
+                for (int row = 0; row < 4; row++)
+                {
+                    res.columns[col][row] = p[0][row] * m[col][0] + p[1][row] * m[col][1] + p[2][row] * m[col][2];
+                }
+            }
+
+            for (int row = 0; row < 4; row++)
+            {
+                res.columns[3][row] = p[0][row] * position.x + p[1][row] * position.y + p[2][row] * position.z + p[3][row];
+            }
+
+            return res;
+        }
+    }
+}
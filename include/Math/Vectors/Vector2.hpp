@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Math\Concepts.hpp"
+#include "Math\Precision.hpp"
 
 namespace math
 {
@@ -11,123 +12,123 @@ namespace math
     struct vec2
     {
     public:
-        union 
-        {
-            struct { F x, y; };
-            F data[2];
-        };
+        F x, y;
 
     public:
         // Constructor that returns a vec2 with x being 0.0, and y being 0.0 
-        vec2();
+        constexpr vec2();
         // Constructor that returns a vec2 with x being vx, and y being vy 
-        vec2(F vx, F vy);
+        constexpr vec2(F vx, F vy);
         // Constructor that returns a vec2 with x being vec.x and y being vec.y
-        vec2(const vec2<F>& vec);
+        constexpr vec2(const vec2<F>& vec) = default;
         // Constructor that returns a vec2 from an angle
         // static vec2<F> fromAngle(const angle<F>& angle);
-        // Constructor that returns a vector2 from an angle in RADIANS
-        static vec2<F> fromAngle(F angleInDeg);
+        // Constructor that returns a vector2 from an angle in DEGREES, P being the precision of sin and cos
+        template<Precision P = precise>
+        static constexpr vec2<F> fromAngle(F angleInDeg);
         
-        template<Number N>
-        static N angleBetween(const vec2<F>& a, const vec2<F>& b);
+        template<Number N, Precision P = precise>
+        static constexpr N angleBetween(const vec2<F>& a, const vec2<F>& b);
 
         // Equivalent of Vec2(0.0f, 0.0f)
-        static vec2 zero();
+        static constexpr vec2 zero();
         // Equivalent of Vec2(1.0f, 1.0f)
-        static vec2 one();
+        static constexpr vec2 one();
         // Equivalent of Vec2(0.0f, 1.0f)
-        static vec2 up();
+        static constexpr vec2 up();
         // Equivalent of Vec2(0.0f, -1.0f)
-        static vec2 down();
+        static constexpr vec2 down();
         // Equivalent of Vec2(-1.0f, 0.0f)
-        static vec2 left();
+        static constexpr vec2 left();
         // Equivalent of Vec2(1.0f, 0.0f)
-        static vec2 right();
+        static constexpr vec2 right();
 
 
         template<std::floating_point f>
-        f X() const;
+        constexpr f X() const;
         template<std::floating_point f>
-        f Y() const;
+        constexpr f Y() const;
         // Returns a new Vec2 made of the X and Y values of the vector
         template<std::floating_point f = F>
-        vec2<f> XY() const;
+        constexpr vec2<f> XY() const;
         // Returns a new Vec2 made of the y and X values of the vector
         template<std::floating_point f = F>
-        vec2<f> YX() const;
+        constexpr vec2<f> YX() const;
         // Returns a new Vec2 made of the X and X values of the vector
         template<std::floating_point f = F>
-        vec2<f> XX() const;
+        constexpr vec2<f> XX() const;
         // Returns a new Vec2 made of the Y and Y values of the vector
         template<std::floating_point f = F>
-        vec2<f> YY() const;
+        constexpr vec2<f> YY() const;
 
-        // Returns the same vector, but with its magnitude being 1
-        vec2& normalized();
+        // Returns the same vector, but with its magnitude being 1, P being the precision of the inverse square root
+        template<Precision P = precise>
+        constexpr vec2& normalized();
 
         // Returns a new vector, that is the same as the original one, but normalized
         template<std::floating_point f = F>
-        vec2<f> getUnitVector() const;
+        constexpr vec2<f> getUnitVector() const;
         
 
         // Returns the magnitude of the vector
         template<Number N>
-        N length() const;
+        constexpr N length() const;
         // Returns the magnitude of the vector, but squared
         template<Number N>
-        N lengthSquared() const;
+        constexpr N lengthSquared() const;
         // Returns the dot product of the vector with the one specified as a parameter
         template<Number N>
-        N dotProduct(const vec2& other) const;
+        constexpr N dotProduct(const vec2& other) const;
         // Returns the distance between the vector, and the one specified as a parameter
         template<Number N>
-        N distance(const vec2& other) const;
+        constexpr N distance(const vec2& other) const;
         // Returns the distance between the vector, and the one specified as a parameter, but squared
         template<Number N>
-        N distanceSquared(const vec2& other) const;
+        constexpr N distanceSquared(const vec2& other) const;
 
 
         template<Number N>
-        static N length(const vec2& vec);
+        static constexpr N length(const vec2& vec);
         template<Number N>   
-        static N lengthSquared(const vec2& vec);
+        static constexpr N lengthSquared(const vec2& vec);
         template<Number N>
-        static N dotProduct(const vec2& vec1, const vec2& vec2);
+        static constexpr N dotProduct(const vec2& vec1, const vec2& vec2);
         template<Number N>
-        static N distance(const vec2& vec1, const vec2& vec2);
+        static constexpr N distance(const vec2& vec1, const vec2& vec2);
         template<Number N>
-        static N distanceSquared(const vec2& vec1, const vec2& vec2);
+        static constexpr N distanceSquared(const vec2& vec1, const vec2& vec2);
 
-        static vec2 lerp(const vec2& start, const vec2& end, F t);
-        static vec2 lerpUnclamped(const vec2& start, const vec2& end, F t);
+        static constexpr vec2 lerp(const vec2& start, const vec2& end, F t);
+        static constexpr vec2 lerpUnclamped(const vec2& start, const vec2& end, F t);
         
 
-        vec2& operator+=(const vec2& other);
-        vec2& operator-=(const vec2& other);
-        vec2& operator*=(F scalar);
-        vec2& operator/=(F scalar);
+        constexpr vec2& operator=(const vec2& other) = default;
+
+        constexpr vec2& operator+=(const vec2& other);
+        constexpr vec2& operator-=(const vec2& other);
+        constexpr vec2& operator*=(F scalar);
+        constexpr vec2& operator/=(F scalar);
 
 
-        const F* valuePtr() const;
+        constexpr const F* valuePtr() const;
         
     };
 
     template<std::floating_point F>
-    inline vec2<F> operator+(const vec2<F>& a, const vec2<F>& b);
+    constexpr vec2<F> operator+(const vec2<F>& a, const vec2<F>& b);
     template<std::floating_point F>
-    inline vec2<F> operator-(const vec2<F>& a, const vec2<F>& b);
+    constexpr vec2<F> operator-(const vec2<F>& a, const vec2<F>& b);
     template<std::floating_point F>
-    inline vec2<F> operator*(const vec2<F>& vec, F scalar);
+    constexpr vec2<F> operator*(const vec2<F>& vec, F scalar);
     template<std::floating_point F>
-    inline vec2<F> operator*(F scalar, const vec2<F>& vec);
+    constexpr vec2<F> operator*(F scalar, const vec2<F>& vec);
     template<std::floating_point F>
-    inline vec2<F> operator/(const vec2<F>& vec, F scalar);
+    constexpr vec2<F> operator/(const vec2<F>& vec, F scalar);
 
     template<std::floating_point F>
-    inline bool operator==(const vec2<F>& a, const vec2<F>& b);
+    constexpr bool operator==(const vec2<F>& a, const vec2<F>& b);
     template<std::floating_point F>
-    inline bool operator!=(const vec2<F>& a, const vec2<F>& b);
+    constexpr bool operator!=(const vec2<F>& a, const vec2<F>& b);
 }
 
 #include "Math\Vectors\Vector2.inl"
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include <concepts>
-#include <cmath>
 
 #include "Math\Concepts.hpp"
 #include "Math\MathInternal.hpp"
@@ -11,24 +10,13 @@ namespace math
     #pragma region Constructors
 
     template<std::floating_point F>
-    inline vec2<F>::vec2()
+    constexpr vec2<F>::vec2() : x(static_cast<F>(0.0)), y(static_cast<F>(0.0))
     {
-        x = static_cast<F>(0.0);
-        y = static_cast<F>(0.0);
     }
 
     template <std::floating_point F>
-    inline vec2<F>::vec2(F vx, F vy)
+    constexpr vec2<F>::vec2(F vx, F vy) : x(vx), y(vy)
     {
-        x = static_cast<F>(vx);
-        y = static_cast<F>(vy);
-    }
-
-    template<std::floating_point F>
-    inline vec2<F>::vec2(const vec2<F>& vec)
-    {
-        x = static_cast<F>(vec.x);
-        y = static_cast<F>(vec.y);
     }
 
     #pragma endregion Constructors
@@ -36,38 +24,39 @@ namespace math
     #pragma region StaticConstructors
 
     template <std::floating_point F>
-    inline vec2 <F> vec2 <F> ::fromAngle(F angleInDeg)
+    template <Precision P>
+    constexpr vec2 <F> vec2 <F> ::fromAngle(F angleInDeg)
     {
-        return vec2(std::cosf(angleInDeg * math::degToRad<F>()), std::sinf(angleInDeg * math::degToRad<F>()));
+        return vec2(P::cos(angleInDeg * math::degToRad<F>()), P::sin(angleInDeg * math::degToRad<F>()));
     }
     
     template <std::floating_point F>
-    inline vec2<F> vec2<F>::zero()
+    constexpr vec2<F> vec2<F>::zero()
     {
         return vec2<F>(static_cast<F>(0.0), static_cast<F>(0.0));
     }
     template <std::floating_point F>
-    inline vec2<F> vec2<F>::one()
+    constexpr vec2<F> vec2<F>::one()
     {
         return vec2<F>(static_cast<F>(1.0), static_cast<F>(1.0));
     }
     template <std::floating_point F>
-    inline vec2<F> vec2<F>::up()
+    constexpr vec2<F> vec2<F>::up()
     {
         return vec2<F>(static_cast<F>(0.0), static_cast<F>(1.0));
     }
     template <std::floating_point F>
-    inline vec2<F> vec2<F>::down()
+    constexpr vec2<F> vec2<F>::down()
     {
         return vec2<F>(static_cast<F>(0.0), static_cast<F>(-1.0));
     }
     template <std::floating_point F>
-    inline vec2<F> vec2<F>::left()
+    constexpr vec2<F> vec2<F>::left()
     {
         return vec2<F>(static_cast<F>(-1.0), static_cast<F>(0.0));
     }
     template <std::floating_point F>
-    inline vec2<F> vec2<F>::right()
+    constexpr vec2<F> vec2<F>::right()
     {
         return vec2<F>(static_cast<F>(1.0), static_cast<F>(0.0));
     }
@@ -78,14 +67,14 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline f vec2<F>::X() const
+    constexpr f vec2<F>::X() const
     {
         return static_cast<f>(x);
     } 
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline f vec2<F>::Y() const
+    constexpr f vec2<F>::Y() const
     {
         return static_cast<f>(y);
     } 
@@ -93,28 +82,28 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec2<F>::XX() const
+    constexpr vec2<f> vec2<F>::XX() const
     {
         return vec2<f>(static_cast<f>(x), static_cast<f>(x));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec2<F>::YY() const
+    constexpr vec2<f> vec2<F>::YY() const
     {
         return vec2<f>(static_cast<f>(y), static_cast<f>(y));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec2<F>::XY() const
+    constexpr vec2<f> vec2<F>::XY() const
     {
         return vec2<f>(static_cast<f>(x), static_cast<f>(y));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec2<F>::YX() const
+    constexpr vec2<f> vec2<F>::YX() const
     {
         return vec2<f>(static_cast<f>(y), static_cast<f>(x));
     }
@@ -124,13 +113,14 @@ namespace math
     #pragma region Normalizing
 
     template<std::floating_point F>
-    inline vec2<F>& vec2<F>::normalized()
+    template<Precision P>
+    constexpr vec2<F>& vec2<F>::normalized()
     {
-        F l = this->length<F>();
+        F l = this->lengthSquared<F>();
         
         if (l > static_cast<F>(0.0)) 
         {
-            F inverseLength = static_cast<F>(1.0) / l;
+            F inverseLength = P::rsqrt(l);
             x *= inverseLength; 
             y *= inverseLength;
         }
@@ -140,15 +130,12 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec2<F>::getUnitVector() const
+    constexpr vec2<f> vec2<F>::getUnitVector() const
     {
         vec2 copy = *this;
-        copy = copy.normalized();
+        copy.normalized();
 
-        copy.x = static_cast<f>(copy.x);
-        copy.y = static_cast<f>(copy.y);
-
-        return copy;
+        return vec2<f>(static_cast<f>(copy.x), static_cast<f>(copy.y));
     }
 
     #pragma endregion Normalizing
@@ -157,35 +144,35 @@ namespace math
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::length() const
+    constexpr N vec2<F>::length() const
     {
-        return static_cast<N>(std::sqrtf( (x * x) + (y * y) ));
+        return static_cast<N>(math::sqrt( (x * x) + (y * y) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::lengthSquared() const
+    constexpr N vec2<F>::lengthSquared() const
     {
         return static_cast<N>( (x * x) + (y * y) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::dotProduct(const vec2& other) const
+    constexpr N vec2<F>::dotProduct(const vec2& other) const
     {
-        return static_cast<N>(std::sqrtf( (other.x - x) * (other.x - x)  +  (other.y - y) * (other.y - y) ));
+        return static_cast<N>( (x * other.x) + (y * other.y) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::distance(const vec2& other) const
+    constexpr N vec2<F>::distance(const vec2& other) const
     {
-        return static_cast<N>(std::sqrtf( (other.x - x) * (other.x - x)  +  (other.y - y) * (other.y - y) ));
+        return static_cast<N>(math::sqrt( (other.x - x) * (other.x - x)  +  (other.y - y) * (other.y - y) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::distanceSquared(const vec2& other) const
+    constexpr N vec2<F>::distanceSquared(const vec2& other) const
     {
         return static_cast<N>((other.x - x) * (other.x - x)  +  (other.y - y) * (other.y - y) );
     }
@@ -195,59 +182,62 @@ namespace math
     #pragma region StaticMethods
 
     template<std::floating_point F>
-    template<Number N>
-    inline N vec2<F>::angleBetween(const vec2<F>& a, const vec2<F>& b)
+    template<Number N, Precision P>
+    constexpr N vec2<F>::angleBetween(const vec2<F>& a, const vec2<F>& b)
     {
-        F dot = math::clamp( static_cast<F>(vec2<F>::dotProduct(a.getUnitVector(), b.getUnitVector()), static_cast<F>(-1.0), static_cast<F>(1.0)) );
+        vec2 unitA = a;
+        vec2 unitB = b;
 
-        return static_cast<F>(std::acos(dot));
+        F dot = math::clamp(vec2<F>::dotProduct<F>(unitA.template normalized<P>(), unitB.template normalized<P>()), static_cast<F>(-1.0), static_cast<F>(1.0));
+
+        return static_cast<N>(P::acos(dot));
     }
 
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::length(const vec2<F>& vec) 
+    constexpr N vec2<F>::length(const vec2<F>& vec) 
     {
-        return static_cast<N>(std::sqrtf( (vec.x * vec.x) + (vec.y * vec.y) ));
+        return static_cast<N>(math::sqrt( (vec.x * vec.x) + (vec.y * vec.y) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::lengthSquared(const vec2& vec) 
+    constexpr N vec2<F>::lengthSquared(const vec2& vec) 
     {
         return static_cast<N>( (vec.x * vec.x) + (vec.y * vec.y) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::dotProduct(const vec2& a, const vec2& b)
+    constexpr N vec2<F>::dotProduct(const vec2& a, const vec2& b)
     {
-        return (a.x * b.x) + (a.y * b.y);
+        return static_cast<N>( (a.x * b.x) + (a.y * b.y) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::distance(const vec2& a, const vec2& b) 
+    constexpr N vec2<F>::distance(const vec2& a, const vec2& b) 
     {
-        return static_cast<N>(std::sqrtf( (b.x - a.x) * (b.x - a.x)  +  (b.y - a.y) * (b.y - a.y) ));
+        return static_cast<N>(math::sqrt( (b.x - a.x) * (b.x - a.x)  +  (b.y - a.y) * (b.y - a.y) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec2<F>::distanceSquared(const vec2& a, const vec2& b) 
+    constexpr N vec2<F>::distanceSquared(const vec2& a, const vec2& b) 
     {
         return static_cast<N>( (b.x - a.x) * (b.x - a.x)  +  (b.y - a.y) * (b.y - a.y) );
     }
 
     template<std::floating_point F>
-    inline vec2<F> vec2<F>::lerp(const vec2<F>& start, const vec2<F>& end, F t)
+    constexpr vec2<F> vec2<F>::lerp(const vec2<F>& start, const vec2<F>& end, F t)
     {
         t = clamp01(t);
         return vec2<F>( start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t );
     }
 
     template<std::floating_point F>
-    inline vec2<F> vec2<F>::lerpUnclamped(const vec2<F>& start, const vec2<F>& end, F t)
+    constexpr vec2<F> vec2<F>::lerpUnclamped(const vec2<F>& start, const vec2<F>& end, F t)
     {
         return vec2<F>(start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t);
     }
@@ -258,7 +248,7 @@ namespace math
     #pragma region ReferenceOperators
 
     template<std::floating_point F>
-    vec2<F>& vec2<F>::operator+=(const vec2<F>& other)
+    constexpr vec2<F>& vec2<F>::operator+=(const vec2<F>& other)
     {
         this->x += other.x;
         this->y += other.y;
@@ -267,7 +257,7 @@ namespace math
     }
 
     template<std::floating_point F>
-    vec2<F>& vec2<F>::operator-=(const vec2<F>& other)
+    constexpr vec2<F>& vec2<F>::operator-=(const vec2<F>& other)
     {
         this->x -= other.x;
         this->y -= other.y;
@@ -276,7 +266,7 @@ namespace math
     }
 
     template<std::floating_point F>
-    vec2<F>& vec2<F>::operator*=(F scalar)
+    constexpr vec2<F>& vec2<F>::operator*=(F scalar)
     {
         this->x *= scalar;
         this->y *= scalar;
@@ -286,7 +276,7 @@ namespace math
 
 
     template<std::floating_point F>
-    vec2<F>& vec2<F>::operator/=(F scalar)
+    constexpr vec2<F>& vec2<F>::operator/=(F scalar)
     {
         if (scalar != static_cast<F>(0.0))
         {
@@ -300,9 +290,9 @@ namespace math
     }
 
     template<std::floating_point F>
-    const F* vec2<F>::valuePtr() const
+    constexpr const F* vec2<F>::valuePtr() const
     {
-        return &data[0];
+        return &x;
     }
 
     #pragma endregion ReferenceOperators
@@ -310,48 +300,48 @@ namespace math
     #pragma region ArithmeticOperators
 
     template<std::floating_point F>
-    inline vec2<F> operator+(const vec2<F>& a, const vec2<F>& b)
+    constexpr vec2<F> operator+(const vec2<F>& a, const vec2<F>& b)
     {
         return vec2(a.x + b.x, a.y + b.y);
     }
 
     template<std::floating_point F>
-    inline vec2<F> operator-(const vec2<F>& a, const vec2<F>& b)
+    constexpr vec2<F> operator-(const vec2<F>& a, const vec2<F>& b)
     {
         return vec2(a.x - b.x, a.y - b.y);
     }
 
     template<std::floating_point F>
-    inline vec2<F> operator*(const vec2<F>& vec, F scalar)
+    constexpr vec2<F> operator*(const vec2<F>& vec, F scalar)
     {
         return vec2(vec.x * scalar, vec.y * scalar);
     }
     template<std::floating_point F>
-    inline vec2<F> operator*(F scalar, const vec2<F>& vec)
+    constexpr vec2<F> operator*(F scalar, const vec2<F>& vec)
     {
         return vec2(vec.x * scalar, vec.y * scalar);
     }
 
     template<std::floating_point F>
-    inline vec2<F> operator/(const vec2<F>& vec, F scalar)
+    constexpr vec2<F> operator/(const vec2<F>& vec, F scalar)
     {
         if (scalar == static_cast<F>(0.0)) return vec;
 
         scalar = static_cast<F>(1.0) / scalar;
 
-        return vec2(vec.x / scalar, vec.y / scalar);
+        return vec2(vec.x * scalar, vec.y * scalar);
     }
 
 
     template<std::floating_point F>
-    inline bool operator==(const vec2<F>& a, const vec2<F>& b)
+    constexpr bool operator==(const vec2<F>& a, const vec2<F>& b)
     {
-        return static_cast<F>( std::abs(b.x - a.x) ) < math::epsilon<F>() &&
-               static_cast<F>( std::abs(b.y - a.y) ) < math::epsilon<F>();
+        return math::abs(b.x - a.x) < math::epsilon<F>() &&
+               math::abs(b.y - a.y) < math::epsilon<F>();
     }
 
     template<std::floating_point F>
-    inline bool operator!=(const vec2<F>& a, const vec2<F>& b)
+    constexpr bool operator!=(const vec2<F>& a, const vec2<F>& b)
     {
         return !(a == b);
     }
@@ -1,6 +1,6 @@
 #include <concepts>
-#include <cmath>
-#include "Vector3.hpp"
+
+#include "Math\MathInternal.hpp"
 
 namespace math
 {
@@ -8,52 +8,29 @@ namespace math
     #pragma region Constructors
 
     template<std::floating_point F>
-    inline vec3<F>::vec3() 
+    constexpr vec3<F>::vec3() : x(static_cast<F>(0.0)), y(static_cast<F>(0.0)), z(static_cast<F>(0.0))
     {
-        x = static_cast<F>(0.0);
-        y = static_cast<F>(0.0);
-        z = static_cast<F>(0.0);
     }
 
     template<std::floating_point F>
-    inline vec3<F>::vec3(F vx, F vy)
+    constexpr vec3<F>::vec3(F vx, F vy) : x(vx), y(vy), z(static_cast<F>(0.0))
     {
-        x = vx;
-        y = vy;
-        z = static_cast<F>(0.0);
     }
 
     template<std::floating_point F>
-    inline vec3<F>::vec3(F vx, F vy, F vz)
+    constexpr vec3<F>::vec3(F vx, F vy, F vz) : x(vx), y(vy), z(vz)
     {
-        x = vx;
-        y = vy;
-        z = vz;
-    }
-
-    template<std::floating_point F>
-    inline vec3<F>::vec3(const vec3<F>& vec)
-    {
-        x = vec.x;
-        y = vec.y;
-        z = vec.z;
     }
 
 
     template<std::floating_point F>
-    inline vec3<F>::vec3(const vec2<F>& vec)
+    constexpr vec3<F>::vec3(const vec2<F>& vec) : x(vec.x), y(vec.y), z(static_cast<F>(0.0))
     {
-        x = vec.x;
-        y = vec.y;
-        z = static_cast<F>(0.0);
     }
 
     template<std::floating_point F>
-    inline vec3<F>::vec3(const vec2<F>& vec, F vz)
+    constexpr vec3<F>::vec3(const vec2<F>& vec, F vz) : x(vec.x), y(vec.y), z(vz)
     {
-        x = vec.x;
-        y = vec.y;
-        z = vz;
     }
 
     
@@ -63,49 +40,49 @@ namespace math
     #pragma region StaticConstructors
 
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::zero()
+    constexpr vec3<F> vec3<F>::zero()
     {
         F f = static_cast<F>(0.0);
         return vec3(f, f, f);
     }
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::one()
+    constexpr vec3<F> vec3<F>::one()
     {
         F f = static_cast<F>(1.0);
         return vec3(f, f, f);
     }
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::up()
+    constexpr vec3<F> vec3<F>::up()
     {
         F f = static_cast<F>(0.0);
         return vec3(f, static_cast<F>(1.0), f);
     }
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::down()
+    constexpr vec3<F> vec3<F>::down()
     {
         F f = static_cast<F>(0.0);
         return vec3(f, static_cast<F>(-1.0), f);
     }
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::left()
+    constexpr vec3<F> vec3<F>::left()
     {
         F f = static_cast<F>(0.0);
         return vec3(static_cast<F>(-1.0), f, f);
     }
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::right()
+    constexpr vec3<F> vec3<F>::right()
     {
         F f = static_cast<F>(0.0);
         return vec3(static_cast<F>(1.0), f, f);
     }
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::forward()
+    constexpr vec3<F> vec3<F>::forward()
     {
         F f = static_cast<F>(0.0);
         return vec3(f, f, static_cast<F>(1.0));
     }
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::backward()
+    constexpr vec3<F> vec3<F>::backward()
     {
         F f = static_cast<F>(0.0);
         return vec3(f, f, static_cast<F>(-1.0));
@@ -115,21 +92,52 @@ namespace math
 
     #pragma region Casting
 
+    template<std::floating_point F>
+    constexpr F& vec3<F>::r()
+    {
+        return x;
+    }
+    template<std::floating_point F>
+    constexpr F& vec3<F>::g()
+    {
+        return y;
+    }
+    template<std::floating_point F>
+    constexpr F& vec3<F>::b()
+    {
+        return z;
+    }
+    template<std::floating_point F>
+    constexpr F vec3<F>::r() const
+    {
+        return x;
+    }
+    template<std::floating_point F>
+    constexpr F vec3<F>::g() const
+    {
+        return y;
+    }
+    template<std::floating_point F>
+    constexpr F vec3<F>::b() const
+    {
+        return z;
+    }
+
     template<std::floating_point F>
     template<std::floating_point f>
-    inline f vec3<F>::X() const
+    constexpr f vec3<F>::X() const
     {
         return static_cast<f>(x);
     }
     template<std::floating_point F>
     template<std::floating_point f>
-    inline f vec3<F>::Y() const
+    constexpr f vec3<F>::Y() const
     {
         return static_cast<f>(y);
     }
     template<std::floating_point F>
     template<std::floating_point f>
-    inline f vec3<F>::Z() const
+    constexpr f vec3<F>::Z() const
     {
         return static_cast<f>(z);
     }
@@ -137,7 +145,7 @@ namespace math
 
     template <std::floating_point F>
     template <std::floating_point f>
-    inline vec2<f> vec3<F>::XX() const
+    constexpr vec2<f> vec3<F>::XX() const
     {
         f f1 = static_cast<f>(x);
 
@@ -146,7 +154,7 @@ namespace math
 
     template <std::floating_point F>
     template <std::floating_point f>
-    inline vec2<f> vec3<F>::YY() const
+    constexpr vec2<f> vec3<F>::YY() const
     {
         f f1 = static_cast<f>(y);
 
@@ -155,7 +163,7 @@ namespace math
 
     template <std::floating_point F>
     template <std::floating_point f>
-    inline vec2<f> vec3<F>::ZZ() const
+    constexpr vec2<f> vec3<F>::ZZ() const
     {
         f f1 = static_cast<f>(z);
 
@@ -164,42 +172,42 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec3<F>::XY() const
+    constexpr vec2<f> vec3<F>::XY() const
     {
         return vec2<f>(x, y);
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec3<F>::XZ() const
+    constexpr vec2<f> vec3<F>::XZ() const
     {
         return vec2<f>(x, z);
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec3<F>::YX() const
+    constexpr vec2<f> vec3<F>::YX() const
     {
         return vec2<f>(y, x);
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec3<F>::YZ() const
+    constexpr vec2<f> vec3<F>::YZ() const
     {
         return vec2<f>(y, z);
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec3<F>::ZX() const
+    constexpr vec2<f> vec3<F>::ZX() const
     {
         return vec2<f>(z, x);
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec2<f> vec3<F>::ZY() const
+    constexpr vec2<f> vec3<F>::ZY() const
     {
         return vec2<f>(z, y);
     }
@@ -207,35 +215,35 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<f> vec3<F>::XYZ() const
+    constexpr vec3<f> vec3<F>::XYZ() const
     {
         return vec3<f>(static_cast<f>(x), static_cast<f>(y), static_cast<f>(z));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<f> vec3<F>::ZYX() const
+    constexpr vec3<f> vec3<F>::ZYX() const
     {
         return vec3<f>(static_cast<f>(z), static_cast<f>(y), static_cast<f>(x));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<f> vec3<F>::XXX() const
+    constexpr vec3<f> vec3<F>::XXX() const
     {
         return vec3<f>(static_cast<f>(x), static_cast<f>(x), static_cast<f>(x));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<f> vec3<F>::YYY() const
+    constexpr vec3<f> vec3<F>::YYY() const
     {
         return vec3<f>(static_cast<f>(y), static_cast<f>(y), static_cast<f>(y));
     }
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<f> vec3<F>::ZZZ() const
+    constexpr vec3<f> vec3<F>::ZZZ() const
     {
         return vec3<f>(static_cast<f>(z), static_cast<f>(z), static_cast<f>(z));
     }
@@ -247,13 +255,14 @@ namespace math
     #pragma region Normalizing
 
     template<std::floating_point F>
-    inline vec3<F>& vec3<F>::normalized()
+    template<Precision P>
+    constexpr vec3<F>& vec3<F>::normalized()
     {
-        F l = this->length<F>();
+        F l = this->lengthSquared<F>();
 
         if (l > static_cast<F>(0.0))
         {
-            F inverseLength = static_cast<F>(1.0 / l);
+            F inverseLength = P::rsqrt(l);
 
             x *= inverseLength;
             y *= inverseLength;
@@ -265,10 +274,10 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<f> vec3<F>::getUnitVector() const
+    constexpr vec3<f> vec3<F>::getUnitVector() const
     {
         vec3 copy = *this;
-        copy = copy.normalized();
+        copy.normalized();
 
         vec3<f> vec = vec3<f>(static_cast<f>(copy.x), 
                               static_cast<f>(copy.y),
@@ -282,54 +291,52 @@ namespace math
     #pragma region MemberMethods
 
     template<std::floating_point F>
-    const F* vec3<F>::valuePtr() const
+    constexpr const F* vec3<F>::valuePtr() const
     {
-        return &data[0];
+        return &x;
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::length() const
+    constexpr N vec3<F>::length() const
     {
-        return static_cast<N>(std::sqrtf( (x * x) + (y * y) + (z * z) ));
+        return static_cast<N>(math::sqrt( (x * x) + (y * y) + (z * z) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::lengthSquared() const
+    constexpr N vec3<F>::lengthSquared() const
     {
         return static_cast<N>( (x * x) + (y * y) + (z * z) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::distance(const vec3<F>& other) const
+    constexpr N vec3<F>::distance(const vec3<F>& other) const
     {
-        return static_cast<N>(std::sqrtf( (other.x - x) * (other.x - x) + (other.y - y) * (other.y - y) +(other.z - z) * (other.z - z) ));
+        return static_cast<N>(math::sqrt( (other.x - x) * (other.x - x) + (other.y - y) * (other.y - y) +(other.z - z) * (other.z - z) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::distanceSquared(const vec3<F>& other) const
+    constexpr N vec3<F>::distanceSquared(const vec3<F>& other) const
     {
-        return static_cast<N>(std::sqrtf( (other.x - x) * (other.x - x) + (other.y - y) * (other.y - y) +(other.z - z) * (other.z - z) ));
+        return static_cast<N>( (other.x - x) * (other.x - x) + (other.y - y) * (other.y - y) + (other.z - z) * (other.z - z) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::dotProduct(const vec3<F>& other) const
+    constexpr N vec3<F>::dotProduct(const vec3<F>& other) const
     {
-        return static_cast<N>( (x * other.x) + (y * other.y) + (z * other.y) );
+        return static_cast<N>( (x * other.x) + (y * other.y) + (z * other.z) );
     }
 
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::crossProduct(const vec3<F>& other) const
+    constexpr vec3<F> vec3<F>::crossProduct(const vec3<F>& other) const
     {
-        F x = y * other.z - z * other.y;
-        F y = -(x * other.z - z * other.x);
-        F z = x * other.y - y * other.x;
-
-        return vec3(x, y, z);
+        return vec3(y * other.z - z * other.y,
+                    z * other.x - x * other.z,
+                    x * other.y - y * other.x);
     }
 
     #pragma endregion MemberMethods
@@ -338,41 +345,41 @@ namespace math
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::length(const vec3<F>& vec) 
+    constexpr N vec3<F>::length(const vec3<F>& vec) 
     {
-        return static_cast<N>(std::sqrtf( (vec.x * vec.x) + (vec.y * vec.y) + (vec.z * vec.z) ));
+        return static_cast<N>(math::sqrt( (vec.x * vec.x) + (vec.y * vec.y) + (vec.z * vec.z) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::lengthSquared(const vec3<F>& vec) 
+    constexpr N vec3<F>::lengthSquared(const vec3<F>& vec) 
     {
         return static_cast<N>( (vec.x * vec.x) + (vec.y * vec.y) + (vec.z * vec.z) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::distance(const vec3<F>& a, const vec3<F>& b) 
+    constexpr N vec3<F>::distance(const vec3<F>& a, const vec3<F>& b) 
     {
-        return static_cast<N>(std::sqrtf( (b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y) +(b.z - a.z) * (b.z - a.z) ));
+        return static_cast<N>(math::sqrt( (b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y) +(b.z - a.z) * (b.z - a.z) ));
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::distanceSquared(const vec3<F>& a, const vec3<F>& b) 
+    constexpr N vec3<F>::distanceSquared(const vec3<F>& a, const vec3<F>& b) 
     {
-        return static_cast<N>(std::sqrtf( (b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y) +(b.z - a.z) * (b.z - a.z) ));
+        return static_cast<N>( (b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y) + (b.z - a.z) * (b.z - a.z) );
     }
 
     template<std::floating_point F>
     template<Number N>
-    inline N vec3<F>::dotProduct(const vec3<F>& a, const vec3<F>& b) 
+    constexpr N vec3<F>::dotProduct(const vec3<F>& a, const vec3<F>& b) 
     {
-        return static_cast<N>( (a.x * b.x) + (a.y * b.y) + (a.z * b.y) );
+        return static_cast<N>( (a.x * b.x) + (a.y * b.y) + (a.z * b.z) );
     }
 
     template<std::floating_point F>
-    inline vec3<F> vec3<F>::crossProduct(const vec3<F>& a, const vec3<F>& b) 
+    constexpr vec3<F> vec3<F>::crossProduct(const vec3<F>& a, const vec3<F>& b) 
     {
         F x = a.y * b.z - a.z * b.y;
         F y = -(a.x * b.z - a.z * b.x);
@@ -384,16 +391,16 @@ namespace math
 
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<F> vec3<F>::lerp(const vec3<F>& start, const vec3<F>& end, f t)
+    constexpr vec3<F> vec3<F>::lerp(const vec3<F>& start, const vec3<F>& end, f t)
     {
         t = clamp01(t);
-        return vec3(start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t, start.y + (end.y - start.y) * t);
+        return vec3(start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t, start.z + (end.z - start.z) * t);
     }
     template<std::floating_point F>
     template<std::floating_point f>
-    inline vec3<F> vec3<F>::lerpUnclamped(const vec3<F>& start, const vec3<F>& end, f t)
+    constexpr vec3<F> vec3<F>::lerpUnclamped(const vec3<F>& start, const vec3<F>& end, f t)
     {
-        return vec3(start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t, start.y + (end.y - start.y) * t);
+        return vec3(start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t, start.z + (end.z - start.z) * t);
     }
 
     #pragma endregion StaticMethods
@@ -401,34 +408,37 @@ namespace math
     #pragma region ReferenceOperators
 
     template<std::floating_point F>
-    vec3<F>& vec3<F>::operator+=(const vec3<F>& other)
+    constexpr vec3<F>& vec3<F>::operator+=(const vec3<F>& other)
     {
         this->x += other.x;
         this->y += other.y;
+        this->z += other.z;
 
         return *this;
     }
 
     template<std::floating_point F>
-    vec3<F>& vec3<F>::operator-=(const vec3<F>& other)
+    constexpr vec3<F>& vec3<F>::operator-=(const vec3<F>& other)
     {
         this->x -= other.x;
         this->y -= other.y;
+        this->z -= other.z;
 
         return *this;
     }
 
     template<std::floating_point F>
-    vec3<F>& vec3<F>::operator*=(F scalar)
+    constexpr vec3<F>& vec3<F>::operator*=(F scalar)
     {
         this->x *= scalar;
         this->y *= scalar;
+        this->z *= scalar;
 
         return *this;
     }
 
     template<std::floating_point F>
-    vec3<F>& vec3<F>::operator/=(F scalar)
+    constexpr vec3<F>& vec3<F>::operator/=(F scalar)
     {
         if (scalar != static_cast<F>(0.0))
         {
@@ -447,27 +457,27 @@ namespace math
     #pragma region ArithmeticOperators
 
     template<std::floating_point F>
-    inline vec3<F> operator+(const vec3<F>& a, const vec3<F>& b)
+    constexpr vec3<F> operator+(const vec3<F>& a, const vec3<F>& b)
     {
         return vec3(a.x + b.x, a.y + b.y, a.z + b.z);
     }
     template<std::floating_point F>
-    inline vec3<F> operator-(const vec3<F>& a, const vec3<F>& b)
+    constexpr vec3<F> operator-(const vec3<F>& a, const vec3<F>& b)
     {
         return vec3(a.x - b.x, a.y - b.y, a.z - b.z);
     }
     template<std::floating_point F>
-    inline vec3<F> operator*(const vec3<F>& vec, F scalar)
+    constexpr vec3<F> operator*(const vec3<F>& vec, F scalar)
     {
         return vec3(vec.x * scalar, vec.y * scalar, vec.z * scalar);
     }
     template<std::floating_point F>
-    inline vec3<F> operator*(F scalar, const vec3<F>& vec)
+    constexpr vec3<F> operator*(F scalar, const vec3<F>& vec)
     {
         return vec3(vec.x * scalar, vec.y * scalar, vec.z * scalar);
     }
     template<std::floating_point F>
-    inline vec3<F> operator/(const vec3<F>& vec, F scalar)
+    constexpr vec3<F> operator/(const vec3<F>& vec, F scalar)
     {
         if (scalar == static_cast<F>(0.0)) return vec;
 
@@ -477,15 +487,15 @@ namespace math
     }
 
     template<std::floating_point F>
-    inline bool operator==(const vec3<F>& a, const vec3<F>& b)
+    constexpr bool operator==(const vec3<F>& a, const vec3<F>& b)
     {
-        return static_cast<F>(std::abs(a.x - b.x)) < math::epsilon<F>() && 
-               static_cast<F>(std::abs(a.y - b.y)) < math::epsilon<F>() &&
-               static_cast<F>(std::abs(a.z - b.z)) < math::epsilon<F>();
+        return math::abs(a.x - b.x) < math::epsilon<F>() && 
+               math::abs(a.y - b.y) < math::epsilon<F>() &&
+               math::abs(a.z - b.z) < math::epsilon<F>();
     }
 
     template<std::floating_point F>
-    inline bool operator!=(const vec3<F>& a, const vec3<F>& b)
+    constexpr bool operator!=(const vec3<F>& a, const vec3<F>& b)
     {
         return !(a == b);
     }
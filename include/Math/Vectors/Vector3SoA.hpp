@@ -0,0 +1,103 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Math\Concepts.hpp"
+#include "Math\Memory\AlignedAllocator.hpp"
+#include "Math\Simd\Pack.hpp"
+#include "Math\Vectors\Vector3SoAExpr.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    struct vec3;
+
+    // A struct used to store many vec3 as a structure of arrays : all the x are contiguous, then
+    // all the y, then all the z, each array being aligned on a cache line.
+    // Unlike vec3, it is meant to be processed in bulk, by the static kernels below, that fill
+    // every lane of the SIMD registers.
+    template<std::floating_point F>
+    struct vec3_soa
+    {
+    public:
+        using array = std::vector<F, aligned_allocator<F>>;
+
+        array x;
+        array y;
+        array z;
+
+    public:
+        // Constructor that returns an empty vec3_soa
+        vec3_soa();
+        // Constructor that returns a vec3_soa of count vectors, all being (0.0, 0.0, 0.0)
+        explicit vec3_soa(std::size_t count);
+        // Constructor that returns a vec3_soa holding a copy of every vector of vecs
+        explicit vec3_soa(std::span<const vec3<F>> vecs);
+        // Constructor that evaluates an expression built from math::lazy, in a single pass
+        template<expr::Vec3Expression E>
+            requires std::same_as<F, expr::value_t<E>>
+        vec3_soa(const E& expression);
+
+        // Evaluates an expression built from math::lazy in a single pass, the expression can read *this
+        template<expr::Vec3Expression E>
+            requires std::same_as<F, expr::value_t<E>>
+        vec3_soa& operator=(const E& expression);
+
+        std::size_t size() const;
+        bool empty() const;
+
+        void resize(std::size_t count);
+        void reserve(std::size_t count);
+        void clear();
+
+        void pushBack(const vec3<F>& vec);
+
+        // Returns a copy of the vector at index i
+        vec3<F> get(std::size_t i) const;
+        // Replaces the vector at index i
+        void set(std::size_t i, const vec3<F>& vec);
+
+        // Normalizes every vector, the vectors of length 0.0 being left untouched.
+        // With math::fast, float goes through the SIMD inverse square root estimate
+        template<Precision P = precise>
+        vec3_soa& normalized();
+
+
+        // Writes the magnitude of every vector in out, that must hold at least vecs.size() values
+        static void length(const vec3_soa& vecs, std::span<F> out);
+        // Writes the squared magnitude of every vector in out, that must hold at least vecs.size() values
+        static void lengthSquared(const vec3_soa& vecs, std::span<F> out);
+
+        // Writes the dot product of a[i] and b[i] in out[i], a and b having the same size
+        static void dotProduct(const vec3_soa& a, const vec3_soa& b, std::span<F> out);
+        // Writes the cross product of a[i] and b[i] in out[i], out being resized if needed (it can be a or b)
+        static void crossProduct(const vec3_soa& a, const vec3_soa& b, vec3_soa& out);
+
+        // Writes the distance between a[i] and b[i] in out[i], a and b having the same size
+        static void distance(const vec3_soa& a, const vec3_soa& b, std::span<F> out);
+        // Writes the squared distance between a[i] and b[i] in out[i], a and b having the same size
+        static void distanceSquared(const vec3_soa& a, const vec3_soa& b, std::span<F> out);
+
+        // Writes the linear interpolation of start[i] and end[i] in out[i], t being clamped between 0.0 and 1.0
+        static void lerp(const vec3_soa& start, const vec3_soa& end, F t, vec3_soa& out);
+        // Same as lerp, but t is not clamped
+        static void lerpUnclamped(const vec3_soa& start, const vec3_soa& end, F t, vec3_soa& out);
+    };
+
+    namespace detail
+    {
+        // The number of vectors that forEachSoaBlock moves to the stack at once
+        inline constexpr std::size_t soaBlockSize = 256;
+
+        // Lets a SoA kernel run over an array of vec3 : the vectors [begin, end) of in are copied, by
+        // blocks of soaBlockSize, to three arrays x, y and z on the stack, kernel(first, count, x, y, z)
+        // is called on each block, then the block is copied back to out (that can be in)
+        template<std::floating_point F, typename Kernel>
+        inline void forEachSoaBlock(const vec3<F>* in, vec3<F>* out, std::size_t begin, std::size_t end, Kernel&& kernel);
+    }
+}
+
+#include "Math\Vectors\Vector3SoA.inl"
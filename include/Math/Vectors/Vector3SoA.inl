@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include "Math\MathInternal.hpp"
+#include "Math\Simd\Pack.hpp"
+
+namespace math
+{
+
+    #pragma region Constructors
+
+    template<std::floating_point F>
+    inline vec3_soa<F>::vec3_soa()
+    {
+    }
+
+    template<std::floating_point F>
+    inline vec3_soa<F>::vec3_soa(std::size_t count)
+    {
+        resize(count);
+    }
+
+    template<std::floating_point F>
+    inline vec3_soa<F>::vec3_soa(std::span<const vec3<F>> vecs)
+    {
+        resize(vecs.size());
+
+        for (std::size_t i = 0; i < vecs.size(); i++)
+        {
+            x[i] = vecs[i].x;
+            y[i] = vecs[i].y;
+            z[i] = vecs[i].z;
+        }
+    }
+
+    template<std::floating_point F>
+    template<expr::Vec3Expression E>
+        requires std::same_as<F, expr::value_t<E>>
+    inline vec3_soa<F>::vec3_soa(const E& expression)
+    {
+        expr::evaluate(expression, *this);
+    }
+
+    template<std::floating_point F>
+    template<expr::Vec3Expression E>
+        requires std::same_as<F, expr::value_t<E>>
+    inline vec3_soa<F>& vec3_soa<F>::operator=(const E& expression)
+    {
+        expr::evaluate(expression, *this);
+
+        return *this;
+    }
+
+    #pragma endregion Constructors
+
+    #pragma region Container
+
+    template<std::floating_point F>
+    inline std::size_t vec3_soa<F>::size() const
+    {
+        return x.size();
+    }
+
+    template<std::floating_point F>
+    inline bool vec3_soa<F>::empty() const
+    {
+        return x.empty();
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::resize(std::size_t count)
+    {
+        x.resize(count, static_cast<F>(0.0));
+        y.resize(count, static_cast<F>(0.0));
+        z.resize(count, static_cast<F>(0.0));
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::reserve(std::size_t count)
+    {
+        x.reserve(count);
+        y.reserve(count);
+        z.reserve(count);
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::clear()
+    {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::pushBack(const vec3<F>& vec)
+    {
+        x.push_back(vec.x);
+        y.push_back(vec.y);
+        z.push_back(vec.z);
+    }
+
+    template<std::floating_point F>
+    inline vec3<F> vec3_soa<F>::get(std::size_t i) const
+    {
+        return vec3<F>(x[i], y[i], z[i]);
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::set(std::size_t i, const vec3<F>& vec)
+    {
+        x[i] = vec.x;
+        y[i] = vec.y;
+        z[i] = vec.z;
+    }
+
+    #pragma endregion Container
+
+    #pragma region Normalizing
+
+    template<std::floating_point F>
+    template<Precision Policy>
+    inline vec3_soa<F>& vec3_soa<F>::normalized()
+    {
+        F* px = x.data();
+        F* py = y.data();
+        F* pz = z.data();
+
+        simd::forEachPack<F>(0, size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P vx = P::loadu(px + i);
+            P vy = P::loadu(py + i);
+            P vz = P::loadu(pz + i);
+
+            P l = simd::madd(vx, vx, simd::madd(vy, vy, vz * vz));
+
+            // Lanes of length 0.0 are multiplied by 1.0 instead of 1.0 / 0.0
+            P one = P::broadcast(static_cast<F>(1.0));
+            P safeLength = simd::select(simd::cmpGt(l, P::zero()), l, one);
+
+            P inverseLength;
+            if constexpr (std::same_as<Policy, fast>) inverseLength = simd::rsqrtFast(safeLength);
+            else inverseLength = one / simd::sqrt(safeLength);
+
+            (vx * inverseLength).storeu(px + i);
+            (vy * inverseLength).storeu(py + i);
+            (vz * inverseLength).storeu(pz + i);
+        });
+
+        return *this;
+    }
+
+    #pragma endregion Normalizing
+
+    #pragma region StaticMethods
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::length(const vec3_soa<F>& vecs, std::span<F> out)
+    {
+        const F* px = vecs.x.data();
+        const F* py = vecs.y.data();
+        const F* pz = vecs.z.data();
+        F* po = out.data();
+
+        simd::forEachPack<F>(0, vecs.size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P vx = P::loadu(px + i);
+            P vy = P::loadu(py + i);
+            P vz = P::loadu(pz + i);
+
+            simd::sqrt(simd::madd(vx, vx, simd::madd(vy, vy, vz * vz))).storeu(po + i);
+        });
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::lengthSquared(const vec3_soa<F>& vecs, std::span<F> out)
+    {
+        const F* px = vecs.x.data();
+        const F* py = vecs.y.data();
+        const F* pz = vecs.z.data();
+        F* po = out.data();
+
+        simd::forEachPack<F>(0, vecs.size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P vx = P::loadu(px + i);
+            P vy = P::loadu(py + i);
+            P vz = P::loadu(pz + i);
+
+            simd::madd(vx, vx, simd::madd(vy, vy, vz * vz)).storeu(po + i);
+        });
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::dotProduct(const vec3_soa<F>& a, const vec3_soa<F>& b, std::span<F> out)
+    {
+        const F* ax = a.x.data(); const F* ay = a.y.data(); const F* az = a.z.data();
+        const F* bx = b.x.data(); const F* by = b.y.data(); const F* bz = b.z.data();
+        F* po = out.data();
+
+        simd::forEachPack<F>(0, a.size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P dot = P::loadu(ax + i) * P::loadu(bx + i);
+            dot = simd::madd(P::loadu(ay + i), P::loadu(by + i), dot);
+            dot = simd::madd(P::loadu(az + i), P::loadu(bz + i), dot);
+
+            dot.storeu(po + i);
+        });
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::crossProduct(const vec3_soa<F>& a, const vec3_soa<F>& b, vec3_soa<F>& out)
+    {
+        out.resize(a.size());
+
+        const F* ax = a.x.data(); const F* ay = a.y.data(); const F* az = a.z.data();
+        const F* bx = b.x.data(); const F* by = b.y.data(); const F* bz = b.z.data();
+        F* ox = out.x.data(); F* oy = out.y.data(); F* oz = out.z.data();
+
+        simd::forEachPack<F>(0, a.size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            // Everything is loaded before storing, so that out can be a or b
+            P vax = P::loadu(ax + i); P vay = P::loadu(ay + i); P vaz = P::loadu(az + i);
+            P vbx = P::loadu(bx + i); P vby = P::loadu(by + i); P vbz = P::loadu(bz + i);
+
+            (vay * vbz - vaz * vby).storeu(ox + i);
+            (vaz * vbx - vax * vbz).storeu(oy + i);
+            (vax * vby - vay * vbx).storeu(oz + i);
+        });
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::distance(const vec3_soa<F>& a, const vec3_soa<F>& b, std::span<F> out)
+    {
+        const F* ax = a.x.data(); const F* ay = a.y.data(); const F* az = a.z.data();
+        const F* bx = b.x.data(); const F* by = b.y.data(); const F* bz = b.z.data();
+        F* po = out.data();
+
+        simd::forEachPack<F>(0, a.size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P dx = P::loadu(bx + i) - P::loadu(ax + i);
+            P dy = P::loadu(by + i) - P::loadu(ay + i);
+            P dz = P::loadu(bz + i) - P::loadu(az + i);
+
+            simd::sqrt(simd::madd(dx, dx, simd::madd(dy, dy, dz * dz))).storeu(po + i);
+        });
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::distanceSquared(const vec3_soa<F>& a, const vec3_soa<F>& b, std::span<F> out)
+    {
+        const F* ax = a.x.data(); const F* ay = a.y.data(); const F* az = a.z.data();
+        const F* bx = b.x.data(); const F* by = b.y.data(); const F* bz = b.z.data();
+        F* po = out.data();
+
+        simd::forEachPack<F>(0, a.size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P dx = P::loadu(bx + i) - P::loadu(ax + i);
+            P dy = P::loadu(by + i) - P::loadu(ay + i);
+            P dz = P::loadu(bz + i) - P::loadu(az + i);
+
+            simd::madd(dx, dx, simd::madd(dy, dy, dz * dz)).storeu(po + i);
+        });
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::lerp(const vec3_soa<F>& start, const vec3_soa<F>& end, F t, vec3_soa<F>& out)
+    {
+        lerpUnclamped(start, end, math::clamp01(t), out);
+    }
+
+    template<std::floating_point F>
+    inline void vec3_soa<F>::lerpUnclamped(const vec3_soa<F>& start, const vec3_soa<F>& end, F t, vec3_soa<F>& out)
+    {
+        out.resize(start.size());
+
+        const F* sx = start.x.data(); const F* sy = start.y.data(); const F* sz = start.z.data();
+        const F* ex = end.x.data(); const F* ey = end.y.data(); const F* ez = end.z.data();
+        F* ox = out.x.data(); F* oy = out.y.data(); F* oz = out.z.data();
+
+        simd::forEachPack<F>(0, start.size(), [=](auto p, std::size_t i)
+        {
+            using P = decltype(p);
+
+            P vt = P::broadcast(t);
+            P vsx = P::loadu(sx + i); P vsy = P::loadu(sy + i); P vsz = P::loadu(sz + i);
+
+            simd::madd(P::loadu(ex + i) - vsx, vt, vsx).storeu(ox + i);
+            simd::madd(P::loadu(ey + i) - vsy, vt, vsy).storeu(oy + i);
+            simd::madd(P::loadu(ez + i) - vsz, vt, vsz).storeu(oz + i);
+        });
+    }
+
+    #pragma endregion StaticMethods
+
+    namespace detail
+    {
+        template<std::floating_point F, typename Kernel>
+        inline void forEachSoaBlock(const vec3<F>* in, vec3<F>* out, std::size_t begin, std::size_t end, Kernel&& kernel)
+        {
+            alignas(cacheLineSize) F x[soaBlockSize];
+            alignas(cacheLineSize) F y[soaBlockSize];
+            alignas(cacheLineSize) F z[soaBlockSize];
+
+            for (std::size_t first = begin; first < end; first += soaBlockSize)
+            {
+                std::size_t count = std::min(soaBlockSize, end - first);
+
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    x[i] = in[first + i].x;
+                    y[i] = in[first + i].y;
+                    z[i] = in[first + i].z;
+                }
+
+                kernel(first, count, x, y, z);
+
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    out[first + i].x = x[i];
+                    out[first + i].y = y[i];
+                    out[first + i].z = z[i];
+                }
+            }
+        }
+    }
+}
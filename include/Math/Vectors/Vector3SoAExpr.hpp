@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+#include "Math\Simd\Pack.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    struct vec3;
+
+    template<std::floating_point F>
+    struct vec3_soa;
+
+    // Opt-in expression templates for vec3_soa.
+    //
+    // math::lazy(vecs) wraps a vec3_soa into an expression, and +, -, unary -, * and / between
+    // expressions, vec3 and scalars only build a small tree of nodes, without computing anything.
+    // The tree is evaluated once it is assigned to a vec3_soa, in a single pass over the arrays :
+    //
+    //     out = lazy(a) + lazy(b) * s - lazy(c);
+    //
+    // reads a, b and c once and writes out once, where the eager kernels would have written
+    // two full temporary buffers. Every vec3_soa of an expression must have the same size, and
+    // out can be one of them, every lane being read before it is written.
+    namespace expr
+    {
+        // The x, y and z lanes produced by a node, for one pack of indices
+        template<typename P>
+        struct lanes3
+        {
+            P x, y, z;
+        };
+
+        // The base of every node, that the operators below are constrained on
+        template<std::floating_point F>
+        struct vec3_expression
+        {
+            using value_type = F;
+        };
+
+        template<typename E>
+        concept Vec3Expression = std::derived_from<std::remove_cvref_t<E>, vec3_expression<typename std::remove_cvref_t<E>::value_type>>;
+
+        template<Vec3Expression E>
+        using value_t = typename std::remove_cvref_t<E>::value_type;
+
+        #pragma region Leaves
+
+        // Reads the vectors of a vec3_soa. It only holds pointers, so the vec3_soa must outlive the expression
+        template<std::floating_point F>
+        struct soa_ref : vec3_expression<F>
+        {
+            const F* px;
+            const F* py;
+            const F* pz;
+            std::size_t count;
+
+            std::size_t size() const { return count; }
+
+            template<typename P>
+            lanes3<P> eval(std::size_t i) const
+            {
+                return { P::loadu(px + i), P::loadu(py + i), P::loadu(pz + i) };
+            }
+        };
+
+        // The same vec3 for every index, its size of 0 letting the other operand decide the size
+        template<std::floating_point F>
+        struct broadcast : vec3_expression<F>
+        {
+            F x, y, z;
+
+            std::size_t size() const { return 0; }
+
+            template<typename P>
+            lanes3<P> eval(std::size_t) const
+            {
+                return { P::broadcast(x), P::broadcast(y), P::broadcast(z) };
+            }
+        };
+
+        #pragma endregion Leaves
+
+        #pragma region Nodes
+
+        // The nodes are stored by value : they are only a few pointers and scalars large, and
+        // it keeps an expression valid once the temporaries of its full-expression are gone
+
+        template<Vec3Expression L, Vec3Expression R>
+        struct add : vec3_expression<value_t<L>>
+        {
+            L lhs;
+            R rhs;
+
+            std::size_t size() const { return std::max(lhs.size(), rhs.size()); }
+
+            template<typename P>
+            lanes3<P> eval(std::size_t i) const
+            {
+                lanes3<P> a = lhs.template eval<P>(i);
+                lanes3<P> b = rhs.template eval<P>(i);
+
+                return { a.x + b.x, a.y + b.y, a.z + b.z };
+            }
+        };
+
+        template<Vec3Expression L, Vec3Expression R>
+        struct sub : vec3_expression<value_t<L>>
+        {
+            L lhs;
+            R rhs;
+
+            std::size_t size() const { return std::max(lhs.size(), rhs.size()); }
+
+            template<typename P>
+            lanes3<P> eval(std::size_t i) const
+            {
+                lanes3<P> a = lhs.template eval<P>(i);
+                lanes3<P> b = rhs.template eval<P>(i);
+
+                return { a.x - b.x, a.y - b.y, a.z - b.z };
+            }
+        };
+
+        template<Vec3Expression E>
+        struct negate : vec3_expression<value_t<E>>
+        {
+            E operand;
+
+            std::size_t size() const { return operand.size(); }
+
+            template<typename P>
+            lanes3<P> eval(std::size_t i) const
+            {
+                lanes3<P> a = operand.template eval<P>(i);
+
+                return { -a.x, -a.y, -a.z };
+            }
+        };
+
+        // Multiplies every vector by the same scalar (division being a multiplication by its inverse)
+        template<Vec3Expression E>
+        struct scale : vec3_expression<value_t<E>>
+        {
+            E operand;
+            value_t<E> scalar;
+
+            std::size_t size() const { return operand.size(); }
+
+            template<typename P>
+            lanes3<P> eval(std::size_t i) const
+            {
+                lanes3<P> a = operand.template eval<P>(i);
+                P s = P::broadcast(scalar);
+
+                return { a.x * s, a.y * s, a.z * s };
+            }
+        };
+
+        #pragma endregion Nodes
+
+        #pragma region Operators
+
+        template<Vec3Expression L, Vec3Expression R>
+            requires std::same_as<value_t<L>, value_t<R>>
+        inline add<std::remove_cvref_t<L>, std::remove_cvref_t<R>> operator+(const L& lhs, const R& rhs)
+        {
+            return { {}, lhs, rhs };
+        }
+        template<Vec3Expression L>
+        inline add<std::remove_cvref_t<L>, broadcast<value_t<L>>> operator+(const L& lhs, const vec3<value_t<L>>& rhs)
+        {
+            return { {}, lhs, { {}, rhs.x, rhs.y, rhs.z } };
+        }
+        template<Vec3Expression R>
+        inline add<broadcast<value_t<R>>, std::remove_cvref_t<R>> operator+(const vec3<value_t<R>>& lhs, const R& rhs)
+        {
+            return { {}, { {}, lhs.x, lhs.y, lhs.z }, rhs };
+        }
+
+        template<Vec3Expression L, Vec3Expression R>
+            requires std::same_as<value_t<L>, value_t<R>>
+        inline sub<std::remove_cvref_t<L>, std::remove_cvref_t<R>> operator-(const L& lhs, const R& rhs)
+        {
+            return { {}, lhs, rhs };
+        }
+        template<Vec3Expression L>
+        inline sub<std::remove_cvref_t<L>, broadcast<value_t<L>>> operator-(const L& lhs, const vec3<value_t<L>>& rhs)
+        {
+            return { {}, lhs, { {}, rhs.x, rhs.y, rhs.z } };
+        }
+        template<Vec3Expression R>
+        inline sub<broadcast<value_t<R>>, std::remove_cvref_t<R>> operator-(const vec3<value_t<R>>& lhs, const R& rhs)
+        {
+            return { {}, { {}, lhs.x, lhs.y, lhs.z }, rhs };
+        }
+
+        template<Vec3Expression E>
+        inline negate<std::remove_cvref_t<E>> operator-(const E& operand)
+        {
+            return { {}, operand };
+        }
+
+        template<Vec3Expression E>
+        inline scale<std::remove_cvref_t<E>> operator*(const E& operand, value_t<E> scalar)
+        {
+            return { {}, operand, scalar };
+        }
+        template<Vec3Expression E>
+        inline scale<std::remove_cvref_t<E>> operator*(value_t<E> scalar, const E& operand)
+        {
+            return { {}, operand, scalar };
+        }
+        // Like vec3 / scalar, dividing by 0.0 leaves the vectors untouched
+        template<Vec3Expression E>
+        inline scale<std::remove_cvref_t<E>> operator/(const E& operand, value_t<E> scalar)
+        {
+            using F = value_t<E>;
+
+            return { {}, operand, scalar == static_cast<F>(0.0) ? static_cast<F>(1.0) : static_cast<F>(1.0) / scalar };
+        }
+
+        #pragma endregion Operators
+
+        // Evaluates the expression into out (resized to the size of the expression), in one pass
+        template<std::floating_point F, Vec3Expression E>
+            requires std::same_as<F, value_t<E>>
+        inline void evaluate(const E& expression, vec3_soa<F>& out)
+        {
+            std::size_t count = expression.size();
+            out.resize(count);
+
+            F* ox = out.x.data();
+            F* oy = out.y.data();
+            F* oz = out.z.data();
+
+            simd::forEachPack<F>(0, count, [&](auto p, std::size_t i)
+            {
+                using P = decltype(p);
+
+                lanes3<P> r = expression.template eval<P>(i);
+
+                r.x.storeu(ox + i);
+                r.y.storeu(oy + i);
+                r.z.storeu(oz + i);
+            });
+        }
+    }
+
+    // Returns an expression reading vecs, that starts a fused vec3_soa expression
+    template<std::floating_point F>
+    inline expr::soa_ref<F> lazy(const vec3_soa<F>& vecs)
+    {
+        return { {}, vecs.x.data(), vecs.y.data(), vecs.z.data(), vecs.size() };
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Math\Concepts.hpp"
+#include "Math\Precision.hpp"
+
+namespace math
+{
+    template<std::floating_point F>
+    struct vec3;
+
+    // A struct used to represent a Vector4, with x, y, z and w components.
+    // It is aligned on its own size, so that a vec4<float> can be loaded straight into an __m128
+    // and a vec4<double> into an __m256d, and an array of vec4 is a buffer of such registers.
+    // It is mostly meant to hold homogeneous coordinates, to be transformed by a mat4
+    template<std::floating_point F>
+    struct alignas(4 * sizeof(F)) vec4
+    {
+    public:
+        F x, y, z, w;
+
+    public:
+        // Constructor that returns a vec4 with x, y, z and w being 0.0
+        constexpr vec4();
+        // Constructor that returns a vec4 with x being vx, y being vy, z being vz and w being vw
+        constexpr vec4(F vx, F vy, F vz, F vw);
+        // Constructor that returns a vec4 with x being vec.x, y being vec.y, z being vec.z and w being vec.w
+        constexpr vec4(const vec4& vec) = default;
+
+        // Constructor that returns a vec4 with x being xyz.x, y being xyz.y, z being xyz.z and w being vw
+        // (1.0 for a point, 0.0 for a direction)
+        constexpr vec4(const vec3<F>& xyz, F vw);
+
+        static constexpr vec4 zero();
+        static constexpr vec4 one();
+
+
+        template<std::floating_point type = F>
+        constexpr vec3<type> XYZ() const;
+
+        // Returns (x / w, y / w, z / w), or (x, y, z) if w is 0.0
+        template<std::floating_point type = F>
+        constexpr vec3<type> perspectiveDivided() const;
+
+
+        constexpr const F* valuePtr() const;
+
+        template<Number N>
+        constexpr N length() const;
+        template<Number N>
+        constexpr N lengthSquared() const;
+
+        template<Number N>
+        constexpr N dotProduct(const vec4& other) const;
+
+        template<Number N>
+        static constexpr N dotProduct(const vec4& a, const vec4& b);
+
+
+        // Returns the same vector, but with its magnitude being 1, P being the precision of the inverse square root
+        template<Precision P = precise>
+        constexpr vec4& normalized();
+
+        template<std::floating_point type = F>
+        constexpr vec4<type> getUnitVector() const;
+
+        template<std::floating_point f>
+        static constexpr vec4 lerp(const vec4& start, const vec4& end, f t);
+        template<std::floating_point f>
+        static constexpr vec4 lerpUnclamped(const vec4& start, const vec4& end, f t);
+
+
+        constexpr vec4& operator=(const vec4& other) = default;
+
+        constexpr vec4& operator+=(const vec4& other);
+        constexpr vec4& operator-=(const vec4& other);
+        constexpr vec4& operator*=(F scalar);
+        constexpr vec4& operator/=(F scalar);
+    };
+
+    template<std::floating_point F>
+    constexpr vec4<F> operator+(const vec4<F>& a, const vec4<F>& b);
+    template<std::floating_point F>
+    constexpr vec4<F> operator-(const vec4<F>& a, const vec4<F>& b);
+    template<std::floating_point F>
+    constexpr vec4<F> operator*(const vec4<F>& vec, F scalar);
+    template<std::floating_point F>
+    constexpr vec4<F> operator*(F scalar, const vec4<F>& vec);
+    template<std::floating_point F>
+    constexpr vec4<F> operator/(const vec4<F>& vec, F scalar);
+
+    template<std::floating_point F>
+    constexpr bool operator==(const vec4<F>& a, const vec4<F>& b);
+    template<std::floating_point F>
+    constexpr bool operator!=(const vec4<F>& a, const vec4<F>& b);
+}
+
+#include "Math\Vectors\Vector4.inl"
@@ -0,0 +1,264 @@
+#include <concepts>
+
+#include "Math\MathInternal.hpp"
+
+namespace math
+{
+
+    #pragma region Constructors
+
+    template<std::floating_point F>
+    constexpr vec4<F>::vec4() : x(static_cast<F>(0.0)), y(static_cast<F>(0.0)), z(static_cast<F>(0.0)), w(static_cast<F>(0.0))
+    {
+    }
+
+    template<std::floating_point F>
+    constexpr vec4<F>::vec4(F vx, F vy, F vz, F vw) : x(vx), y(vy), z(vz), w(vw)
+    {
+    }
+
+    template<std::floating_point F>
+    constexpr vec4<F>::vec4(const vec3<F>& xyz, F vw) : x(xyz.x), y(xyz.y), z(xyz.z), w(vw)
+    {
+    }
+
+    #pragma endregion Constructors
+
+    #pragma region StaticConstructors
+
+    template<std::floating_point F>
+    constexpr vec4<F> vec4<F>::zero()
+    {
+        F f = static_cast<F>(0.0);
+        return vec4(f, f, f, f);
+    }
+    template<std::floating_point F>
+    constexpr vec4<F> vec4<F>::one()
+    {
+        F f = static_cast<F>(1.0);
+        return vec4(f, f, f, f);
+    }
+
+    #pragma endregion StaticConstructors
+
+    #pragma region Casting
+
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr vec3<f> vec4<F>::XYZ() const
+    {
+        return vec3<f>(static_cast<f>(x), static_cast<f>(y), static_cast<f>(z));
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr vec3<f> vec4<F>::perspectiveDivided() const
+    {
+        if (w == static_cast<F>(0.0)) return XYZ<f>();
+
+        F inverseW = static_cast<F>(1.0) / w;
+
+        return vec3<f>(static_cast<f>(x * inverseW), static_cast<f>(y * inverseW), static_cast<f>(z * inverseW));
+    }
+
+    #pragma endregion Casting
+
+    #pragma region Normalizing
+
+    template<std::floating_point F>
+    template<Precision P>
+    constexpr vec4<F>& vec4<F>::normalized()
+    {
+        F l = this->lengthSquared<F>();
+
+        if (l > static_cast<F>(0.0))
+        {
+            F inverseLength = P::rsqrt(l);
+
+            x *= inverseLength;
+            y *= inverseLength;
+            z *= inverseLength;
+            w *= inverseLength;
+        }
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr vec4<f> vec4<F>::getUnitVector() const
+    {
+        vec4 copy = *this;
+        copy.normalized();
+
+        return vec4<f>(static_cast<f>(copy.x),
+                       static_cast<f>(copy.y),
+                       static_cast<f>(copy.z),
+                       static_cast<f>(copy.w));
+    }
+
+    #pragma endregion Normalizing
+
+    #pragma region MemberMethods
+
+    template<std::floating_point F>
+    constexpr const F* vec4<F>::valuePtr() const
+    {
+        return &x;
+    }
+
+    template<std::floating_point F>
+    template<Number N>
+    constexpr N vec4<F>::length() const
+    {
+        return static_cast<N>(math::sqrt( (x * x) + (y * y) + (z * z) + (w * w) ));
+    }
+
+    template<std::floating_point F>
+    template<Number N>
+    constexpr N vec4<F>::lengthSquared() const
+    {
+        return static_cast<N>( (x * x) + (y * y) + (z * z) + (w * w) );
+    }
+
+    template<std::floating_point F>
+    template<Number N>
+    constexpr N vec4<F>::dotProduct(const vec4<F>& other) const
+    {
+        return static_cast<N>( (x * other.x) + (y * other.y) + (z * other.z) + (w * other.w) );
+    }
+
+    #pragma endregion MemberMethods
+
+    #pragma region StaticMethods
+
+    template<std::floating_point F>
+    template<Number N>
+    constexpr N vec4<F>::dotProduct(const vec4<F>& a, const vec4<F>& b)
+    {
+        return static_cast<N>( (a.x * b.x) + (a.y * b.y) + (a.z * b.z) + (a.w * b.w) );
+    }
+
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr vec4<F> vec4<F>::lerp(const vec4<F>& start, const vec4<F>& end, f t)
+    {
+        return lerpUnclamped(start, end, clamp01(t));
+    }
+    template<std::floating_point F>
+    template<std::floating_point f>
+    constexpr vec4<F> vec4<F>::lerpUnclamped(const vec4<F>& start, const vec4<F>& end, f t)
+    {
+        F ft = static_cast<F>(t);
+
+        return vec4(start.x + (end.x - start.x) * ft,
+                    start.y + (end.y - start.y) * ft,
+                    start.z + (end.z - start.z) * ft,
+                    start.w + (end.w - start.w) * ft);
+    }
+
+    #pragma endregion StaticMethods
+
+    #pragma region ReferenceOperators
+
+    template<std::floating_point F>
+    constexpr vec4<F>& vec4<F>::operator+=(const vec4<F>& other)
+    {
+        this->x += other.x;
+        this->y += other.y;
+        this->z += other.z;
+        this->w += other.w;
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr vec4<F>& vec4<F>::operator-=(const vec4<F>& other)
+    {
+        this->x -= other.x;
+        this->y -= other.y;
+        this->z -= other.z;
+        this->w -= other.w;
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr vec4<F>& vec4<F>::operator*=(F scalar)
+    {
+        this->x *= scalar;
+        this->y *= scalar;
+        this->z *= scalar;
+        this->w *= scalar;
+
+        return *this;
+    }
+
+    template<std::floating_point F>
+    constexpr vec4<F>& vec4<F>::operator/=(F scalar)
+    {
+        if (scalar != static_cast<F>(0.0))
+        {
+            scalar = static_cast<F>(1.0) / scalar;
+
+            this->x *= scalar;
+            this->y *= scalar;
+            this->z *= scalar;
+            this->w *= scalar;
+        }
+
+        return *this;
+    }
+
+    #pragma endregion ReferenceOperators
+
+    #pragma region ArithmeticOperators
+
+    template<std::floating_point F>
+    constexpr vec4<F> operator+(const vec4<F>& a, const vec4<F>& b)
+    {
+        return vec4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+    }
+    template<std::floating_point F>
+    constexpr vec4<F> operator-(const vec4<F>& a, const vec4<F>& b)
+    {
+        return vec4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+    }
+    template<std::floating_point F>
+    constexpr vec4<F> operator*(const vec4<F>& vec, F scalar)
+    {
+        return vec4(vec.x * scalar, vec.y * scalar, vec.z * scalar, vec.w * scalar);
+    }
+    template<std::floating_point F>
+    constexpr vec4<F> operator*(F scalar, const vec4<F>& vec)
+    {
+        return vec4(vec.x * scalar, vec.y * scalar, vec.z * scalar, vec.w * scalar);
+    }
+    template<std::floating_point F>
+    constexpr vec4<F> operator/(const vec4<F>& vec, F scalar)
+    {
+        if (scalar == static_cast<F>(0.0)) return vec;
+
+        scalar = static_cast<F>(1.0) / scalar;
+
+        return vec4(vec.x * scalar, vec.y * scalar, vec.z * scalar, vec.w * scalar);
+    }
+
+    template<std::floating_point F>
+    constexpr bool operator==(const vec4<F>& a, const vec4<F>& b)
+    {
+        return math::abs(a.x - b.x) < math::epsilon<F>() &&
+               math::abs(a.y - b.y) < math::epsilon<F>() &&
+               math::abs(a.z - b.z) < math::epsilon<F>() &&
+               math::abs(a.w - b.w) < math::epsilon<F>();
+    }
+
+    template<std::floating_point F>
+    constexpr bool operator!=(const vec4<F>& a, const vec4<F>& b)
+    {
+        return !(a == b);
+    }
+
+    #pragma endregion ArithmeticOperators
+
+}
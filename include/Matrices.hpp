@@ -3,6 +3,8 @@
 #include "Math\Matrices\Matrix4x4.hpp"
 #include "Math\Matrices\Matrix3x3.hpp"
 #include "Math\Matrices\Matrix2x2.hpp"
+#include "Math\Matrices\Matrix3x3AoSoA.hpp"
+#include "Math\Matrices\Matrix3x3Decomposition.hpp"
 
 
 using namespace math;
@@ -17,4 +19,8 @@ using mat3ld = math::mat3<long double>;
 
 using mat4f = math::mat4<float>;
 using mat4d = math::mat4<double>;
-using mat4ld = math::mat4<long double>;
\ No newline at end of file
+using mat4ld = math::mat4<long double>;
+
+using mat3f_aosoa = math::mat3_aosoa<float>;
+using mat3d_aosoa = math::mat3_aosoa<double>;
+using mat3ld_aosoa = math::mat3_aosoa<long double>;
\ No newline at end of file
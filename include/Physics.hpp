@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Math\Physics\RigidBodySoA.hpp"
+
+using namespace math;
+
+using rigid_bodyf_soa = math::rigid_body_soa<float>;
+using rigid_bodyd_soa = math::rigid_body_soa<double>;
+using rigid_bodyld_soa = math::rigid_body_soa<long double>;
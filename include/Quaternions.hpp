@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Math\Quaternions\Quaternion.hpp"
+#include "Math\Quaternions\DualQuaternion.hpp"
+#include "Math\Quaternions\QuaternionSoA.hpp"
 
 using namespace math;
 
@@ -8,3 +10,10 @@ using quatf = math::quat<float>;
 using quatd = math::quat<double>;
 using quatld = math::quat<long double>;
 
+using dualquatf = math::dualquat<float>;
+using dualquatd = math::dualquat<double>;
+using dualquatld = math::dualquat<long double>;
+
+using quatf_soa = math::quat_soa<float>;
+using quatd_soa = math::quat_soa<double>;
+using quatld_soa = math::quat_soa<long double>;
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Math\Transforms\TransformHierarchy.hpp"
+#include "Math\Transforms\TransformBatch.hpp"
+
+using namespace math;
+
+using transform_hierarchyf = math::transform_hierarchy<float>;
+using transform_hierarchyd = math::transform_hierarchy<double>;
+using transform_hierarchyld = math::transform_hierarchy<long double>;
@@ -2,13 +2,23 @@
 
 #include "Math\Vectors\Vector2.hpp"
 #include "Math\Vectors\Vector3.hpp"
+#include "Math\Vectors\Vector4.hpp"
+#include "Math\Vectors\Vector3SoA.hpp"
 
 using namespace math;
 
+using vec4f = math::vec4<float>;
+using vec4d = math::vec4<double>;
+using vec4ld = math::vec4<long double>;
+
 using vec3f = math::vec3<float>;
 using vec3d = math::vec3<double>;
 using vec3ld = math::vec3<long double>;
 
 using vec2f = math::vec2<float>;
 using vec2d = math::vec2<double>;
-using vec2ld = math::vec2<long double>;
\ No newline at end of file
+using vec2ld = math::vec2<long double>;
+
+using vec3f_soa = math::vec3_soa<float>;
+using vec3d_soa = math::vec3_soa<double>;
+using vec3ld_soa = math::vec3_soa<long double>;
@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+#include "Vectors.hpp"
+#include "Quaternions.hpp"
+#include "Animation.hpp"
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED : %s\n", what);
+            failures++;
+        }
+    }
+
+    // A clip of two tracks : the first one moves along x over keyCount keys, one per second, the second one
+    // starts at time 10.0 so that its first key directly follows the last key of the first track in memory
+    animation_clip<float> makeClip(std::size_t keyCount)
+    {
+        animation_clip<float> clip;
+
+        std::vector<float> times(keyCount);
+        std::vector<vec3<float>> translations(keyCount);
+
+        for (std::size_t k = 0; k < keyCount; k++)
+        {
+            times[k] = static_cast<float>(k);
+            translations[k] = vec3<float>(static_cast<float>(k), 0.0f, 0.0f);
+        }
+
+        float otherTimes[2] = { 10.0f, 11.0f };
+        vec3<float> otherTranslations[2] = { vec3<float>(100.0f, 0.0f, 0.0f), vec3<float>(200.0f, 0.0f, 0.0f) };
+
+        float constantTimes[1] = { 0.0f };
+        quat<float> rotations[1] = { quat<float>::identity() };
+        vec3<float> scales[1] = { vec3<float>::one() };
+
+        clip.addTrack(times, translations, constantTimes, rotations, constantTimes, scales);
+        clip.addTrack(otherTimes, otherTranslations, constantTimes, rotations, constantTimes, scales);
+
+        return clip;
+    }
+
+    // The cursors left by a clip must not point at or past the last key of a shorter clip sampled next
+    void samplerReusedAcrossClips()
+    {
+        animation_clip<float> longClip = makeClip(5);
+        animation_clip<float> shortClip = makeClip(4);
+
+        std::vector<vec3<float>> translations(2, vec3<float>::zero());
+        std::vector<quat<float>> rotations(2, quat<float>::identity());
+        std::vector<vec3<float>> scales(2, vec3<float>::one());
+
+        animation_sampler<float> sampler;
+
+        sampler.sample(longClip, 20.0f, translations, rotations, scales);
+        check(translations[0].x == 4.0f, "the long clip is clamped to its last key");
+
+        sampler.sample(shortClip, 5.0f, translations, rotations, scales);
+        check(translations[0].x == 3.0f, "the short clip is clamped to its last key after the long one");
+        check(translations[1].x == 100.0f, "the second track of the short clip is clamped to its first key");
+
+        sampler.sampleSlerp(longClip, 20.0f, translations, rotations, scales);
+        sampler.sampleSlerp(shortClip, 1.5f, translations, rotations, scales);
+        check(translations[0].x == 1.5f, "the short clip is interpolated after the long one");
+    }
+}
+
+int main()
+{
+    samplerReusedAcrossClips();
+
+    if (failures != 0) return EXIT_FAILURE;
+
+    std::printf("All animation_sampler tests passed\n");
+
+    return EXIT_SUCCESS;
+}